@@ -0,0 +1,48 @@
+// Tencent is pleased to support the open source community by making embedx
+// available.
+//
+// Copyright (C) 2021 THL A29 Limited, a Tencent company.  All rights reserved.
+//
+// Licensed under the BSD 3-Clause License and other third-party components,
+// please refer to LICENSE for details.
+//
+
+#pragma once
+#include <cstddef>  // std::size_t
+#include <vector>
+
+namespace embedx {
+
+// Read-only, non-owning view of a contiguous array.
+//
+// Storages return it from lookups so that callers do not depend on how the
+// values are laid out (one vector per key or one packed array for all keys).
+// An empty view means the key was not found.
+template <typename T>
+class ArrayView {
+ public:
+  using value_type = T;
+  using const_iterator = const T*;
+
+ private:
+  const T* data_ = nullptr;
+  size_t size_ = 0;
+
+ public:
+  ArrayView() = default;
+  ArrayView(const T* data, size_t size) noexcept : data_(data), size_(size) {}
+  ArrayView(const std::vector<T>& vec) noexcept  // NOLINT
+      : data_(vec.data()), size_(vec.size()) {}
+
+ public:
+  const T* data() const noexcept { return data_; }
+  size_t size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+  const T& operator[](size_t i) const noexcept { return data_[i]; }
+  const T& front() const noexcept { return data_[0]; }
+  const T& back() const noexcept { return data_[size_ - 1]; }
+  const T* begin() const noexcept { return data_; }
+  const T* end() const noexcept { return data_ + size_; }
+};
+
+}  // namespace embedx
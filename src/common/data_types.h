@@ -18,6 +18,9 @@
 #include <utility>  // std::pair
 #include <vector>
 
+#include "src/common/array_view.h"
+#include "src/common/flat_hash_map.h"
+
 namespace embedx {
 
 using int_t = ::deepx_core::DataType::int_t;
@@ -30,16 +33,17 @@ using vec_float_t = std::vector<float_t>;
 using vecl_t = std::vector<int>;
 using vec_str_t = std::vector<std::string>;
 using vec_pair_t = std::vector<pair_t>;
+using pair_view_t = ArrayView<pair_t>;
 using set_int_t = std::unordered_set<int_t>;
 
 using vec_set_t = std::vector<set_int_t>;
 using vec_map_neigh_t = std::vector<std::unordered_map<int_t, vec_int_t>>;
 
 using id_name_t = std::unordered_map<uint16_t, std::string>;
-using adj_list_t = std::unordered_map<int_t, vec_pair_t>;
+using adj_list_t = FlatHashMap<int_t, vec_pair_t>;
 using degree_list_t = std::unordered_map<int_t, std::pair<int_t, int_t>>;
 
-using index_map_t = std::unordered_map<int_t, int>;
+using index_map_t = FlatHashMap<int_t, int>;
 using vec_index_map_t = std::vector<std::unordered_map<int_t, int>>;
 using weight_map_t = std::unordered_map<int_t, float_t>;
 
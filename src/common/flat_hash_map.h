@@ -0,0 +1,294 @@
+// Tencent is pleased to support the open source community by making embedx
+// available.
+//
+// Copyright (C) 2021 THL A29 Limited, a Tencent company.  All rights reserved.
+//
+// Licensed under the BSD 3-Clause License and other third-party components,
+// please refer to LICENSE for details.
+//
+
+#pragma once
+#include <cstddef>    // std::size_t
+#include <cstdint>    // uint64_t
+#include <iterator>   // std::forward_iterator_tag
+#include <stdexcept>  // std::out_of_range
+#include <type_traits>
+#include <utility>  // std::pair
+#include <vector>
+
+namespace embedx {
+
+// Open addressing hash map for integer keys, e.g. node ids.
+//
+// Keys and values live in one array of slots and are found by linear probing
+// from a Fibonacci hash of the key, so a lookup usually touches a single
+// cache line instead of a bucket and a list node. The all ones key marks
+// empty slots, the entry with that key (if any) is kept in an extra slot at
+// the end of the array.
+//
+// It provides the subset of the std::unordered_map interface used in the
+// repo. Unlike std::unordered_map, inserting may move values and invalidate
+// iterators, pointers and references.
+template <typename K, typename V>
+class FlatHashMap {
+  static_assert(std::is_integral<K>::value, "K must be an integral type.");
+
+ public:
+  using key_type = K;
+  using mapped_type = V;
+  using value_type = std::pair<K, V>;
+
+ private:
+  static constexpr K EMPTY_KEY = (K)-1;
+  static constexpr size_t MIN_CAPACITY = 8;
+
+  // capacity + 1 slots, the last one is for EMPTY_KEY
+  std::vector<value_type> slots_;
+  size_t size_ = 0;
+  int shift_ = 64;
+  bool has_empty_key_ = false;
+
+ private:
+  template <typename Map, typename Value>
+  class Iterator {
+   private:
+    friend class FlatHashMap;
+    Map* map_ = nullptr;
+    size_t i_ = 0;
+
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = typename FlatHashMap::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Value*;
+    using reference = Value&;
+
+   public:
+    Iterator() = default;
+    Iterator(Map* map, size_t i) noexcept : map_(map), i_(i) {}
+    // iterator to const_iterator
+    template <typename OtherMap, typename OtherValue>
+    Iterator(const Iterator<OtherMap, OtherValue>& other) noexcept  // NOLINT
+        : map_(other.map_), i_(other.i_) {}
+
+   public:
+    reference operator*() const noexcept { return map_->slots_[i_]; }
+    pointer operator->() const noexcept { return &map_->slots_[i_]; }
+    Iterator& operator++() noexcept {
+      i_ = map_->NextOccupied(i_ + 1);
+      return *this;
+    }
+    Iterator operator++(int) noexcept {
+      Iterator it = *this;
+      ++*this;
+      return it;
+    }
+    bool operator==(const Iterator& other) const noexcept {
+      return i_ == other.i_;
+    }
+    bool operator!=(const Iterator& other) const noexcept {
+      return i_ != other.i_;
+    }
+
+    template <typename, typename>
+    friend class Iterator;
+  };
+
+ public:
+  using iterator = Iterator<FlatHashMap, value_type>;
+  using const_iterator = Iterator<const FlatHashMap, const value_type>;
+
+ public:
+  iterator begin() noexcept { return iterator(this, NextOccupied(0)); }
+  iterator end() noexcept { return iterator(this, slots_.size()); }
+  const_iterator begin() const noexcept {
+    return const_iterator(this, NextOccupied(0));
+  }
+  const_iterator end() const noexcept {
+    return const_iterator(this, slots_.size());
+  }
+
+  size_t size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+  // slots allocated, including the empty ones
+  size_t bucket_count() const noexcept { return slots_.size(); }
+
+ public:
+  void clear() noexcept {
+    for (auto& slot : slots_) {
+      slot = value_type(EMPTY_KEY, V());
+    }
+    size_ = 0;
+    has_empty_key_ = false;
+  }
+
+  void reserve(size_t size) {
+    size_t capacity = MIN_CAPACITY;
+    while (!Fits(size, capacity)) {
+      capacity *= 2;
+    }
+    if (capacity > Capacity()) {
+      Rehash(capacity);
+    }
+  }
+
+  iterator find(const K& key) noexcept {
+    return iterator(this, FindIndex(key));
+  }
+  const_iterator find(const K& key) const noexcept {
+    return const_iterator(this, FindIndex(key));
+  }
+  size_t count(const K& key) const noexcept {
+    return FindIndex(key) != slots_.size() ? 1 : 0;
+  }
+
+  V& at(const K& key) {
+    size_t i = FindIndex(key);
+    if (i == slots_.size()) {
+      throw std::out_of_range("FlatHashMap::at");
+    }
+    return slots_[i].second;
+  }
+  const V& at(const K& key) const {
+    size_t i = FindIndex(key);
+    if (i == slots_.size()) {
+      throw std::out_of_range("FlatHashMap::at");
+    }
+    return slots_[i].second;
+  }
+
+  V& operator[](const K& key) { return emplace(key).first->second; }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(const K& key, Args&&... args) {
+    if (!Fits(size_ + 1, Capacity())) {
+      Rehash(Capacity() == 0 ? MIN_CAPACITY : Capacity() * 2);
+    }
+
+    size_t i = key == EMPTY_KEY ? Capacity() : Home(key);
+    if (key == EMPTY_KEY) {
+      if (has_empty_key_) {
+        return std::make_pair(iterator(this, i), false);
+      }
+      has_empty_key_ = true;
+    } else {
+      for (; slots_[i].first != EMPTY_KEY; i = (i + 1) & Mask()) {
+        if (slots_[i].first == key) {
+          return std::make_pair(iterator(this, i), false);
+        }
+      }
+      slots_[i].first = key;
+    }
+
+    slots_[i].second = V(std::forward<Args>(args)...);
+    ++size_;
+    return std::make_pair(iterator(this, i), true);
+  }
+
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return emplace(value.first, value.second);
+  }
+
+  size_t erase(const K& key) {
+    size_t i = FindIndex(key);
+    if (i == slots_.size()) {
+      return 0;
+    }
+
+    --size_;
+    slots_[i].second = V();
+    if (key == EMPTY_KEY) {
+      has_empty_key_ = false;
+      return 1;
+    }
+
+    // Shift back the following entries of the cluster, so that probing
+    // never stops at the hole.
+    size_t hole = i;
+    for (size_t j = (i + 1) & Mask(); slots_[j].first != EMPTY_KEY;
+         j = (j + 1) & Mask()) {
+      size_t home = Home(slots_[j].first);
+      if (((j - home) & Mask()) >= ((j - hole) & Mask())) {
+        slots_[hole] = std::move(slots_[j]);
+        slots_[j].second = V();
+        hole = j;
+      }
+    }
+    slots_[hole].first = EMPTY_KEY;
+    return 1;
+  }
+
+ private:
+  size_t Capacity() const noexcept {
+    return slots_.empty() ? 0 : slots_.size() - 1;
+  }
+  size_t Mask() const noexcept { return Capacity() - 1; }
+  // max load factor 0.75
+  static bool Fits(size_t size, size_t capacity) noexcept {
+    return size * 4 <= capacity * 3;
+  }
+
+  size_t Home(K key) const noexcept {
+    return (size_t)(((uint64_t)key * 0x9E3779B97F4A7C15ULL) >> shift_);
+  }
+
+  size_t FindIndex(K key) const noexcept {
+    if (size_ == 0) {
+      return slots_.size();
+    }
+    if (key == EMPTY_KEY) {
+      return has_empty_key_ ? Capacity() : slots_.size();
+    }
+    for (size_t i = Home(key); slots_[i].first != EMPTY_KEY;
+         i = (i + 1) & Mask()) {
+      if (slots_[i].first == key) {
+        return i;
+      }
+    }
+    return slots_.size();
+  }
+
+  size_t NextOccupied(size_t i) const noexcept {
+    size_t capacity = Capacity();
+    for (; i < capacity; ++i) {
+      if (slots_[i].first != EMPTY_KEY) {
+        return i;
+      }
+    }
+    return i == capacity && has_empty_key_ ? capacity : slots_.size();
+  }
+
+  void Rehash(size_t capacity) {
+    std::vector<value_type> slots(capacity + 1);
+    for (auto& slot : slots) {
+      slot.first = EMPTY_KEY;
+    }
+    slots_.swap(slots);
+    shift_ = 64;
+    for (size_t c = capacity; c > 1; c >>= 1) {
+      --shift_;
+    }
+
+    if (slots.empty()) {
+      return;
+    }
+    for (size_t j = 0; j + 1 < slots.size(); ++j) {
+      if (slots[j].first != EMPTY_KEY) {
+        size_t i = Home(slots[j].first);
+        while (slots_[i].first != EMPTY_KEY) {
+          i = (i + 1) & Mask();
+        }
+        slots_[i] = std::move(slots[j]);
+      }
+    }
+    slots_.back() = std::move(slots.back());
+  }
+};
+
+template <typename K, typename V>
+constexpr K FlatHashMap<K, V>::EMPTY_KEY;
+
+template <typename K, typename V>
+constexpr size_t FlatHashMap<K, V>::MIN_CAPACITY;
+
+}  // namespace embedx
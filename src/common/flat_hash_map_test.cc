@@ -0,0 +1,102 @@
+// Tencent is pleased to support the open source community by making embedx
+// available.
+//
+// Copyright (C) 2021 THL A29 Limited, a Tencent company.  All rights reserved.
+//
+// Licensed under the BSD 3-Clause License and other third-party components,
+// please refer to LICENSE for details.
+//
+
+#include "src/common/flat_hash_map.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>  // std::unique_ptr
+#include <random>
+#include <stdexcept>  // std::out_of_range
+#include <unordered_map>
+#include <vector>
+
+namespace embedx {
+
+class FlatHashMapTest : public ::testing::Test {
+ protected:
+  using map_t = FlatHashMap<uint64_t, int>;
+  const uint64_t EMPTY_KEY = (uint64_t)-1;
+
+ protected:
+  static void ExpectSame(const map_t& map,
+                         const std::unordered_map<uint64_t, int>& expected) {
+    EXPECT_EQ(map.size(), expected.size());
+    size_t size = 0;
+    for (const auto& entry : map) {
+      auto it = expected.find(entry.first);
+      ASSERT_TRUE(it != expected.end());
+      EXPECT_EQ(entry.second, it->second);
+      ++size;
+    }
+    EXPECT_EQ(size, expected.size());
+  }
+};
+
+TEST_F(FlatHashMapTest, Basic) {
+  map_t map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_TRUE(map.begin() == map.end());
+  EXPECT_TRUE(map.find(0) == map.end());
+
+  EXPECT_TRUE(map.emplace(0, 1).second);
+  EXPECT_FALSE(map.emplace(0, 2).second);
+  EXPECT_TRUE(map.emplace(EMPTY_KEY, 3).second);
+  EXPECT_FALSE(map.emplace(EMPTY_KEY, 4).second);
+  map[5] += 5;
+
+  EXPECT_EQ(map.size(), 3u);
+  EXPECT_EQ(map.at(0), 1);
+  EXPECT_EQ(map.at(EMPTY_KEY), 3);
+  EXPECT_EQ(map.find(5)->second, 5);
+  EXPECT_EQ(map.count(6), 0u);
+  EXPECT_THROW(map.at(6), std::out_of_range);
+  ExpectSame(map, {{0, 1}, {EMPTY_KEY, 3}, {5, 5}});
+
+  EXPECT_EQ(map.erase(EMPTY_KEY), 1u);
+  EXPECT_EQ(map.erase(EMPTY_KEY), 0u);
+  ExpectSame(map, {{0, 1}, {5, 5}});
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_TRUE(map.find(0) == map.end());
+}
+
+TEST_F(FlatHashMapTest, Random) {
+  map_t map;
+  std::unordered_map<uint64_t, int> expected;
+  std::default_random_engine engine;
+  // small key range, so that inserts and erases hit the same clusters
+  std::uniform_int_distribution<uint64_t> key_dist(0, 2000);
+  for (int i = 0; i < 100000; ++i) {
+    uint64_t key = key_dist(engine);
+    if (i % 3 == 0) {
+      EXPECT_EQ(map.erase(key), expected.erase(key));
+    } else {
+      EXPECT_EQ(map.emplace(key, i).second, expected.emplace(key, i).second);
+    }
+  }
+  ExpectSame(map, expected);
+
+  map.reserve(100000);
+  ExpectSame(map, expected);
+}
+
+TEST_F(FlatHashMapTest, MoveOnly) {
+  FlatHashMap<uint64_t, std::unique_ptr<int>> map;
+  for (int i = 0; i < 100; ++i) {
+    map.emplace(i, new int(i));
+  }
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(*map.at(i), i);
+  }
+}
+
+}  // namespace embedx
@@ -0,0 +1,130 @@
+// Tencent is pleased to support the open source community by making embedx
+// available.
+//
+// Copyright (C) 2021 THL A29 Limited, a Tencent company.  All rights reserved.
+//
+// Licensed under the BSD 3-Clause License and other third-party components,
+// please refer to LICENSE for details.
+//
+
+#pragma once
+#include <cmath>  // std::sqrt
+#include <cstddef>
+#include <cstdint>
+#include <memory>   // std::shared_ptr
+#include <utility>  // std::move
+
+#include "src/common/flat_hash_map.h"
+#include "src/common/memory_usage.h"
+
+namespace embedx {
+
+// Map whose versions are copied on write, e.g. the lists changed by graph
+// deltas.
+//
+// Entries are kept in two layers, 'merged' shared by consecutive versions and
+// 'recent' copied with each of them. Compact moves recent into a new merged
+// layer once copying it costs more than merging. A version changing 'changed'
+// of 'size' entries then copies about sqrt(size * changed) entries instead of
+// size.
+template <typename K, typename V>
+class LayeredMap {
+ public:
+  using map_t = FlatHashMap<K, V>;
+
+ private:
+  static constexpr size_t RECENT_MIN_SIZE = 1024;
+
+ private:
+  std::shared_ptr<const map_t> merged_;
+  map_t recent_;
+  size_t size_ = 0;
+
+ public:
+  size_t size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+  const map_t* merged() const noexcept { return merged_.get(); }
+  const map_t& recent() const noexcept { return recent_; }
+
+  // nullptr if not found
+  const V* Find(const K& key) const noexcept {
+    auto it = recent_.find(key);
+    if (it != recent_.end()) {
+      return &it->second;
+    }
+    return FindMerged(key);
+  }
+
+  // The value of 'key' to change in this version, it starts as a copy of the
+  // merged one.
+  V& operator[](const K& key) {
+    auto result = recent_.emplace(key);
+    if (result.second) {
+      const V* merged = FindMerged(key);
+      if (merged) {
+        result.first->second = *merged;
+      } else {
+        ++size_;
+      }
+    }
+    return result.first->second;
+  }
+
+  // Called once 'changed' entries of a version were changed.
+  void Compact(size_t changed) {
+    size_t merged_size = merged_ ? merged_->size() : 0;
+    double limit = std::sqrt((double)merged_size * (double)changed);
+    if (recent_.size() < RECENT_MIN_SIZE || (double)recent_.size() < limit) {
+      return;
+    }
+
+    std::shared_ptr<map_t> merged(merged_ ? new map_t(*merged_) : new map_t);
+    merged->reserve(size_);
+    for (auto& entry : recent_) {
+      (*merged)[entry.first] = std::move(entry.second);
+    }
+    merged_ = std::move(merged);
+    recent_ = map_t();
+  }
+
+  // Calls func(key, value) for each entry.
+  template <typename Func>
+  void ForEach(Func&& func) const {
+    for (const auto& entry : recent_) {
+      func(entry.first, entry.second);
+    }
+    if (merged_) {
+      for (const auto& entry : *merged_) {
+        if (recent_.count(entry.first) == 0) {
+          func(entry.first, entry.second);
+        }
+      }
+    }
+  }
+
+ private:
+  const V* FindMerged(const K& key) const noexcept {
+    if (merged_) {
+      auto it = merged_->find(key);
+      if (it != merged_->end()) {
+        return &it->second;
+      }
+    }
+    return nullptr;
+  }
+};
+
+template <typename K, typename V>
+constexpr size_t LayeredMap<K, V>::RECENT_MIN_SIZE;
+
+// The merged layer is counted by each version sharing it.
+template <typename K, typename V>
+uint64_t MapBytes(const LayeredMap<K, V>& map) {
+  uint64_t bytes = MapBytes(map.recent());
+  if (map.merged()) {
+    bytes += MapBytes(*map.merged());
+  }
+  return bytes;
+}
+
+}  // namespace embedx
@@ -0,0 +1,82 @@
+// Tencent is pleased to support the open source community by making embedx
+// available.
+//
+// Copyright (C) 2021 THL A29 Limited, a Tencent company.  All rights reserved.
+//
+// Licensed under the BSD 3-Clause License and other third-party components,
+// please refer to LICENSE for details.
+//
+
+#include "src/common/layered_map.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <unordered_map>
+
+namespace embedx {
+
+class LayeredMapTest : public ::testing::Test {
+ protected:
+  using map_t = LayeredMap<uint64_t, int>;
+
+ protected:
+  static void ExpectSame(const map_t& map,
+                         const std::unordered_map<uint64_t, int>& expected) {
+    EXPECT_EQ(map.size(), expected.size());
+    size_t size = 0;
+    map.ForEach([&expected, &size](uint64_t key, int value) {
+      auto it = expected.find(key);
+      ASSERT_TRUE(it != expected.end());
+      EXPECT_EQ(value, it->second);
+      ++size;
+    });
+    EXPECT_EQ(size, expected.size());
+    for (const auto& entry : expected) {
+      const int* value = map.Find(entry.first);
+      ASSERT_TRUE(value != nullptr);
+      EXPECT_EQ(*value, entry.second);
+    }
+  }
+};
+
+TEST_F(LayeredMapTest, Basic) {
+  map_t map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_TRUE(map.Find(0) == nullptr);
+
+  map[0] = 1;
+  map[1] += 2;
+  map[1] += 2;
+  map.Compact(2);
+  EXPECT_TRUE(map.merged() == nullptr);
+  ExpectSame(map, {{0, 1}, {1, 4}});
+  EXPECT_TRUE(map.Find(2) == nullptr);
+}
+
+TEST_F(LayeredMapTest, Compact) {
+  std::unordered_map<uint64_t, int> expected;
+  map_t map;
+  for (int i = 0; i < 2000; ++i) {
+    map[i] = i;
+    expected[i] = i;
+  }
+  map.Compact(2000);
+  ASSERT_TRUE(map.merged() != nullptr);
+  EXPECT_TRUE(map.recent().empty());
+  ExpectSame(map, expected);
+
+  // Versions share the merged layer, changes start from the merged values.
+  map_t next = map;
+  next[5] += 10;
+  next[5000] = 1;
+  next.Compact(2);
+  EXPECT_EQ(next.merged(), map.merged());
+  EXPECT_EQ(next.recent().size(), 2u);
+  ExpectSame(map, expected);
+  expected[5] = 15;
+  expected[5000] = 1;
+  ExpectSame(next, expected);
+}
+
+}  // namespace embedx
@@ -0,0 +1,85 @@
+// Tencent is pleased to support the open source community by making embedx
+// available.
+//
+// Copyright (C) 2021 THL A29 Limited, a Tencent company.  All rights reserved.
+//
+// Licensed under the BSD 3-Clause License and other third-party components,
+// please refer to LICENSE for details.
+//
+
+#include "src/common/memory_usage.h"
+
+#include <cinttypes>  // PRIu64
+#include <cstdio>     // snprintf
+
+namespace embedx {
+namespace {
+
+constexpr double MB = 1024.0 * 1024.0;
+
+void AppendLine(const std::string& name, uint64_t bytes, uint64_t elements,
+                std::string* out) {
+  char buf[256];
+  int n = snprintf(buf, sizeof(buf), "%s: %" PRIu64 " bytes (%.1f MB)",
+                   name.c_str(), bytes, bytes / MB);
+  if (elements > 0 && n > 0 && (size_t)n < sizeof(buf)) {
+    snprintf(buf + n, sizeof(buf) - n,
+             ", %" PRIu64 " elements, %.1f bytes/element", elements,
+             (double)bytes / elements);
+  }
+  *out += buf;
+  *out += "\n";
+}
+
+}  // namespace
+
+void MemoryUsage::Add(const std::string& name, uint64_t bytes,
+                      uint64_t elements) {
+  for (auto& entry : entries_) {
+    if (entry.name == name) {
+      entry.bytes += bytes;
+      entry.elements += elements;
+      return;
+    }
+  }
+
+  Entry entry;
+  entry.name = name;
+  entry.bytes = bytes;
+  entry.elements = elements;
+  entries_.emplace_back(entry);
+}
+
+void MemoryUsage::Merge(const std::string& prefix, const MemoryUsage& other) {
+  for (const auto& entry : other.entries_) {
+    Add(prefix + "." + entry.name, entry.bytes, entry.elements);
+  }
+}
+
+const MemoryUsage::Entry* MemoryUsage::Find(const std::string& name) const {
+  for (const auto& entry : entries_) {
+    if (entry.name == name) {
+      return &entry;
+    }
+  }
+  return nullptr;
+}
+
+uint64_t MemoryUsage::TotalBytes() const noexcept {
+  uint64_t bytes = 0;
+  for (const auto& entry : entries_) {
+    bytes += entry.bytes;
+  }
+  return bytes;
+}
+
+std::string MemoryUsage::ToString() const {
+  std::string out;
+  for (const auto& entry : entries_) {
+    AppendLine(entry.name, entry.bytes, entry.elements, &out);
+  }
+  AppendLine("total", TotalBytes(), 0, &out);
+  return out;
+}
+
+}  // namespace embedx
@@ -0,0 +1,83 @@
+// Tencent is pleased to support the open source community by making embedx
+// available.
+//
+// Copyright (C) 2021 THL A29 Limited, a Tencent company.  All rights reserved.
+//
+// Licensed under the BSD 3-Clause License and other third-party components,
+// please refer to LICENSE for details.
+//
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "src/common/array_view.h"
+#include "src/common/flat_hash_map.h"
+
+namespace embedx {
+
+// Bytes held by the parts of a graph, e.g. "context.neighbors", for capacity
+// planning. Bytes are what the containers allocated, elements are what the
+// part counts (rows, neighbors, table entries, ...).
+class MemoryUsage {
+ public:
+  struct Entry {
+    std::string name;
+    uint64_t bytes = 0;
+    uint64_t elements = 0;
+  };
+
+ private:
+  std::vector<Entry> entries_;
+
+ public:
+  // Adds to the entry 'name' if it exists.
+  void Add(const std::string& name, uint64_t bytes, uint64_t elements);
+  // Adds the entries of 'other', named 'prefix.name'.
+  void Merge(const std::string& prefix, const MemoryUsage& other);
+  void Clear() noexcept { entries_.clear(); }
+
+ public:
+  const std::vector<Entry>& entries() const noexcept { return entries_; }
+  const Entry* Find(const std::string& name) const;
+  uint64_t TotalBytes() const noexcept;
+  // one line per entry, then the total
+  std::string ToString() const;
+};
+
+template <typename T>
+uint64_t VectorBytes(const std::vector<T>& vec) {
+  return vec.capacity() * sizeof(T);
+}
+
+template <typename T>
+uint64_t NestedVectorBytes(const std::vector<std::vector<T>>& vecs) {
+  uint64_t bytes = VectorBytes(vecs);
+  for (const auto& vec : vecs) {
+    bytes += VectorBytes(vec);
+  }
+  return bytes;
+}
+
+// Views read from a snapshot count the bytes they map.
+template <typename T>
+uint64_t ViewBytes(const ArrayView<T>& view) {
+  return view.size() * sizeof(T);
+}
+
+template <typename K, typename V>
+uint64_t MapBytes(const FlatHashMap<K, V>& map) {
+  return map.bucket_count() * sizeof(typename FlatHashMap<K, V>::value_type);
+}
+
+template <typename K, typename T>
+uint64_t NestedMapBytes(const FlatHashMap<K, std::vector<T>>& map) {
+  uint64_t bytes = MapBytes(map);
+  for (const auto& entry : map) {
+    bytes += VectorBytes(entry.second);
+  }
+  return bytes;
+}
+
+}  // namespace embedx
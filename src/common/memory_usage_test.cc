@@ -0,0 +1,63 @@
+// Tencent is pleased to support the open source community by making embedx
+// available.
+//
+// Copyright (C) 2021 THL A29 Limited, a Tencent company.  All rights reserved.
+//
+// Licensed under the BSD 3-Clause License and other third-party components,
+// please refer to LICENSE for details.
+//
+
+#include "src/common/memory_usage.h"
+
+#include <gtest/gtest.h>
+
+#include <utility>  // std::pair
+#include <vector>
+
+namespace embedx {
+
+class MemoryUsageTest : public ::testing::Test {
+ protected:
+  MemoryUsage usage_;
+};
+
+TEST_F(MemoryUsageTest, Add) {
+  usage_.Add("indexing", 100, 10);
+  usage_.Add("neighbors", 400, 20);
+  usage_.Add("indexing", 50, 5);
+
+  ASSERT_EQ(usage_.entries().size(), 2u);
+  EXPECT_EQ(usage_.Find("indexing")->bytes, 150u);
+  EXPECT_EQ(usage_.Find("indexing")->elements, 15u);
+  EXPECT_TRUE(usage_.Find("in_degree") == nullptr);
+  EXPECT_EQ(usage_.TotalBytes(), 550u);
+
+  MemoryUsage graph_usage;
+  graph_usage.Merge("context", usage_);
+  graph_usage.Merge("node_feature", usage_);
+  EXPECT_EQ(graph_usage.entries().size(), 4u);
+  EXPECT_EQ(graph_usage.Find("context.neighbors")->bytes, 400u);
+  EXPECT_EQ(graph_usage.TotalBytes(), 1100u);
+
+  EXPECT_EQ(usage_.ToString(),
+            "indexing: 150 bytes (0.0 MB), 15 elements, 10.0 bytes/element\n"
+            "neighbors: 400 bytes (0.0 MB), 20 elements, 20.0 bytes/element\n"
+            "total: 550 bytes (0.0 MB)\n");
+}
+
+TEST_F(MemoryUsageTest, Bytes) {
+  std::vector<std::vector<int>> vecs(2);
+  vecs[0].reserve(4);
+  vecs[1].reserve(8);
+  EXPECT_EQ(VectorBytes(vecs[0]), 4 * sizeof(int));
+  EXPECT_EQ(NestedVectorBytes(vecs),
+            2 * sizeof(std::vector<int>) + 12 * sizeof(int));
+
+  FlatHashMap<int64_t, int> map;
+  EXPECT_EQ(MapBytes(map), 0u);
+  map[1] = 1;
+  EXPECT_EQ(MapBytes(map),
+            map.bucket_count() * sizeof(std::pair<int64_t, int>));
+}
+
+}  // namespace embedx
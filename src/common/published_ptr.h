@@ -0,0 +1,102 @@
+// Tencent is pleased to support the open source community by making embedx
+// available.
+//
+// Copyright (C) 2021 THL A29 Limited, a Tencent company.  All rights reserved.
+//
+// Licensed under the BSD 3-Clause License and other third-party components,
+// please refer to LICENSE for details.
+//
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory>   // std::shared_ptr
+#include <utility>  // std::move, std::pair
+#include <vector>
+
+namespace embedx {
+
+template <typename T>
+class PublishedPtr;
+
+// Data of PublishedPtrs kept alive for the reads of the calling thread, e.g.
+// for one request. PublishedPtr::get on this thread returns the pinned data
+// until the pins are destroyed, which must happen on the same thread and in
+// the reverse order of creation.
+class PublishedPins {
+ private:
+  using pin_t = std::pair<const void*, std::shared_ptr<const void>>;
+  size_t size_ = 0;
+
+ public:
+  PublishedPins() = default;
+  PublishedPins(const PublishedPins&) = delete;
+  PublishedPins& operator=(const PublishedPins&) = delete;
+  ~PublishedPins() {
+    auto& pins = ThreadPins();
+    pins.resize(pins.size() - size_);
+  }
+
+ public:
+  template <typename T>
+  void Add(const PublishedPtr<T>& ptr) {
+    ThreadPins().emplace_back(&ptr, ptr.load());
+    ++size_;
+  }
+
+  // Finds the data the calling thread pinned for 'owner'.
+  static bool Find(const void* owner, const void** data) noexcept {
+    const auto& pins = ThreadPins();
+    for (auto it = pins.rbegin(); it != pins.rend(); ++it) {
+      if (it->first == owner) {
+        *data = it->second.get();
+        return true;
+      }
+    }
+    return false;
+  }
+
+ private:
+  static std::vector<pin_t>& ThreadPins() {
+    static thread_local std::vector<pin_t> pins;
+    return pins;
+  }
+};
+
+// Pointer to immutable data, replaced by one writer while many readers use
+// it without locks.
+//
+// Replaced data is freed as soon as no PublishedPins hold it. Readers running
+// beside Publish pin the data first, so that it stays valid for the whole
+// request. Unpinned readers get data that the next Publish may free. Publish
+// must not be called concurrently.
+template <typename T>
+class PublishedPtr {
+ private:
+  // use std::atomic_load and std::atomic_store
+  std::shared_ptr<const T> ptr_;
+  // ptr_.get(), for unpinned readers
+  std::atomic<const T*> raw_{nullptr};
+
+ public:
+  // nullptr before the first Publish
+  const T* get() const noexcept {
+    const void* data = nullptr;
+    if (PublishedPins::Find(this, &data)) {
+      return static_cast<const T*>(data);
+    }
+    return raw_.load(std::memory_order_acquire);
+  }
+
+  // the current data, ignoring pins
+  std::shared_ptr<const T> load() const noexcept {
+    return std::atomic_load(&ptr_);
+  }
+
+  void Publish(std::shared_ptr<const T> data) {
+    raw_.store(data.get(), std::memory_order_release);
+    std::atomic_store(&ptr_, std::move(data));
+  }
+};
+
+}  // namespace embedx
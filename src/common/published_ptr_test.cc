@@ -0,0 +1,75 @@
+// Tencent is pleased to support the open source community by making embedx
+// available.
+//
+// Copyright (C) 2021 THL A29 Limited, a Tencent company.  All rights reserved.
+//
+// Licensed under the BSD 3-Clause License and other third-party components,
+// please refer to LICENSE for details.
+//
+
+#include "src/common/published_ptr.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>  // std::shared_ptr
+#include <thread>
+
+namespace embedx {
+
+class PublishedPtrTest : public ::testing::Test {
+ protected:
+  struct Counted {
+    int* alive;
+    explicit Counted(int* alive) : alive(alive) { ++*alive; }
+    ~Counted() { --*alive; }
+  };
+
+  static std::shared_ptr<const Counted> NewCounted(int* alive) {
+    return std::make_shared<const Counted>(alive);
+  }
+};
+
+TEST_F(PublishedPtrTest, Publish) {
+  int alive = 0;
+  PublishedPtr<Counted> ptr;
+  EXPECT_TRUE(ptr.get() == nullptr);
+  EXPECT_TRUE(ptr.load() == nullptr);
+
+  ptr.Publish(NewCounted(&alive));
+  const Counted* first = ptr.get();
+  EXPECT_EQ(alive, 1);
+  EXPECT_EQ(ptr.load().get(), first);
+
+  // Unpinned data is freed once replaced.
+  ptr.Publish(NewCounted(&alive));
+  EXPECT_TRUE(ptr.get() != first);
+  EXPECT_EQ(alive, 1);
+}
+
+TEST_F(PublishedPtrTest, Pin) {
+  int alive = 0;
+  PublishedPtr<Counted> ptr;
+  ptr.Publish(NewCounted(&alive));
+  const Counted* first = ptr.get();
+
+  {
+    PublishedPins pins;
+    pins.Add(ptr);
+    ptr.Publish(NewCounted(&alive));
+    ptr.Publish(NewCounted(&alive));
+    EXPECT_EQ(alive, 2);
+    EXPECT_EQ(ptr.get(), first);
+    EXPECT_EQ(first->alive, &alive);
+    EXPECT_TRUE(ptr.load().get() != first);
+
+    // Other threads see the current data.
+    const Counted* other = nullptr;
+    std::thread thread([&ptr, &other]() { other = ptr.get(); });
+    thread.join();
+    EXPECT_EQ(other, ptr.load().get());
+  }
+  EXPECT_EQ(alive, 1);
+  EXPECT_EQ(ptr.get(), ptr.load().get());
+}
+
+}  // namespace embedx
@@ -11,19 +11,159 @@
 
 #include "src/common/random.h"
 
+#include <atomic>
 #include <chrono>
-#include <random>  // std::uniform_real_distribution
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define EMBEDX_RANDOM_AVX2 1
+#endif
 
 namespace embedx {
 namespace {
 
-static thread_local std::default_random_engine e(
-    std::chrono::system_clock::now().time_since_epoch().count());
+uint64_t SplitMix64(uint64_t* x) noexcept {
+  uint64_t z = (*x += 0x9e3779b97f4a7c15ULL);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+uint64_t NextThreadSeed() {
+  // The clock alone gives threads started together the same seed.
+  static std::atomic<uint64_t> thread_count{0};
+  uint64_t seed =
+      (uint64_t)std::chrono::system_clock::now().time_since_epoch().count();
+  return seed ^ (++thread_count * 0xd1b54a32d192ed03ULL);
+}
+
+#if defined(EMBEDX_RANDOM_AVX2)
+// Four engines interleaved for avx2, s[i][j] is word i of engine j.
+struct alignas(32) LaneStates {
+  uint64_t s[4][4];
+  bool seeded;
+};
+
+thread_local LaneStates lane_states;
+// number of seeded RandomSeedScope of the calling thread
+thread_local int seeded_scopes = 0;
+
+bool HasAvx2() {
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2");
+}
+
+// Returns the number of values filled, a multiple of 8.
+__attribute__((target("avx2"))) size_t FillUniformAvx2(LaneStates* lanes,
+                                                       float* values,
+                                                       size_t n) {
+  auto* s = reinterpret_cast<__m256i*>(lanes->s);
+  __m256i s0 = _mm256_load_si256(s);
+  __m256i s1 = _mm256_load_si256(s + 1);
+  __m256i s2 = _mm256_load_si256(s + 2);
+  __m256i s3 = _mm256_load_si256(s + 3);
+  const __m256 scale = _mm256_set1_ps(1.0f / 16777216.0f);
+
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    // rotl(s1 * 5, 7) * 9, avx2 has no 64-bit multiply
+    __m256i x = _mm256_add_epi64(s1, _mm256_slli_epi64(s1, 2));
+    x = _mm256_or_si256(_mm256_slli_epi64(x, 7), _mm256_srli_epi64(x, 57));
+    x = _mm256_add_epi64(x, _mm256_slli_epi64(x, 3));
+    // the high 24 bits of each 32-bit half
+    __m256 f = _mm256_cvtepi32_ps(_mm256_srli_epi32(x, 8));
+    _mm256_storeu_ps(values + i, _mm256_mul_ps(f, scale));
 
-static thread_local std::uniform_real_distribution<double> u(0, 1);
+    __m256i t = _mm256_slli_epi64(s1, 17);
+    s2 = _mm256_xor_si256(s2, s0);
+    s3 = _mm256_xor_si256(s3, s1);
+    s1 = _mm256_xor_si256(s1, s2);
+    s0 = _mm256_xor_si256(s0, s3);
+    s2 = _mm256_xor_si256(s2, t);
+    s3 = _mm256_or_si256(_mm256_slli_epi64(s3, 45), _mm256_srli_epi64(s3, 19));
+  }
+
+  _mm256_store_si256(s, s0);
+  _mm256_store_si256(s + 1, s1);
+  _mm256_store_si256(s + 2, s2);
+  _mm256_store_si256(s + 3, s3);
+  return i;
+}
+#endif
 
 }  // namespace
 
-double ThreadLocalRandom() { return u(e); }
+Xoshiro256::Xoshiro256(uint64_t seed) noexcept {
+  for (auto& word : s_) {
+    word = SplitMix64(&seed);
+  }
+}
+
+uint64_t Philox4x32(uint64_t key, uint64_t hi, uint64_t lo) noexcept {
+  uint32_t c[4] = {(uint32_t)lo, (uint32_t)(lo >> 32), (uint32_t)hi,
+                   (uint32_t)(hi >> 32)};
+  uint32_t k[2] = {(uint32_t)key, (uint32_t)(key >> 32)};
+  for (int round = 0; round < 10; ++round) {
+    uint64_t p0 = (uint64_t)0xd2511f53u * c[0];
+    uint64_t p1 = (uint64_t)0xcd9e8d57u * c[2];
+    uint32_t next[4] = {(uint32_t)(p1 >> 32) ^ c[1] ^ k[0], (uint32_t)p1,
+                        (uint32_t)(p0 >> 32) ^ c[3] ^ k[1], (uint32_t)p0};
+    for (int i = 0; i < 4; ++i) {
+      c[i] = next[i];
+    }
+    k[0] += 0x9e3779b9u;
+    k[1] += 0xbb67ae85u;
+  }
+  return (uint64_t)c[1] << 32 | c[0];
+}
+
+RandomSeedScope::RandomSeedScope(uint64_t seed)
+    : saved_(ThreadLocalRandomEngine()) {
+  if (seed != 0) {
+    engine_ = &ThreadLocalRandomEngine();
+    *engine_ = Xoshiro256(seed);
+#if defined(EMBEDX_RANDOM_AVX2)
+    ++seeded_scopes;
+#endif
+  }
+}
+
+RandomSeedScope::~RandomSeedScope() {
+  if (engine_) {
+    *engine_ = saved_;
+#if defined(EMBEDX_RANDOM_AVX2)
+    --seeded_scopes;
+#endif
+  }
+}
+
+Xoshiro256& ThreadLocalRandomEngine() {
+  static thread_local Xoshiro256 engine(NextThreadSeed());
+  return engine;
+}
+
+void FillUniform(float* values, size_t n) {
+  auto& engine = ThreadLocalRandomEngine();
+  size_t i = 0;
+#if defined(EMBEDX_RANDOM_AVX2)
+  static const bool has_avx2 = HasAvx2();
+  // The lanes aren't reseeded, seeded values come from the engine alone.
+  if (has_avx2 && n >= 8 && seeded_scopes == 0) {
+    if (!lane_states.seeded) {
+      for (int j = 0; j < 4; ++j) {
+        uint64_t seed = engine.Next();
+        for (int k = 0; k < 4; ++k) {
+          lane_states.s[k][j] = SplitMix64(&seed);
+        }
+      }
+      lane_states.seeded = true;
+    }
+    i = FillUniformAvx2(&lane_states, values, n);
+  }
+#endif
+  for (; i < n; ++i) {
+    values[i] = engine.NextFloat();
+  }
+}
 
 }  // namespace embedx
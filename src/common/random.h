@@ -10,9 +10,129 @@
 //
 
 #pragma once
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>  // std::swap
 
 namespace embedx {
 
-double ThreadLocalRandom();
+// xoshiro256**, see https://prng.di.unimi.it.
+//
+// Much faster than the std engines, good for sampling but not for
+// cryptography.
+class Xoshiro256 {
+ private:
+  uint64_t s_[4];
+
+ public:
+  explicit Xoshiro256(uint64_t seed) noexcept;
+
+ public:
+  uint64_t Next() noexcept {
+    uint64_t result = Rotl(s_[1] * 5, 7) * 9;
+    uint64_t t = s_[1] << 17;
+    s_[2] ^= s_[0];
+    s_[3] ^= s_[1];
+    s_[1] ^= s_[2];
+    s_[0] ^= s_[3];
+    s_[2] ^= t;
+    s_[3] = Rotl(s_[3], 45);
+    return result;
+  }
+
+  // [0, 1)
+  double NextDouble() noexcept {
+    return (Next() >> 11) * (1.0 / 9007199254740992.0);  // 2^53
+  }
+  float NextFloat() noexcept {
+    return (Next() >> 40) * (1.0f / 16777216.0f);  // 2^24
+  }
+  // [0, n) by multiply-shift, without the division of a modulo and the
+  // rounding of a float multiply.
+  uint32_t NextRange(uint32_t n) noexcept {
+    return (uint32_t)(((Next() >> 32) * n) >> 32);
+  }
+
+ private:
+  static uint64_t Rotl(uint64_t x, int k) noexcept {
+    return (x << k) | (x >> (64 - k));
+  }
+};
+
+// Engine of the calling thread, seeded differently for each thread.
+Xoshiro256& ThreadLocalRandomEngine();
+
+// [0, 1)
+inline double ThreadLocalRandom() {
+  return ThreadLocalRandomEngine().NextDouble();
+}
+
+// [0, n)
+inline uint32_t ThreadLocalRandomRange(uint32_t n) {
+  return ThreadLocalRandomEngine().NextRange(n);
+}
+
+// Shuffles [first, last) with the engine of the calling thread.
+template <typename RandomIt>
+void ThreadLocalShuffle(RandomIt first, RandomIt last) {
+  auto& engine = ThreadLocalRandomEngine();
+  for (auto n = last - first; n > 1; --n) {
+    std::swap(first[n - 1], first[engine.NextRange((uint32_t)n)]);
+  }
+}
+
+// Philox4x32-10 of the 128-bit counter (hi, lo) under 'key', see "Parallel
+// Random Numbers: As Easy as 1, 2, 3" (Salmon et al.), returns 64 bits of the
+// output block.
+//
+// Stateless, so a stream seed can be derived from any tuple of keys.
+uint64_t Philox4x32(uint64_t key, uint64_t hi, uint64_t lo) noexcept;
+
+// Reseeds the engine of the calling thread with 'seed' and restores its state
+// on destruction. A seed of 0 leaves the engine alone.
+//
+// FillUniform reads the engine only while a seed is in scope, see
+// FillUniform.
+class RandomSeedScope {
+ private:
+  Xoshiro256* engine_ = nullptr;
+  Xoshiro256 saved_;
+
+ public:
+  explicit RandomSeedScope(uint64_t seed);
+  ~RandomSeedScope();
+  RandomSeedScope(const RandomSeedScope&) = delete;
+  RandomSeedScope& operator=(const RandomSeedScope&) = delete;
+};
+
+// Seeds of the random streams of the nodes of a sampling call keyed by 'key'.
+//
+// The k-th occurrence of a node gets the same seed however the nodes are split,
+// e.g. by shard or thread, as long as the order of its occurrences is kept.
+// A key of 0 gives seeds of 0.
+class RandomStreamSeeder {
+ private:
+  uint64_t key_;
+  std::unordered_map<uint64_t, uint64_t> occurrences_;
+
+ public:
+  explicit RandomStreamSeeder(uint64_t key) noexcept : key_(key) {}
+
+ public:
+  uint64_t Next(uint64_t node) {
+    if (key_ == 0) {
+      return 0;
+    }
+    return Philox4x32(key_, node, occurrences_[node]++) | 1;
+  }
+};
+
+// Fills 'values' with 'n' floats in [0, 1), eight at a time with avx2 if the
+// cpu supports it.
+//
+// Under a RandomSeedScope, the values are the next 'n' NextFloat of the
+// engine instead, so that they are the same on any cpu and for any 'n'.
+void FillUniform(float* values, size_t n);
 
 }  // namespace embedx
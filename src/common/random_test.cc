@@ -0,0 +1,158 @@
+// Tencent is pleased to support the open source community by making embedx
+// available.
+//
+// Copyright (C) 2021 THL A29 Limited, a Tencent company.  All rights reserved.
+//
+// Licensed under the BSD 3-Clause License and other third-party components,
+// please refer to LICENSE for details.
+//
+
+#include "src/common/random.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>  // std::equal, std::sort
+#include <cstdint>
+#include <vector>
+
+namespace embedx {
+
+class RandomTest : public ::testing::Test {
+ protected:
+  const int COUNT = 100000;
+};
+
+TEST_F(RandomTest, Xoshiro256) {
+  Xoshiro256 engine(7);
+  Xoshiro256 same_engine(7);
+  Xoshiro256 other_engine(8);
+  int same_num = 0;
+  for (int i = 0; i < 100; ++i) {
+    auto value = engine.Next();
+    EXPECT_EQ(value, same_engine.Next());
+    same_num += value == other_engine.Next();
+  }
+  EXPECT_EQ(same_num, 0);
+}
+
+TEST_F(RandomTest, Philox4x32) {
+  // known answers of Random123
+  EXPECT_EQ(Philox4x32(0, 0, 0), 0xe169c58d6627e8d5ULL);
+  EXPECT_EQ(Philox4x32(~0ULL, ~0ULL, ~0ULL), 0x41c83b0e408f276dULL);
+}
+
+TEST_F(RandomTest, RandomSeedScope) {
+  Xoshiro256 engine = ThreadLocalRandomEngine();
+  std::vector<uint64_t> values;
+  {
+    RandomSeedScope scope(7);
+    for (int i = 0; i < 10; ++i) {
+      values.emplace_back(ThreadLocalRandomEngine().Next());
+    }
+  }
+  {
+    RandomSeedScope scope(7);
+    for (auto value : values) {
+      EXPECT_EQ(ThreadLocalRandomEngine().Next(), value);
+    }
+  }
+
+  // restored
+  EXPECT_EQ(ThreadLocalRandomEngine().Next(), engine.Next());
+  {
+    RandomSeedScope scope(0);
+    EXPECT_EQ(ThreadLocalRandomEngine().Next(), engine.Next());
+  }
+}
+
+TEST_F(RandomTest, RandomStreamSeeder) {
+  RandomStreamSeeder seeder(7);
+  uint64_t seed = seeder.Next(1);
+  EXPECT_NE(seeder.Next(2), seed);
+  // the second occurrence
+  EXPECT_NE(seeder.Next(1), seed);
+
+  // the occurrences of a node are counted apart from the others
+  RandomStreamSeeder other_seeder(7);
+  EXPECT_EQ(other_seeder.Next(1), seed);
+
+  RandomStreamSeeder unseeded(0);
+  EXPECT_EQ(unseeded.Next(1), 0u);
+}
+
+TEST_F(RandomTest, Range) {
+  std::vector<int> counts(10, 0);
+  for (int i = 0; i < COUNT; ++i) {
+    double value = ThreadLocalRandom();
+    EXPECT_TRUE(value >= 0 && value < 1);
+
+    uint32_t k = ThreadLocalRandomRange(10);
+    ASSERT_LT(k, 10u);
+    ++counts[k];
+  }
+  for (auto count : counts) {
+    EXPECT_NEAR(count / (double)COUNT, 0.1, 0.01);
+  }
+}
+
+TEST_F(RandomTest, FillUniform) {
+  // not a multiple of the vector width
+  std::vector<float> values(COUNT + 5, -1);
+  FillUniform(values.data(), values.size());
+
+  double sum = 0;
+  for (auto value : values) {
+    EXPECT_TRUE(value >= 0 && value < 1);
+    sum += value;
+  }
+  EXPECT_NEAR(sum / values.size(), 0.5, 0.01);
+
+  // consecutive calls continue the streams
+  std::vector<float> next_values(values.size());
+  FillUniform(next_values.data(), next_values.size());
+  EXPECT_NE(values, next_values);
+}
+
+TEST_F(RandomTest, FillUniform_Seeded) {
+  // the scalar values of the seed, whatever the cpu and the count
+  Xoshiro256 engine(7);
+  std::vector<float> expected(100);
+  for (auto& value : expected) {
+    value = engine.NextFloat();
+  }
+
+  for (size_t n : {100, 5}) {
+    std::vector<float> values(n);
+    {
+      RandomSeedScope scope(7);
+      FillUniform(values.data(), values.size());
+    }
+    EXPECT_TRUE(std::equal(values.begin(), values.end(), expected.begin()));
+  }
+
+  // unseeded calls use the vector path again
+  std::vector<float> values(100);
+  FillUniform(values.data(), values.size());
+  EXPECT_NE(values, expected);
+}
+
+TEST_F(RandomTest, ThreadLocalShuffle) {
+  std::vector<int> values[2];
+  for (auto& shuffled : values) {
+    for (int i = 0; i < 100; ++i) {
+      shuffled.emplace_back(i);
+    }
+    RandomSeedScope scope(7);
+    ThreadLocalShuffle(shuffled.begin(), shuffled.end());
+  }
+  EXPECT_EQ(values[0], values[1]);
+
+  std::vector<int> sorted = values[0];
+  std::sort(sorted.begin(), sorted.end());
+  EXPECT_NE(sorted, values[0]);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(sorted[i], i);
+  }
+}
+
+}  // namespace embedx
@@ -22,12 +22,12 @@ bool ItemFeature::LookupFeature(const vec_int_t& items,
                                 std::vector<vec_pair_t>* item_feats) const {
   item_feats->clear();
   for (auto item : items) {
-    const auto* feat = deep_data_.FindItemFeature(item);
-    if (feat == nullptr) {
+    auto feat = deep_data_.FindItemFeature(item);
+    if (feat.empty()) {
       DXERROR("Couldn't find item: %." PRIu64, item);
       return false;
     } else {
-      item_feats->emplace_back(*feat);
+      item_feats->emplace_back(feat.begin(), feat.end());
     }
   }
 
@@ -22,10 +22,12 @@ bool InstanceSampler::Run(int count, vec_int_t* insts,
   vec_labels_list->clear();
 
   // do random sampling
+  auto all_insts = deep_data_->insts();
   while ((int)insts->size() < count) {
-    auto k = int(ThreadLocalRandom() * insts_->size());
-    insts->emplace_back((*insts_)[k]);
-    vec_labels_list->emplace_back((*vec_labels_list_)[k]);
+    auto k = size_t(ThreadLocalRandom() * all_insts.size());
+    insts->emplace_back(all_insts[k]);
+    auto labels = deep_data_->labels(k);
+    vec_labels_list->emplace_back(labels.begin(), labels.end());
   }
 
   return (int)insts->size() == count && (int)vec_labels_list->size() == count;
@@ -21,8 +21,7 @@ namespace deep_op {
 
 class InstanceSampler : public LocalDeepOp {
  private:
-  const vec_int_t* insts_ = nullptr;
-  const std::vector<vecl_t>* vec_labels_list_ = nullptr;
+  const DeepData* deep_data_ = nullptr;
 
  public:
   ~InstanceSampler() override = default;
@@ -33,9 +32,8 @@ class InstanceSampler : public LocalDeepOp {
 
  private:
   bool Init(const LocalDeepOpResource* resource) override {
-    insts_ = &resource->deep_data()->insts();
-    vec_labels_list_ = &resource->deep_data()->vec_labels_list();
-    return insts_ != nullptr && vec_labels_list_ != nullptr;
+    deep_data_ = resource->deep_data();
+    return deep_data_ != nullptr;
   }
 };
 
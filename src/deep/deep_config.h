@@ -19,6 +19,8 @@ class DeepConfig {
   std::string node_config_;
   std::string item_feat_;
   std::string inst_file_;
+  std::string inst_binary_file_;
+  std::string dump_inst_binary_file_;
   std::string freq_file_;
 
   int negative_sampler_type_ = 0;
@@ -28,6 +30,12 @@ class DeepConfig {
   const std::string& node_config() const noexcept { return node_config_; }
   const std::string& item_feature() const noexcept { return item_feat_; }
   const std::string& inst_file() const noexcept { return inst_file_; }
+  const std::string& inst_binary_file() const noexcept {
+    return inst_binary_file_;
+  }
+  const std::string& dump_inst_binary_file() const noexcept {
+    return dump_inst_binary_file_;
+  }
   const std::string& freq_file() const noexcept { return freq_file_; }
 
   int negative_sampler_type() const noexcept { return negative_sampler_type_; }
@@ -40,6 +48,14 @@ class DeepConfig {
   }
   void set_item_feature(const std::string& path) noexcept { item_feat_ = path; }
   void set_inst_file(const std::string& path) noexcept { inst_file_ = path; }
+  // mapped instead of inst_file
+  void set_inst_binary_file(const std::string& path) noexcept {
+    inst_binary_file_ = path;
+  }
+  // written from inst_file after loading
+  void set_dump_inst_binary_file(const std::string& path) noexcept {
+    dump_inst_binary_file_ = path;
+  }
   void set_freq_file(const std::string& path) noexcept { freq_file_ = path; }
 
   // type
@@ -42,12 +42,22 @@ bool DeepData::Build(const DeepConfig& config) {
   }
 
   // inst file
-  if (!config.inst_file().empty()) {
+  if (!config.inst_binary_file().empty()) {
+    inst_file_loader_ =
+        InstFileLoader::CreateFromBinary(config.inst_binary_file());
+    if (!inst_file_loader_) {
+      return false;
+    }
+  } else if (!config.inst_file().empty()) {
     inst_file_loader_ =
         InstFileLoader::Create(config.inst_file(), config.thread_num());
     if (!inst_file_loader_) {
       return false;
     }
+    if (!config.dump_inst_binary_file().empty() &&
+        !inst_file_loader_->Dump(config.dump_inst_binary_file())) {
+      return false;
+    }
   }
 
   // freq file
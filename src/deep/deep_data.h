@@ -31,13 +31,14 @@ class DeepData {
   static std::unique_ptr<DeepData> Create(const DeepConfig& config);
 
  public:
-  const vec_pair_t* FindItemFeature(int_t item) const {
+  pair_view_t FindItemFeature(int_t item) const {
     return item_feature_loader_->storage()->FindNeighbor(item);
   }
 
-  const vec_int_t& insts() const noexcept { return inst_file_loader_->insts(); }
-  const std::vector<vecl_t>& vec_labels_list() const noexcept {
-    return inst_file_loader_->vec_labels_list();
+  size_t inst_size() const noexcept { return inst_file_loader_->size(); }
+  ArrayView<int_t> insts() const noexcept { return inst_file_loader_->insts(); }
+  ArrayView<int> labels(size_t i) const noexcept {
+    return inst_file_loader_->labels(i);
   }
 
   int ns_size() const noexcept { return freq_file_loader_->ns_size(); }
@@ -13,6 +13,7 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdio>   // std::remove
 #include <memory>   // std::unique_ptr
 #include <numeric>  // std::accumulate
 #include <string>
@@ -32,6 +33,10 @@ class DeepDataTest : public ::testing::Test {
   const std::string NODE_CONFIG = "testdata/user_item_config";
   const std::string ITEM_FEATURE_FILE = "testdata/context";
   const std::string INST_FILE = "testdata/inst";
+  const std::string INST_BINARY_FILE = "deep_data_test.inst";
+
+ protected:
+  void TearDown() override { std::remove(INST_BINARY_FILE.c_str()); }
 };
 
 TEST_F(DeepDataTest, FailOnMissingFreqFile) {
@@ -83,12 +88,12 @@ TEST_F(DeepDataTest, LoadItemFeature) {
   deep_data_ = DeepData::Create(config_);
   EXPECT_TRUE(deep_data_ != nullptr);
 
-  const auto* item_feature = deep_data_->FindItemFeature(13);
-  EXPECT_TRUE(item_feature == nullptr);
+  auto item_feature = deep_data_->FindItemFeature(13);
+  EXPECT_TRUE(item_feature.empty());
 
   item_feature = deep_data_->FindItemFeature(10);
-  EXPECT_TRUE(item_feature != nullptr);
-  EXPECT_EQ(item_feature->size(), 3u);
+  EXPECT_FALSE(item_feature.empty());
+  EXPECT_EQ(item_feature.size(), 3u);
 }
 
 TEST_F(DeepDataTest, LoadInstFile) {
@@ -98,13 +103,38 @@ TEST_F(DeepDataTest, LoadInstFile) {
   deep_data_ = DeepData::Create(config_);
   EXPECT_TRUE(deep_data_ != nullptr);
 
+  EXPECT_EQ(deep_data_->inst_size(), 16u);
   EXPECT_EQ(deep_data_->insts().size(), 16u);
-  EXPECT_EQ(deep_data_->vec_labels_list().size(), 16u);
-  auto labels = deep_data_->vec_labels_list()[10];
+  auto labels = deep_data_->labels(10);
   EXPECT_EQ(labels.size(), 3u);
   EXPECT_EQ(labels[0], 1);
   EXPECT_EQ(labels[1], 0);
   EXPECT_EQ(labels[2], 1);
 }
 
+TEST_F(DeepDataTest, LoadInstBinaryFile) {
+  config_.set_inst_file(INST_FILE);
+  config_.set_dump_inst_binary_file(INST_BINARY_FILE);
+  deep_data_ = DeepData::Create(config_);
+  ASSERT_TRUE(deep_data_ != nullptr);
+
+  DeepConfig binary_config;
+  binary_config.set_inst_binary_file(INST_BINARY_FILE);
+  auto binary_data = DeepData::Create(binary_config);
+  ASSERT_TRUE(binary_data != nullptr);
+
+  ASSERT_EQ(binary_data->inst_size(), deep_data_->inst_size());
+  for (size_t i = 0; i < deep_data_->inst_size(); ++i) {
+    EXPECT_EQ(binary_data->insts()[i], deep_data_->insts()[i]);
+    auto labels = deep_data_->labels(i);
+    auto binary_labels = binary_data->labels(i);
+    EXPECT_EQ(vecl_t(binary_labels.begin(), binary_labels.end()),
+              vecl_t(labels.begin(), labels.end()));
+  }
+
+  // text files are not mapped
+  binary_config.set_inst_binary_file(INST_FILE);
+  EXPECT_TRUE(DeepData::Create(binary_config) == nullptr);
+}
+
 }  // namespace embedx
@@ -37,6 +37,13 @@ const vec_pair_t* CacheStorage::FindFeature(int_t node) const {
   return FindCache(feat_map_, node);
 }
 
+void CacheStorage::CollectMemory(MemoryUsage* usage) const {
+  usage->Add("context", NestedMapBytes(context_map_), context_map_.size());
+  usage->Add("node_feature", NestedMapBytes(node_feat_map_),
+             node_feat_map_.size());
+  usage->Add("feature", NestedMapBytes(feat_map_), feat_map_.size());
+}
+
 std::unique_ptr<CacheStorage> NewCacheStorage() {
   std::unique_ptr<CacheStorage> cache_storage;
   cache_storage.reset(new CacheStorage());
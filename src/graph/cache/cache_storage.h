@@ -13,6 +13,7 @@
 #include <memory>  // std::unique_ptr
 
 #include "src/common/data_types.h"
+#include "src/common/memory_usage.h"
 
 namespace embedx {
 
@@ -30,6 +31,7 @@ class CacheStorage {
   const vec_pair_t* FindContext(int_t node) const;
   const vec_pair_t* FindNodeFeature(int_t node) const;
   const vec_pair_t* FindFeature(int_t node) const;
+  void CollectMemory(MemoryUsage* usage) const;
 
  public:
   const adj_list_t* context_map() const noexcept { return &context_map_; }
@@ -12,7 +12,8 @@
 #include <deepx_core/dx_log.h>
 #include <deepx_core/ps/rpc_client.h>
 
-#include <memory>  // std::unique_ptr
+#include <memory>   // std::unique_ptr
+#include <utility>  // std::move
 #include <vector>
 
 #include "src/common/data_types.h"
@@ -30,6 +31,7 @@
 #include "src/graph/data_op/neighbor_sampler_op/dist_random_neighbor_sampler.h"
 #include "src/graph/data_op/random_walker_op/dist_static_random_walker.h"
 #include "src/graph/graph_config.h"
+#include "src/io/shard_partitioner.h"
 
 namespace embedx {
 namespace {
@@ -70,6 +72,13 @@ class DistGraphClientImpl : public GraphClientImplBase<DistGraphClientTypes> {
     }
     DXINFO("Number of shard is: %d.", shard_num);
 
+    auto partitioner = NewShardPartitioner(
+        config.partitioner_type(), shard_num, config.partition_file());
+    if (!partitioner) {
+      return false;
+    }
+    resource_->set_partitioner(std::move(partitioner));
+
     // op factory init
     factory_ = graph_op::DistGSOpFactory::GetInstance();
     if (!factory_->Init(resource_.get(), shard_num)) {
@@ -79,6 +88,10 @@ class DistGraphClientImpl : public GraphClientImplBase<DistGraphClientTypes> {
     return PostInitCacheStorage(resource_.get()) &&
            PostInitServerDistribution(shard_num, resource_.get());
   }
+
+  bool RefreshCache() const override {
+    return RefreshCacheStorage(resource_.get());
+  }
 };
 
 std::unique_ptr<GraphClientImpl> NewDistGraphClientImpl(
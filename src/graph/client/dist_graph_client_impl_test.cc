@@ -0,0 +1,167 @@
+// Tencent is pleased to support the open source community by making embedx
+// available.
+//
+// Copyright (C) 2021 THL A29 Limited, a Tencent company.  All rights reserved.
+//
+// Licensed under the BSD 3-Clause License and other third-party components,
+// please refer to LICENSE for details.
+//
+
+#include <gtest/gtest.h>
+
+#include <memory>  // std::unique_ptr
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "src/graph/client/graph_client.h"
+#include "src/graph/graph_config.h"
+#include "src/graph/server/dist_graph_server.h"
+#include "src/sampler/random_walker_data_types.h"
+
+namespace embedx {
+
+class DistGraphClientImplTest : public ::testing::Test {
+ protected:
+  std::vector<std::unique_ptr<DistGraphServer>> servers_;
+  std::vector<std::thread> server_threads_;
+  GraphConfig config_;
+
+ protected:
+  const std::string CONTEXT = "testdata/context";
+  const std::string NODE_FEATURE = "testdata/node_feature";
+  const std::string DELTA_NODE_FEATURE = "testdata/delta/node_feature";
+
+  const int PORT = 61081;
+  const int THREAD_NUM = 2;
+
+ protected:
+  void SetUp() override {
+    config_.set_node_graph(CONTEXT);
+    config_.set_node_feature(NODE_FEATURE);
+    config_.set_thread_num(THREAD_NUM);
+    // caches all nodes
+    config_.set_cache_type(1);
+    config_.set_cache_thld(1.0);
+  }
+
+  void TearDown() override { StopServers(); }
+
+  // Starts 'shard_num' servers of config_ in this process.
+  void StartServers(int shard_num) {
+    std::string ip_ports;
+    for (int i = 0; i < shard_num; ++i) {
+      ip_ports += (i == 0 ? "" : ";");
+      ip_ports += "127.0.0.1:" + std::to_string(PORT + i);
+    }
+    config_.set_ip_ports(ip_ports);
+    config_.set_shard_num(shard_num);
+
+    for (int i = 0; i < shard_num; ++i) {
+      GraphConfig config = config_;
+      config.set_shard_id(i);
+      servers_.emplace_back(new DistGraphServer);
+      auto* server = servers_.back().get();
+      server_threads_.emplace_back(
+          [server, config]() { server->Start(config); });
+    }
+  }
+
+  void StopServers() {
+    for (auto& server : servers_) {
+      server->Stop();
+    }
+    for (auto& thread : server_threads_) {
+      thread.join();
+    }
+    servers_.clear();
+    server_threads_.clear();
+  }
+
+  static vec_int_t FeatureKeys(const GraphClient& graph_client, int_t node) {
+    std::vector<vec_pair_t> feats_list;
+    EXPECT_TRUE(graph_client.LookupNodeFeature({node}, &feats_list));
+    vec_int_t keys;
+    if (feats_list.size() == 1) {
+      for (const auto& entry : feats_list[0]) {
+        keys.emplace_back(entry.first);
+      }
+    }
+    return keys;
+  }
+};
+
+TEST_F(DistGraphClientImplTest, RefreshCache) {
+  StartServers(1);
+  auto graph_client = NewGraphClient(config_, GraphClientEnum::DIST);
+  ASSERT_TRUE(graph_client != nullptr);
+  EXPECT_EQ(FeatureKeys(*graph_client, 0), vec_int_t({10, 20}));
+
+  // Features are served from the cache until it is refreshed.
+  GraphConfig reload_config = config_;
+  reload_config.set_shard_id(0);
+  reload_config.set_node_feature(DELTA_NODE_FEATURE);
+  ASSERT_TRUE(servers_[0]->Reload(reload_config, 1));
+  EXPECT_EQ(FeatureKeys(*graph_client, 0), vec_int_t({10, 20}));
+
+  EXPECT_TRUE(graph_client->RefreshCache());
+  EXPECT_EQ(FeatureKeys(*graph_client, 0), vec_int_t({99}));
+
+  // An unchanged version keeps the cache.
+  EXPECT_TRUE(graph_client->RefreshCache());
+  EXPECT_EQ(FeatureKeys(*graph_client, 0), vec_int_t({99}));
+}
+
+TEST_F(DistGraphClientImplTest, SeedSampling_Shards) {
+  vec_int_t nodes = {0, 3, 6, 9, 0};
+  std::vector<int> walk_lens(nodes.size(), 5);
+  WalkerInfo walker_info;
+  using lists_t = std::vector<std::vector<vec_int_t>>;
+  auto sample = [&nodes, &walk_lens, &walker_info](
+                    const GraphClient& graph_client, lists_t* lists) {
+    lists->assign(3, {});
+    GraphClient::SetSampleBatch(3);
+    EXPECT_TRUE(graph_client.RandomSampleNeighbor(2, nodes, &(*lists)[0]));
+    EXPECT_TRUE(graph_client.StaticTraverse(nodes, walk_lens, walker_info,
+                                            &(*lists)[1]));
+    EXPECT_TRUE(graph_client.IndepSampleNegative(5, nodes, {}, &(*lists)[2]));
+  };
+
+  // one shard
+  lists_t one_shard_lists;
+  StartServers(1);
+  {
+    auto graph_client = NewGraphClient(config_, GraphClientEnum::DIST);
+    ASSERT_TRUE(graph_client != nullptr);
+    graph_client->SeedSampling(7, 0);
+    sample(*graph_client, &one_shard_lists);
+  }
+  StopServers();
+
+  // two shards, repeated on two threads
+  lists_t two_shard_lists;
+  lists_t thread_lists;
+  StartServers(2);
+  {
+    auto graph_client = NewGraphClient(config_, GraphClientEnum::DIST);
+    ASSERT_TRUE(graph_client != nullptr);
+    graph_client->SeedSampling(7, 0);
+    sample(*graph_client, &two_shard_lists);
+    std::thread thread([&sample, &graph_client, &thread_lists]() {
+      sample(*graph_client, &thread_lists);
+    });
+    thread.join();
+  }
+
+  // Everything repeats for the same number of shards.
+  EXPECT_EQ(thread_lists, two_shard_lists);
+
+  // Neighbors and walks don't depend on the number of shards.
+  EXPECT_EQ(two_shard_lists[0], one_shard_lists[0]);
+  EXPECT_EQ(two_shard_lists[1], one_shard_lists[1]);
+
+  // Negatives do, each shard draws them from the nodes it loaded.
+  EXPECT_NE(two_shard_lists[2], one_shard_lists[2]);
+}
+
+}  // namespace embedx
@@ -15,9 +15,24 @@
 
 #include <utility>  // std::move
 
+#include "src/common/random.h"
 #include "src/graph/client/graph_client_impl.h"
 
 namespace embedx {
+namespace {
+
+struct SampleBatch {
+  uint64_t batch = 0;
+  // sampling calls in the batch
+  uint64_t call = 0;
+};
+
+SampleBatch& ThreadLocalSampleBatch() {
+  static thread_local SampleBatch sample_batch;
+  return sample_batch;
+}
+
+}  // namespace
 
 GraphClient::GraphClient(std::unique_ptr<GraphClientImpl>&& impl) {
   impl_ = std::move(impl);
@@ -25,31 +40,52 @@ GraphClient::GraphClient(std::unique_ptr<GraphClientImpl>&& impl) {
 
 GraphClient::~GraphClient() {}
 
+void GraphClient::SeedSampling(uint64_t seed, int epoch) noexcept {
+  sample_key_ = seed == 0 ? 0 : Philox4x32(seed, 0, (uint64_t)epoch) | 1;
+}
+
+void GraphClient::SetSampleBatch(uint64_t batch) noexcept {
+  auto& sample_batch = ThreadLocalSampleBatch();
+  sample_batch.batch = batch;
+  sample_batch.call = 0;
+}
+
+uint64_t GraphClient::NextSampleSeed() const noexcept {
+  if (sample_key_ == 0) {
+    return 0;
+  }
+  // Calls of a batch are made in the same order by any thread.
+  auto& sample_batch = ThreadLocalSampleBatch();
+  return Philox4x32(sample_key_, sample_batch.batch, sample_batch.call++) | 1;
+}
+
 bool GraphClient::SharedSampleNegative(
     int count, const vec_int_t& nodes, const vec_int_t& excluded_nodes,
     std::vector<vec_int_t>* sampled_nodes_list) const {
   return impl_->SharedSampleNegative(count, nodes, excluded_nodes,
-                                     sampled_nodes_list);
+                                     NextSampleSeed(), sampled_nodes_list);
 }
 
 bool GraphClient::IndepSampleNegative(
     int count, const vec_int_t& nodes, const vec_int_t& excluded_nodes,
     std::vector<vec_int_t>* sampled_nodes_list) const {
   return impl_->IndepSampleNegative(count, nodes, excluded_nodes,
-                                    sampled_nodes_list);
+                                    NextSampleSeed(), sampled_nodes_list);
 }
 
 bool GraphClient::StaticTraverse(const vec_int_t& cur_nodes,
                                  const std::vector<int>& walk_lens,
                                  const WalkerInfo& walker_info,
                                  std::vector<vec_int_t>* seqs) const {
-  return impl_->StaticTraverse(cur_nodes, walk_lens, walker_info, seqs);
+  return impl_->StaticTraverse(cur_nodes, walk_lens, walker_info,
+                               NextSampleSeed(), seqs);
 }
 
 bool GraphClient::RandomSampleNeighbor(
     int count, const vec_int_t& nodes,
     std::vector<vec_int_t>* neighbor_nodes_list) const {
-  return impl_->RandomSampleNeighbor(count, nodes, neighbor_nodes_list);
+  return impl_->RandomSampleNeighbor(count, nodes, NextSampleSeed(),
+                                     neighbor_nodes_list);
 }
 
 bool GraphClient::LookupFeature(const vec_int_t& nodes,
@@ -73,6 +109,8 @@ bool GraphClient::LookupContext(const vec_int_t& nodes,
   return impl_->LookupContext(nodes, contexts);
 }
 
+bool GraphClient::RefreshCache() const { return impl_->RefreshCache(); }
+
 std::unique_ptr<GraphClient> NewGraphClient(const GraphConfig& config,
                                             GraphClientEnum type) {
   std::unique_ptr<GraphClient> graph_client;
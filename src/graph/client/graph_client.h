@@ -10,6 +10,7 @@
 //
 
 #pragma once
+#include <cstdint>
 #include <memory>  // std::unique_ptr
 #include <vector>
 
@@ -24,12 +25,26 @@ class GraphClientImpl;
 class GraphClient {
  private:
   std::unique_ptr<GraphClientImpl> impl_;
+  uint64_t sample_key_ = 0;
 
  public:
   explicit GraphClient(std::unique_ptr<GraphClientImpl>&& impl);
   ~GraphClient();
 
  public:
+  // seeded sampling
+  // Once seeded, the sampling calls of a batch (see SetSampleBatch) sample
+  // the same nodes for the same seed, epoch, batch and arguments, whatever
+  // the number of threads. Neighbor sampling and random walks also repeat
+  // whatever the number of shards. Negative sampling, shared and
+  // independent, draws from the nodes loaded by each shard and only repeats
+  // for the same number of shards, so does ShuffleNodesInGlobal. A seed of 0
+  // turns it off. Must not be called concurrently with sampling, e.g. called
+  // between epochs.
+  void SeedSampling(uint64_t seed, int epoch) noexcept;
+  // Starts the sampling batch 'batch' of the calling thread.
+  static void SetSampleBatch(uint64_t batch) noexcept;
+
   // negative sampler
   bool SharedSampleNegative(int count, const vec_int_t& nodes,
                             const vec_int_t& excluded_nodes,
@@ -61,6 +76,17 @@ class GraphClient {
   // context
   bool LookupContext(const vec_int_t& nodes,
                      std::vector<vec_pair_t>* contexts) const;
+
+  // cache
+  // Rebuilds the client cache if a server reloaded its graph or applied a
+  // delta since the cache was built, e.g. called between epochs. Must not be
+  // called concurrently with itself.
+  bool RefreshCache() const;
+
+  // Returns the seed of the next sampling call of the calling thread, 0 if
+  // sampling isn't seeded. Client side randomness of a batch, e.g. feature
+  // masks, seeds RandomSeedScope with it.
+  uint64_t NextSampleSeed() const noexcept;
 };
 
 enum class GraphClientEnum : int { LOCAL = 0, DIST = 1 };
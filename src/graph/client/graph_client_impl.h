@@ -10,6 +10,7 @@
 //
 
 #pragma once
+#include <cstdint>
 #include <memory>  // std::unique_ptr
 #include <vector>
 
@@ -24,23 +25,25 @@ class GraphClientImpl {
   virtual ~GraphClientImpl() = default;
 
  public:
+  // 'seed' keys the sampling streams, 0 for unseeded sampling.
+
   // negative sampler
   virtual bool SharedSampleNegative(
       int count, const vec_int_t& nodes, const vec_int_t& excluded_nodes,
-      std::vector<vec_int_t>* sampled_nodes_list) const = 0;
+      uint64_t seed, std::vector<vec_int_t>* sampled_nodes_list) const = 0;
   virtual bool IndepSampleNegative(
       int count, const vec_int_t& nodes, const vec_int_t& excluded_nodes,
-      std::vector<vec_int_t>* sampled_nodes_list) const = 0;
+      uint64_t seed, std::vector<vec_int_t>* sampled_nodes_list) const = 0;
 
   // neighbor sampler
   virtual bool RandomSampleNeighbor(
-      int count, const vec_int_t& nodes,
+      int count, const vec_int_t& nodes, uint64_t seed,
       std::vector<vec_int_t>* neighbor_nodes_list) const = 0;
 
   // random walker
   virtual bool StaticTraverse(const vec_int_t& cur_nodes,
                               const std::vector<int>& walk_lens,
-                              const WalkerInfo& walker_info,
+                              const WalkerInfo& walker_info, uint64_t seed,
                               std::vector<vec_int_t>* seqs) const = 0;
 
   // feature
@@ -57,6 +60,9 @@ class GraphClientImpl {
   // context
   virtual bool LookupContext(const vec_int_t& nodes,
                              std::vector<vec_pair_t>* contexts) const = 0;
+
+  // cache
+  virtual bool RefreshCache() const = 0;
 };
 
 template <typename GraphClientTypes>
@@ -74,29 +80,31 @@ class GraphClientImplBase : public GraphClientImpl {
   /************************************************************************/
   bool SharedSampleNegative(
       int count, const vec_int_t& nodes, const vec_int_t& excluded_nodes,
+      uint64_t seed,
       std::vector<vec_int_t>* sampled_nodes_list) const override {
     auto* op = factory_->LookupOrCreate("SharedNegativeSampler");
     return dynamic_cast<typename GraphClientTypes::SharedNegativeSampler*>(op)
-        ->Run(count, nodes, excluded_nodes, sampled_nodes_list);
+        ->Run(count, nodes, excluded_nodes, seed, sampled_nodes_list);
   }
 
   bool IndepSampleNegative(
       int count, const vec_int_t& nodes, const vec_int_t& excluded_nodes,
+      uint64_t seed,
       std::vector<vec_int_t>* sampled_nodes_list) const override {
     auto* op = factory_->LookupOrCreate("IndepNegativeSampler");
     return dynamic_cast<typename GraphClientTypes::IndepNegativeSampler*>(op)
-        ->Run(count, nodes, excluded_nodes, sampled_nodes_list);
+        ->Run(count, nodes, excluded_nodes, seed, sampled_nodes_list);
   }
 
   /************************************************************************/
   /* Random neighbor sampler */
   /************************************************************************/
   bool RandomSampleNeighbor(
-      int count, const vec_int_t& nodes,
+      int count, const vec_int_t& nodes, uint64_t seed,
       std::vector<vec_int_t>* neighbor_nodes_list) const override {
     auto* op = factory_->LookupOrCreate("RandomNeighborSampler");
     return dynamic_cast<typename GraphClientTypes::RandomNeighborSampler*>(op)
-        ->Run(count, nodes, neighbor_nodes_list);
+        ->Run(count, nodes, seed, neighbor_nodes_list);
   }
 
   /************************************************************************/
@@ -104,11 +112,11 @@ class GraphClientImplBase : public GraphClientImpl {
   /************************************************************************/
   bool StaticTraverse(const vec_int_t& cur_nodes,
                       const std::vector<int>& walk_lens,
-                      const WalkerInfo& walker_info,
+                      const WalkerInfo& walker_info, uint64_t seed,
                       std::vector<vec_int_t>* seqs) const override {
     auto* op = factory_->LookupOrCreate("StaticRandomWalker");
     return dynamic_cast<typename GraphClientTypes::StaticRandomWalker*>(op)
-        ->Run(cur_nodes, walk_lens, walker_info, seqs);
+        ->Run(cur_nodes, walk_lens, walker_info, seed, seqs);
   }
 
   /************************************************************************/
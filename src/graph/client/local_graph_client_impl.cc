@@ -91,6 +91,9 @@ class LocalGraphClientImpl : public GraphClientImplBase<LocalGraphClientTypes> {
     factory_ = graph_op::LocalGSOpFactory::GetInstance();
     return factory_->Init(resource_.get());
   }
+
+  // no cache
+  bool RefreshCache() const override { return true; }
 };
 
 std::unique_ptr<GraphClientImpl> NewLocalGraphClientImpl(
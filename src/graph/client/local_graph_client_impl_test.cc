@@ -13,6 +13,7 @@
 
 #include <algorithm>  // std::find_if
 #include <memory>     // std::unique_ptr
+#include <thread>
 
 #include "src/graph/client/graph_client.h"
 #include "src/graph/graph_config.h"
@@ -154,6 +155,43 @@ TEST_F(LocalGraphClientImplTest, StaticTraverse) {
   }
 }
 
+TEST_F(LocalGraphClientImplTest, SeedSampling) {
+  vec_int_t nodes = {0, 9, 0};
+  std::vector<int> walk_lens = {5, 5, 5};
+  WalkerInfo walker_info;
+  using lists_t = std::vector<std::vector<vec_int_t>>;
+  auto sample = [this, &nodes, &walk_lens, &walker_info](uint64_t batch,
+                                                          lists_t* lists) {
+    lists->assign(3, {});
+    GraphClient::SetSampleBatch(batch);
+    EXPECT_TRUE(graph_client_->RandomSampleNeighbor(10, nodes, &(*lists)[0]));
+    EXPECT_TRUE(
+        graph_client_->IndepSampleNegative(10, nodes, {}, &(*lists)[1]));
+    EXPECT_TRUE(graph_client_->StaticTraverse(nodes, walk_lens, walker_info,
+                                              &(*lists)[2]));
+  };
+
+  graph_client_->SeedSampling(7, 0);
+  lists_t lists;
+  sample(3, &lists);
+  EXPECT_NE(lists[0][0], lists[0][2]);
+
+  // on another thread
+  lists_t thread_lists;
+  std::thread thread([&sample, &thread_lists]() { sample(3, &thread_lists); });
+  thread.join();
+  EXPECT_EQ(thread_lists, lists);
+
+  lists_t other_lists;
+  sample(4, &other_lists);
+  EXPECT_NE(other_lists, lists);
+  graph_client_->SeedSampling(7, 1);
+  sample(3, &other_lists);
+  EXPECT_NE(other_lists, lists);
+
+  graph_client_->SeedSampling(0, 0);
+}
+
 TEST_F(LocalGraphClientImplTest, LookupFeature) {
   vec_int_t nodes = {10, 11, 12, 13};
   std::vector<vec_pair_t> node_feats;
@@ -13,8 +13,10 @@
 
 #include <deepx_core/dx_log.h>
 
+#include <string>
 #include <vector>
 
+#include "src/common/memory_usage.h"
 #include "src/graph/cache/cache_storage.h"
 #include "src/graph/data_op/cache_storage_lookuper_op/dist_cache_storage_lookuper.h"
 #include "src/graph/data_op/gs_op_factory.h"
@@ -40,6 +42,18 @@ bool BuildCacheStorage(CacheStorage* cache_storage) {
   return true;
 }
 
+bool FetchGraphVersion(std::vector<std::string>* versions) {
+  auto* op = graph_op::DistGSOpFactory::GetInstance()->LookupOrCreate(
+      "DistMetaLookuper");
+  DXCHECK(op != nullptr);
+  if (!dynamic_cast<graph_op::DistMetaLookuper*>(op)->LookupGraphVersion(
+          versions)) {
+    DXERROR("Failed to fetch graph version.");
+    return false;
+  }
+  return true;
+}
+
 bool FetchServerDistribution(int shard_num, int* ns_size, vec_float_t* probs) {
   std::vector<vec_int_t> node_freqs_list;
   auto* op = graph_op::DistGSOpFactory::GetInstance()->LookupOrCreate(
@@ -77,14 +91,39 @@ bool FetchServerDistribution(int shard_num, int* ns_size, vec_float_t* probs) {
 }  // namespace
 
 bool PostInitCacheStorage(graph_op::DistGSOpResource* resource) {
+  // Versions are fetched first, a graph changed while building is detected
+  // by the next refresh.
+  std::vector<std::string> versions;
+  if (!FetchGraphVersion(&versions)) {
+    return false;
+  }
+
   auto cache_storage = NewCacheStorage();
   if (!BuildCacheStorage(cache_storage.get())) {
     return false;
   }
+  MemoryUsage usage;
+  cache_storage->CollectMemory(&usage);
+  DXINFO("Memory usage of cache storage:\n%s", usage.ToString().c_str());
   resource->set_cache_storage(std::move(cache_storage));
+  resource->set_graph_versions(versions);
   return true;
 }
 
+bool RefreshCacheStorage(graph_op::DistGSOpResource* resource) {
+  std::vector<std::string> versions;
+  if (!FetchGraphVersion(&versions)) {
+    return false;
+  }
+
+  if (versions == resource->graph_versions()) {
+    return true;
+  }
+
+  DXINFO("Graph version changed, rebuilding cache storage...");
+  return PostInitCacheStorage(resource);
+}
+
 bool PostInitServerDistribution(int shard_num,
                                 graph_op::DistGSOpResource* resource) {
   int ns_size = 0;
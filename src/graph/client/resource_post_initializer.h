@@ -16,6 +16,10 @@ namespace embedx {
 
 bool PostInitCacheStorage(graph_op::DistGSOpResource* resource);
 
+// Rebuilds the cache storage if the graph version of any server changed since
+// it was built. Lookups keep using the old one until the new one is built.
+bool RefreshCacheStorage(graph_op::DistGSOpResource* resource);
+
 bool PostInitServerDistribution(int shard_num,
                                 graph_op::DistGSOpResource* resource);
 
@@ -122,7 +122,7 @@ bool DistCacheStorageLookuper::LookupFeature(const vec_int_t& nodes,
     // from nodes[node_begin] to nodes[node_begin + max_node_num]
     for (size_t i = node_begin;
          i < nodes.size() && i < node_begin + max_node_num; ++i) {
-      int shard_id = ModShard(nodes[i]);
+      int shard_id = GetShard(nodes[i]);
       reqs[shard_id].nodes.emplace_back(nodes[i]);
       masks[shard_id] += 1;
       ++node_begin;
@@ -180,7 +180,7 @@ bool DistCacheStorageLookuper::LookupContext(const vec_int_t& nodes,
     // from nodes[node_begin] to nodes[node_begin + max_node_num]
     for (size_t i = node_begin;
          i < nodes.size() && i < node_begin + max_node_num; ++i) {
-      int shard_id = ModShard(nodes[i]);
+      int shard_id = GetShard(nodes[i]);
       reqs[shard_id].nodes.emplace_back(nodes[i]);
       masks[shard_id] += 1;
       ++node_begin;
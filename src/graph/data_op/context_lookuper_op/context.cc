@@ -26,16 +26,16 @@ bool Context::Lookup(const vec_int_t& nodes,
   size_t empty_count = 0;
 
   for (size_t i = 0; i < nodes.size(); ++i) {
-    const auto* cur_context = graph_.FindContext(nodes[i]);
+    auto cur_context = graph_.FindContext(nodes[i]);
 
-    if (cur_context == nullptr) {
+    if (cur_context.empty()) {
       DXERROR("Couldn't find node: %" PRIu64 " context.", nodes[i]);
 
       empty_count += 1;
       continue;
     }
 
-    (*contexts)[i] = *cur_context;
+    (*contexts)[i].assign(cur_context.begin(), cur_context.end());
   }
 
   return nodes.size() > empty_count;
@@ -51,13 +51,13 @@ TEST_F(ContextTest, Lookup) {
   EXPECT_EQ(nodes.size(), contexts.size());
 
   for (size_t i = 0; i < nodes.size(); ++i) {
-    auto* real_context = graph_->FindContext(nodes[i]);
+    auto real_context = graph_->FindContext(nodes[i]);
 
-    EXPECT_TRUE(real_context != nullptr);
-    EXPECT_EQ(contexts[i].size(), real_context->size());
+    EXPECT_FALSE(real_context.empty());
+    EXPECT_EQ(contexts[i].size(), real_context.size());
 
     for (size_t j = 0; j < contexts[i].size(); ++j) {
-      EXPECT_EQ(contexts[i][j], (*real_context)[j]);
+      EXPECT_EQ(contexts[i][j], real_context[j]);
     }
   }
 }
@@ -31,7 +31,7 @@ bool DistContextLookuper::Run(const vec_int_t& nodes,
 
   // map
   for (size_t i = 0; i < nodes.size(); ++i) {
-    int shard_id = ModShard(nodes[i]);
+    int shard_id = GetShard(nodes[i]);
 
     masks[shard_id] += 1;
     indices[shard_id].emplace_back(i);
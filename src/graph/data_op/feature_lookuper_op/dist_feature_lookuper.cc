@@ -37,12 +37,11 @@ bool DistFeatureLookuper::Run(const vec_int_t& nodes,
   neigh_feats->resize(nodes.size());
 
   // map
+  auto cache_storage = resource_->cache_storage();
   masks.assign(shard_num_, 0);
   for (size_t i = 0; i < nodes.size(); ++i) {
-    const auto* node_feat_ptr =
-        resource_->cache_storage()->FindNodeFeature(nodes[i]);
-    const auto* neigh_feat_ptr =
-        resource_->cache_storage()->FindFeature(nodes[i]);
+    const auto* node_feat_ptr = cache_storage->FindNodeFeature(nodes[i]);
+    const auto* neigh_feat_ptr = cache_storage->FindFeature(nodes[i]);
     if (node_feat_ptr != nullptr && neigh_feat_ptr != nullptr) {
       // cache hit ,get node feature and neighbor feature in cache
       (*node_feats)[i].insert((*node_feats)[i].end(), node_feat_ptr->begin(),
@@ -51,7 +50,7 @@ bool DistFeatureLookuper::Run(const vec_int_t& nodes,
                                neigh_feat_ptr->end());
     } else {
       // cache miss, add nodes to request
-      int shard_id = ModShard(nodes[i]);
+      int shard_id = GetShard(nodes[i]);
       indices_list[shard_id].emplace_back((int)i);
       requests[shard_id].nodes.emplace_back(nodes[i]);
       masks[shard_id] += 1;
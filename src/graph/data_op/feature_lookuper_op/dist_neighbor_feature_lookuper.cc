@@ -33,7 +33,7 @@ bool DistNeighborFeatureLookuper::Run(
   // map
   masks.assign(shard_num_, 0);
   for (size_t i = 0; i < nodes.size(); ++i) {
-    int shard_id = ModShard(nodes[i]);
+    int shard_id = GetShard(nodes[i]);
     indices_list[shard_id].emplace_back((int)i);
     requests[shard_id].nodes.emplace_back(nodes[i]);
     masks[shard_id] += 1;
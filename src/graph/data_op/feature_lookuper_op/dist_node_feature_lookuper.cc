@@ -34,10 +34,10 @@ bool DistNodeFeatureLookuper::Run(const vec_int_t& nodes,
   node_feats->resize(nodes.size());
 
   // map
+  auto cache_storage = resource_->cache_storage();
   masks.assign(shard_num_, 0);
   for (size_t i = 0; i < nodes.size(); ++i) {
-    const auto* node_feat_ptr =
-        resource_->cache_storage()->FindNodeFeature(nodes[i]);
+    const auto* node_feat_ptr = cache_storage->FindNodeFeature(nodes[i]);
 
     if (node_feat_ptr != nullptr) {
       // cache hit, get node feature in cache
@@ -45,7 +45,7 @@ bool DistNodeFeatureLookuper::Run(const vec_int_t& nodes,
                               node_feat_ptr->end());
     } else {
       // cache miss, add nodes to request
-      int shard_id = ModShard(nodes[i]);
+      int shard_id = GetShard(nodes[i]);
       indices_list[shard_id].emplace_back((int)i);
       requests[shard_id].nodes.emplace_back(nodes[i]);
       masks[shard_id] += 1;
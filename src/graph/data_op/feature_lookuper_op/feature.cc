@@ -41,16 +41,25 @@ bool Feature::LookupNodeFeature(const vec_int_t& nodes,
                                 std::vector<vec_pair_t>* node_feats) const {
   node_feats->clear();
   for (auto node : nodes) {
-    if (graph_.FindContext(node) == nullptr) {
-      DXERROR("Couldn't find node: %" PRIu64 " context.", node);
+    int row = 0;
+    pair_view_t feat;
+    if (graph_.LookupRow(node, &row)) {
+      if (graph_.FindContextAt(row).empty()) {
+        DXERROR("Couldn't find node: %" PRIu64 " context.", node);
+      }
+      feat = graph_.FindNodeFeatureAt(row);
+    } else {
+      // Nodes changed by deltas are found by id.
+      if (graph_.FindContext(node).empty()) {
+        DXERROR("Couldn't find node: %" PRIu64 " context.", node);
+      }
+      feat = graph_.FindNodeFeature(node);
     }
-
-    const auto* feat = graph_.FindNodeFeature(node);
-    if (feat == nullptr) {
+    if (feat.empty()) {
       // insert an empty feature
       node_feats->emplace_back(EMPTY_FEATURE);
     } else {
-      node_feats->emplace_back(*feat);
+      node_feats->emplace_back(feat.begin(), feat.end());
     }
   }
 
@@ -61,16 +70,25 @@ bool Feature::LookupNeighborFeature(
     const vec_int_t& nodes, std::vector<vec_pair_t>* neighbor_feats) const {
   neighbor_feats->clear();
   for (auto node : nodes) {
-    if (graph_.FindContext(node) == nullptr) {
-      DXERROR("Couldn't find node: %" PRIu64 " context.", node);
+    int row = 0;
+    pair_view_t feat;
+    if (graph_.LookupRow(node, &row)) {
+      if (graph_.FindContextAt(row).empty()) {
+        DXERROR("Couldn't find node: %" PRIu64 " context.", node);
+      }
+      feat = graph_.FindNeighFeatureAt(row);
+    } else {
+      // Nodes changed by deltas are found by id.
+      if (graph_.FindContext(node).empty()) {
+        DXERROR("Couldn't find node: %" PRIu64 " context.", node);
+      }
+      feat = graph_.FindNeighFeature(node);
     }
-
-    const auto* feat = graph_.FindNeighFeature(node);
-    if (feat == nullptr) {
+    if (feat.empty()) {
       // insert an empty feature
       neighbor_feats->emplace_back(EMPTY_FEATURE);
     } else {
-      neighbor_feats->emplace_back(*feat);
+      neighbor_feats->emplace_back(feat.begin(), feat.end());
     }
   }
 
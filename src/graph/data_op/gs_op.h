@@ -46,6 +46,12 @@ class DistGSOp {
       DXERROR("Number of shard: %d must be greater than 0.", shard_num);
       return false;
     }
+    if (resource->partitioner() == nullptr ||
+        resource->partitioner()->shard_num() != shard_num) {
+      DXERROR("Need a partitioner of DistGSOpResource with %d shards.",
+              shard_num);
+      return false;
+    }
 
     resource_ = resource;
     conns_ = resource_->rpc_connector()->conns();
@@ -54,7 +60,9 @@ class DistGSOp {
   }
 
  protected:
-  int ModShard(int_t node) const noexcept { return node % shard_num_; }
+  int GetShard(int_t node) const {
+    return resource_->partitioner()->GetShard(node);
+  }
 };
 
 }  // namespace graph_op
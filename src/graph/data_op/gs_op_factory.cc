@@ -78,6 +78,12 @@ LocalGSOpFactory* LocalGSOpFactory::GetInstance() {
   return &factory;
 }
 
+std::unique_ptr<LocalGSOpFactory> LocalGSOpFactory::Create() {
+  std::unique_ptr<LocalGSOpFactory> factory;
+  factory.reset(new CreateOnceGSOpFactory);
+  return factory;
+}
+
 class CreateOnceDistGSOpFactory : public DistGSOpFactory {
  private:
   std::mutex mtx_;
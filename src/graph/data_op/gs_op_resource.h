@@ -12,13 +12,19 @@
 #pragma once
 #include <deepx_core/ps/rpc_client.h>
 
-#include <memory>   // std::unique_ptr
+#include <memory>   // std::shared_ptr, std::unique_ptr
+#include <mutex>
+#include <string>
 #include <utility>  // std::move
+#include <vector>
 
+#include "src/common/memory_usage.h"
+#include "src/common/published_ptr.h"
 #include "src/graph/cache/cache_storage.h"
 #include "src/graph/client/rpc_connector.h"
 #include "src/graph/graph_config.h"
 #include "src/graph/in_memory_graph.h"
+#include "src/io/shard_partitioner.h"
 #include "src/sampler/sampler_builder.h"
 #include "src/sampler/sampler_source.h"
 #include "src/sampler/sampling.h"
@@ -29,13 +35,19 @@ namespace graph_op {
 class LocalGSOpResource {
  private:
   GraphConfig graph_config_;
+  // 0 for the graph built at startup, see DistGraphServer::Reload
+  int graph_version_ = 0;
   std::unique_ptr<InMemoryGraph> graph_;
   std::unique_ptr<SamplerSource> sampler_source_;
   std::unique_ptr<SamplerBuilder> negative_sampler_builder_;
   std::unique_ptr<SamplerBuilder> neighbor_sampler_builder_;
+  // Readers pin, and deltas are published, under it, so that graph lists and
+  // sampler tables are always of the same delta.
+  mutable std::mutex delta_mtx_;
 
  public:
   const GraphConfig& graph_config() const noexcept { return graph_config_; }
+  int graph_version() const noexcept { return graph_version_; }
   const InMemoryGraph* graph() const noexcept { return graph_.get(); }
   const SamplerSource* sampler_source() const noexcept {
     return sampler_source_.get();
@@ -47,10 +59,59 @@ class LocalGSOpResource {
     return neighbor_sampler_builder_.get();
   }
 
+  // the graph and the sampler tables built from it
+  void CollectMemory(MemoryUsage* usage) const {
+    if (graph_) {
+      graph_->CollectMemory(usage);
+    }
+    CollectSamplerMemory(usage);
+  }
+  void CollectSamplerMemory(MemoryUsage* usage) const {
+    MemoryUsage sampler_usage;
+    if (negative_sampler_builder_) {
+      negative_sampler_builder_->CollectMemory(&sampler_usage);
+      usage->Merge("negative_sampler", sampler_usage);
+    }
+    sampler_usage.Clear();
+    if (neighbor_sampler_builder_) {
+      neighbor_sampler_builder_->CollectMemory(&sampler_usage);
+      usage->Merge("neighbor_sampler", sampler_usage);
+    }
+  }
+
+  // Keeps the lists and sampler tables changed by graph deltas for the reads
+  // of the calling thread, e.g. while a request is handled.
+  void PinDeltas(PublishedPins* pins) const {
+    std::lock_guard<std::mutex> guard(delta_mtx_);
+    if (graph_) {
+      graph_->PinDelta(pins);
+    }
+    if (neighbor_sampler_builder_) {
+      neighbor_sampler_builder_->PinUpdate(pins);
+    }
+  }
+
+  // Publishes 'delta_map' of InMemoryGraph::PrepareDelta with the tables of
+  // SamplerBuilder::PrepareUpdate.
+  void PublishDeltas(std::shared_ptr<const delta_map_t> delta_map) {
+    std::lock_guard<std::mutex> guard(delta_mtx_);
+    graph_->PublishDelta(std::move(delta_map));
+    neighbor_sampler_builder_->PublishUpdate();
+  }
+
+  // for graph deltas
+  InMemoryGraph* mutable_graph() noexcept { return graph_.get(); }
+  SamplerBuilder* mutable_neighbor_sampler_builder() noexcept {
+    return neighbor_sampler_builder_.get();
+  }
+
  public:
   void set_graph_config(const GraphConfig& graph_config) {
     graph_config_ = graph_config;
   }
+  void set_graph_version(int graph_version) noexcept {
+    graph_version_ = graph_version;
+  }
   void set_graph(std::unique_ptr<InMemoryGraph> graph) {
     graph_ = std::move(graph);
   }
@@ -70,31 +131,51 @@ class LocalGSOpResource {
 class DistGSOpResource {
  private:
   mutable std::unique_ptr<RpcConnector> rpc_connector_;
+  std::unique_ptr<ShardPartitioner> partitioner_;
   int ns_size_ = 1;
   std::unique_ptr<Sampling> sampling_;
-  std::unique_ptr<CacheStorage> cache_storage_;
+  // replaced by RefreshCacheStorage while ops use it, use std::atomic_load
+  // and std::atomic_store
+  std::shared_ptr<const CacheStorage> cache_storage_;
+  // graph version of each shard the cache storage was built from
+  std::vector<std::string> graph_versions_;
 
  public:
   ~DistGSOpResource() { rpc_connector_->Close(); }
 
  public:
   RpcConnector* rpc_connector() const noexcept { return rpc_connector_.get(); }
+  const ShardPartitioner* partitioner() const noexcept {
+    return partitioner_.get();
+  }
   int ns_size() const noexcept { return ns_size_; }
   const Sampling* sampling() const noexcept { return sampling_.get(); }
-  const CacheStorage* cache_storage() const noexcept {
-    return cache_storage_.get();
+  // Callers keep the returned pointer for the whole lookup, so that a
+  // refreshed cache storage is not mixed with the replaced one.
+  std::shared_ptr<const CacheStorage> cache_storage() const noexcept {
+    return std::atomic_load(&cache_storage_);
+  }
+  const std::vector<std::string>& graph_versions() const noexcept {
+    return graph_versions_;
   }
 
  public:
   void set_rpc_connector(std::unique_ptr<RpcConnector> rpc_connector) noexcept {
     rpc_connector_ = std::move(rpc_connector);
   }
+  void set_partitioner(std::unique_ptr<ShardPartitioner> partitioner) noexcept {
+    partitioner_ = std::move(partitioner);
+  }
   void set_ns_size(int ns_size) noexcept { ns_size_ = ns_size; }
   void set_sampling(std::unique_ptr<Sampling> sampling) noexcept {
     sampling_ = std::move(sampling);
   }
   void set_cache_storage(std::unique_ptr<CacheStorage> cache_storage) noexcept {
-    cache_storage_ = std::move(cache_storage);
+    std::atomic_store(&cache_storage_, std::shared_ptr<const CacheStorage>(
+                                           std::move(cache_storage)));
+  }
+  void set_graph_versions(const std::vector<std::string>& graph_versions) {
+    graph_versions_ = graph_versions;
   }
 };
 
@@ -22,6 +22,8 @@ namespace embedx {
 namespace graph_op {
 namespace {
 
+using ::embedx::rpc_key::GRAPH_VERSION;
+using ::embedx::rpc_key::MEMORY_USAGE;
 using ::embedx::rpc_key::NODE_FREQ;
 
 }  // namespace
@@ -65,6 +67,50 @@ bool DistMetaLookuper::Run(std::vector<vec_int_t>* node_freqs_list) const {
   return true;
 }
 
+bool DistMetaLookuper::LookupGraphVersion(
+    std::vector<std::string>* versions) const {
+  // prepare
+  std::vector<MetaLookuperRequest> requests(shard_num_);
+  std::vector<MetaLookuperResponse> responses(shard_num_);
+  for (int i = 0; i < shard_num_; ++i) {
+    requests[i].key = GRAPH_VERSION;
+  }
+
+  // rpc
+  auto rpc_type = MetaLookuperRequest::rpc_type();
+  if (WriteRequestReadResponse(conns_, rpc_type, requests, &responses) != 0) {
+    return false;
+  }
+
+  versions->clear();
+  for (const auto& response : responses) {
+    versions->emplace_back(response.value);
+  }
+  return true;
+}
+
+bool DistMetaLookuper::LookupMemoryUsage(
+    std::vector<std::string>* reports) const {
+  // prepare
+  std::vector<MetaLookuperRequest> requests(shard_num_);
+  std::vector<MetaLookuperResponse> responses(shard_num_);
+  for (int i = 0; i < shard_num_; ++i) {
+    requests[i].key = MEMORY_USAGE;
+  }
+
+  // rpc
+  auto rpc_type = MetaLookuperRequest::rpc_type();
+  if (WriteRequestReadResponse(conns_, rpc_type, requests, &responses) != 0) {
+    return false;
+  }
+
+  reports->clear();
+  for (const auto& response : responses) {
+    reports->emplace_back(response.value);
+  }
+  return true;
+}
+
 REGISTER_DIST_GS_OP("DistMetaLookuper", DistMetaLookuper);
 
 }  // namespace graph_op
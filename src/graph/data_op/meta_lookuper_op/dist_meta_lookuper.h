@@ -10,6 +10,7 @@
 //
 
 #pragma once
+#include <string>
 #include <vector>
 
 #include "src/common/data_types.h"
@@ -24,6 +25,10 @@ class DistMetaLookuper : public DistGSOp {
 
  public:
   bool Run(std::vector<vec_int_t>* node_freqs_list) const;
+  // the graph version of each shard, see MetaLookuper
+  bool LookupGraphVersion(std::vector<std::string>* versions) const;
+  // the memory usage report of each shard, see MemoryUsage::ToString
+  bool LookupMemoryUsage(std::vector<std::string>* reports) const;
 };
 
 }  // namespace graph_op
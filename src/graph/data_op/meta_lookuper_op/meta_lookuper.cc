@@ -16,6 +16,7 @@
 #include <sstream>  // std::stringstream
 
 #include "src/common/data_types.h"
+#include "src/common/memory_usage.h"
 #include "src/graph/data_op/gs_op_registry.h"
 #include "src/graph/data_op/rpc_key.h"
 
@@ -34,7 +35,9 @@ std::string VecToString(const vec_int_t& vec) {
   return ss.str();
 }
 
+using ::embedx::rpc_key::GRAPH_VERSION;
 using ::embedx::rpc_key::MAX_NODE_PER_RPC;
+using ::embedx::rpc_key::MEMORY_USAGE;
 using ::embedx::rpc_key::NODE_FREQ;
 
 }  // namespace
@@ -46,9 +49,18 @@ bool MetaLookuper::Run(const std::string& key, std::string* value) const {
     *value = VecToString(total_freqs);
   } else if (key == MAX_NODE_PER_RPC) {
     *value = std::to_string(max_node_per_rpc_);
+  } else if (key == GRAPH_VERSION) {
+    // changes with every reload and every delta applied
+    *value = std::to_string(graph_version_) + "." +
+             std::to_string(graph_->delta_num());
+  } else if (key == MEMORY_USAGE) {
+    MemoryUsage usage;
+    resource_->CollectMemory(&usage);
+    *value = usage.ToString();
   } else {
-    DXERROR("Only support key: '%s' || '%s'.", NODE_FREQ.c_str(),
-            MAX_NODE_PER_RPC.c_str());
+    DXERROR("Only support key: '%s' || '%s' || '%s' || '%s'.",
+            NODE_FREQ.c_str(), MAX_NODE_PER_RPC.c_str(), GRAPH_VERSION.c_str(),
+            MEMORY_USAGE.c_str());
     return false;
   }
 
@@ -22,8 +22,10 @@ namespace graph_op {
 
 class MetaLookuper : public LocalGSOp {
  private:
+  const LocalGSOpResource* resource_ = nullptr;
   const InMemoryGraph* graph_ = nullptr;
   int max_node_per_rpc_ = 0;
+  int graph_version_ = 0;
 
  public:
   ~MetaLookuper() override = default;
@@ -35,8 +37,10 @@ class MetaLookuper : public LocalGSOp {
 
  private:
   bool Init(const LocalGSOpResource* resource) override {
+    resource_ = resource;
     graph_ = resource->graph();
     max_node_per_rpc_ = resource->graph_config().max_node_per_rpc();
+    graph_version_ = resource->graph_version();
     return true;
   }
 };
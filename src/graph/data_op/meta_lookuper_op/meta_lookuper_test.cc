@@ -0,0 +1,80 @@
+// Tencent is pleased to support the open source community by making embedx
+// available.
+//
+// Copyright (C) 2021 THL A29 Limited, a Tencent company.  All rights reserved.
+//
+// Licensed under the BSD 3-Clause License and other third-party components,
+// please refer to LICENSE for details.
+//
+
+#include "src/graph/data_op/meta_lookuper_op/meta_lookuper.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>  // std::unique_ptr
+#include <string>
+
+#include "src/graph/data_op/gs_op_factory.h"
+#include "src/graph/data_op/gs_op_resource.h"
+#include "src/graph/data_op/rpc_key.h"
+#include "src/graph/graph_config.h"
+#include "src/graph/graph_delta.h"
+#include "src/graph/in_memory_graph.h"
+
+namespace embedx {
+namespace graph_op {
+
+class MetaLookuperTest : public ::testing::Test {
+ protected:
+  LocalGSOpResource resource_;
+  std::unique_ptr<LocalGSOpFactory> factory_;
+  GraphConfig config_;
+
+ protected:
+  const std::string CONTEXT = "testdata/context";
+  const std::string DELTA = "testdata/delta";
+
+ protected:
+  void SetUp() override {
+    config_.set_node_graph(CONTEXT);
+    resource_.set_graph_config(config_);
+    resource_.set_graph(InMemoryGraph::Create(config_));
+    ASSERT_TRUE(resource_.graph() != nullptr);
+
+    factory_ = LocalGSOpFactory::Create();
+    ASSERT_TRUE(factory_->Init(&resource_));
+  }
+
+  const MetaLookuper* op() {
+    auto* op = factory_->LookupOrCreate("MetaLookuper");
+    return dynamic_cast<MetaLookuper*>(op);
+  }
+};
+
+TEST_F(MetaLookuperTest, GraphVersion) {
+  resource_.set_graph_version(2);
+  std::string value;
+  EXPECT_TRUE(op()->Run(rpc_key::GRAPH_VERSION, &value));
+  EXPECT_EQ(value, "2.0");
+
+  auto delta =
+      GraphDelta::Create(DELTA, config_, resource_.graph()->partitioner());
+  ASSERT_TRUE(delta != nullptr);
+  vec_int_t nodes;
+  EXPECT_TRUE(resource_.mutable_graph()->ApplyDelta(*delta, &nodes));
+  EXPECT_TRUE(op()->Run(rpc_key::GRAPH_VERSION, &value));
+  EXPECT_EQ(value, "2.1");
+
+  EXPECT_FALSE(op()->Run("unknown", &value));
+}
+
+TEST_F(MetaLookuperTest, MemoryUsage) {
+  std::string value;
+  EXPECT_TRUE(op()->Run(rpc_key::MEMORY_USAGE, &value));
+  EXPECT_NE(value.find("context.neighbors: "), std::string::npos);
+  EXPECT_NE(value.find("post_builder.uniq_nodes: "), std::string::npos);
+  EXPECT_NE(value.find("total: "), std::string::npos);
+}
+
+}  // namespace graph_op
+}  // namespace embedx
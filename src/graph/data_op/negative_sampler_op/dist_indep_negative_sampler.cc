@@ -19,7 +19,7 @@ namespace graph_op {
 
 bool DistIndepNegativeSampler::Run(
     int count, const vec_int_t& nodes, const vec_int_t& excluded_nodes,
-    std::vector<vec_int_t>* sampled_nodes_list) const {
+    uint64_t seed, std::vector<vec_int_t>* sampled_nodes_list) const {
   // prepare
   std::vector<int> masks;
   std::vector<std::vector<int>> indices_list(shard_num_);
@@ -30,13 +30,14 @@ bool DistIndepNegativeSampler::Run(
     indices_list[i].clear();
     requests[i].count = count;
     requests[i].excluded_nodes = excluded_nodes;
+    requests[i].seed = seed;
     requests[i].nodes.clear();
   }
 
   // map
   masks.assign(shard_num_, 0);
   for (size_t i = 0; i < nodes.size(); ++i) {
-    int shard_id = ModShard(nodes[i]);
+    int shard_id = GetShard(nodes[i]);
     indices_list[shard_id].emplace_back((int)i);
     requests[shard_id].nodes.emplace_back(nodes[i]);
     masks[shard_id] += 1;
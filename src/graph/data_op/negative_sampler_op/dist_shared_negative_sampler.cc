@@ -13,6 +13,7 @@
 
 #include <unordered_set>
 
+#include "src/common/random.h"
 #include "src/graph/data_op/gs_op_registry.h"
 #include "src/graph/proto/graph_service_proto.h"
 #include "src/io/io_util.h"
@@ -22,19 +23,24 @@ namespace graph_op {
 
 bool DistSharedNegativeSampler::Run(
     int count, const vec_int_t& nodes, const vec_int_t& excluded_nodes,
-    std::vector<vec_int_t>* sampled_nodes_list) const {
+    uint64_t seed, std::vector<vec_int_t>* sampled_nodes_list) const {
   // prepare
   std::vector<int> masks;
   std::vector<SharedNegativeSamplerRequest> requests(shard_num_);
   std::vector<SharedNegativeSamplerResponse> responses(shard_num_);
+  // Shards sample with their own streams, the seeded samples only repeat for
+  // the same number of shards.
+  RandomStreamSeeder seeder(seed);
   for (int i = 0; i < shard_num_; ++i) {  // NOLINT
     requests[i].count = 0;
     requests[i].nodes = nodes;
     requests[i].excluded_nodes = excluded_nodes;
+    requests[i].seed = seeder.Next((uint64_t)i);
   }
 
   // map
   masks.assign(shard_num_, 0);
+  RandomSeedScope scope(seed);
   for (int i = 0; i < count; ++i) {
     int shard_id = resource_->sampling()->Next();
     ++requests[shard_id].count;
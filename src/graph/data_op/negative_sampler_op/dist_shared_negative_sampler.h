@@ -10,6 +10,7 @@
 //
 
 #pragma once
+#include <cstdint>
 #include <vector>
 
 #include "src/common/data_types.h"
@@ -24,7 +25,7 @@ class DistSharedNegativeSampler : public DistGSOp {
 
  public:
   bool Run(int count, const vec_int_t& nodes, const vec_int_t& excluded_nodes,
-           std::vector<vec_int_t>* sampled_nodes_list) const;
+           uint64_t seed, std::vector<vec_int_t>* sampled_nodes_list) const;
 };
 
 }  // namespace graph_op
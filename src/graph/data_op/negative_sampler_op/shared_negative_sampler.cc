@@ -20,8 +20,8 @@ namespace graph_op {
 
 bool SharedNegativeSampler::Run(
     int count, const vec_int_t& nodes, const vec_int_t& excluded_nodes,
-    std::vector<vec_int_t>* sampled_nodes_list) const {
-  if (!negative_sampler_->Sample(count, nodes, excluded_nodes,
+    uint64_t seed, std::vector<vec_int_t>* sampled_nodes_list) const {
+  if (!negative_sampler_->Sample(count, nodes, excluded_nodes, seed,
                                  sampled_nodes_list)) {
     DXERROR("Failed to shared sample node.");
     return false;
@@ -32,7 +32,7 @@ bool SharedNegativeSampler::Run(
 int SharedNegativeSampler::HandleRpc(
     const SharedNegativeSamplerRequest& req,
     SharedNegativeSamplerResponse* resp) const {
-  if (!Run(req.count, req.nodes, req.excluded_nodes,
+  if (!Run(req.count, req.nodes, req.excluded_nodes, req.seed,
            &resp->sampled_nodes_list)) {
     return -1;
   }
@@ -10,6 +10,7 @@
 //
 
 #pragma once
+#include <cstdint>
 #include <memory>  // std::unique_ptr
 #include <vector>
 
@@ -31,7 +32,7 @@ class SharedNegativeSampler : public LocalGSOp {
 
  public:
   bool Run(int count, const vec_int_t& nodes, const vec_int_t& excluded_nodes,
-           std::vector<vec_int_t>* sampled_nodes_list) const;
+           uint64_t seed, std::vector<vec_int_t>* sampled_nodes_list) const;
 
   int HandleRpc(const SharedNegativeSamplerRequest& req,
                 SharedNegativeSamplerResponse* resp) const;
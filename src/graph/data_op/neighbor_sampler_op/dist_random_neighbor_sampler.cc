@@ -18,7 +18,7 @@ namespace embedx {
 namespace graph_op {
 
 bool DistRandomNeighborSampler::Run(
-    int count, const vec_int_t& nodes,
+    int count, const vec_int_t& nodes, uint64_t seed,
     std::vector<vec_int_t>* neighbor_nodes_list) const {
   // prepare
   std::vector<int> masks;
@@ -29,13 +29,14 @@ bool DistRandomNeighborSampler::Run(
   for (int i = 0; i < shard_num_; ++i) {
     indices_list[i].clear();
     requests[i].count = count;
+    requests[i].seed = seed;
     requests[i].nodes.clear();
   }
 
   // map
   masks.assign(shard_num_, 0);
   for (size_t i = 0; i < nodes.size(); ++i) {
-    int shard_id = ModShard(nodes[i]);
+    int shard_id = GetShard(nodes[i]);
     indices_list[shard_id].emplace_back((int)i);
     requests[shard_id].nodes.emplace_back(nodes[i]);
     masks[shard_id] += 1;
@@ -10,6 +10,7 @@
 //
 
 #pragma once
+#include <cstdint>
 #include <vector>
 
 #include "src/common/data_types.h"
@@ -23,7 +24,7 @@ class DistRandomNeighborSampler : public DistGSOp {
   ~DistRandomNeighborSampler() override = default;
 
  public:
-  bool Run(int count, const vec_int_t& nodes,
+  bool Run(int count, const vec_int_t& nodes, uint64_t seed,
            std::vector<vec_int_t>* neighbor_nodes_list) const;
 };
 
@@ -10,6 +10,7 @@
 //
 
 #pragma once
+#include <cstdint>
 #include <memory>  // std::unique_ptr
 #include <vector>
 
@@ -30,7 +31,7 @@ class RandomNeighborSampler : public LocalGSOp {
   ~RandomNeighborSampler() override = default;
 
  public:
-  bool Run(int count, const vec_int_t& nodes,
+  bool Run(int count, const vec_int_t& nodes, uint64_t seed,
            std::vector<vec_int_t>* neighbor_nodes_list) const;
 
   int HandleRpc(const RandomNeighborSamplerRequest& req,
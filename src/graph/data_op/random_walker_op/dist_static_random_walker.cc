@@ -15,6 +15,7 @@
 
 #include <cinttypes>  // PRIu64
 
+#include "src/common/random.h"
 #include "src/graph/data_op/gs_op_registry.h"
 
 namespace embedx {
@@ -33,7 +34,7 @@ bool FinishRpc(const std::vector<int>& continuous_rpcs) {
 
 bool DistStaticRandomWalker::Run(const vec_int_t& cur_nodes,
                                  const std::vector<int>& walk_lens,
-                                 const WalkerInfo& walker_info,
+                                 const WalkerInfo& walker_info, uint64_t seed,
                                  std::vector<vec_int_t>* seqs) {
   // prepare
   seqs->clear();
@@ -42,11 +43,20 @@ bool DistStaticRandomWalker::Run(const vec_int_t& cur_nodes,
     (*seqs)[i].reserve((size_t)walk_lens[i]);
   }
 
+  // A walker keeps its seed from shard to shard.
+  std::vector<uint64_t> seeds;
+  if (seed != 0) {
+    RandomStreamSeeder seeder(seed);
+    for (auto cur_node : cur_nodes) {
+      seeds.emplace_back(seeder.Next(cur_node));
+    }
+  }
+
   std::vector<int> continuous_rpcs(cur_nodes.size(), 1);
   RpcSession rpc_session;
   while (!FinishRpc(continuous_rpcs)) {
-    FillRequest(cur_nodes, walk_lens, walker_info, *seqs, continuous_rpcs,
-                &rpc_session);
+    FillRequest(cur_nodes, walk_lens, walker_info, seeds, *seqs,
+                continuous_rpcs, &rpc_session);
 
     // call rpc.
     auto rpc_type = StaticRandomWalkerRequest::rpc_type();
@@ -66,8 +76,9 @@ bool DistStaticRandomWalker::Run(const vec_int_t& cur_nodes,
 
 void DistStaticRandomWalker::FillRequest(
     const vec_int_t& cur_nodes, const std::vector<int>& walk_lens,
-    const WalkerInfo& walker_info, const std::vector<vec_int_t>& seqs,
-    const std::vector<int>& continuous_rpcs, RpcSession* rpc_session) {
+    const WalkerInfo& walker_info, const std::vector<uint64_t>& seeds,
+    const std::vector<vec_int_t>& seqs, const std::vector<int>& continuous_rpcs,
+    RpcSession* rpc_session) {
   // prepare
   rpc_session->Resize(shard_num_);
   for (int i = 0; i < shard_num_; ++i) {
@@ -75,6 +86,7 @@ void DistStaticRandomWalker::FillRequest(
     rpc_session->indices_list[i].clear();
     rpc_session->requests[i].cur_nodes.clear();
     rpc_session->requests[i].walk_lens.clear();
+    rpc_session->requests[i].seeds.clear();
     rpc_session->requests[i].walker_info.meta_path = walker_info.meta_path;
     rpc_session->requests[i].walker_info.walker_length =
         walker_info.walker_length;
@@ -95,12 +107,15 @@ void DistStaticRandomWalker::FillRequest(
     }
 
     int_t cur_node = cur_seq.empty() ? cur_nodes[i] : cur_seq.back();
-    int shard_id = ModShard(cur_node);
+    int shard_id = GetShard(cur_node);
     rpc_session->masks[shard_id] += 1;
     rpc_session->indices_list[shard_id].emplace_back((int)i);
     rpc_session->requests[shard_id].cur_nodes.emplace_back(cur_node);
     rpc_session->requests[shard_id].walk_lens.emplace_back(walk_lens[i] -
                                                            (int)cur_seq.size());
+    if (!seeds.empty()) {
+      rpc_session->requests[shard_id].seeds.emplace_back(seeds[i]);
+    }
   }
 }
 
@@ -10,6 +10,7 @@
 //
 
 #pragma once
+#include <cstdint>
 #include <vector>
 
 #include "src/common/data_types.h"
@@ -41,12 +42,14 @@ class DistStaticRandomWalker : public DistGSOp {
 
  public:
   bool Run(const vec_int_t& cur_nodes, const std::vector<int>& walk_lens,
-           const WalkerInfo& walker_info, std::vector<vec_int_t>* seqs);
+           const WalkerInfo& walker_info, uint64_t seed,
+           std::vector<vec_int_t>* seqs);
 
  private:
   void FillRequest(const vec_int_t& cur_nodes,
                    const std::vector<int>& walk_lens,
                    const WalkerInfo& walker_info,
+                   const std::vector<uint64_t>& seeds,
                    const std::vector<vec_int_t>& seqs,
                    const std::vector<int>& continuous_rpcs,
                    RpcSession* rpc_session);
@@ -11,6 +11,7 @@
 
 #include "src/graph/data_op/random_walker_op/static_random_walker.h"
 
+#include "src/common/random.h"
 #include "src/graph/data_op/gs_op_registry.h"
 
 namespace embedx {
@@ -18,17 +19,25 @@ namespace graph_op {
 
 bool StaticRandomWalker::Run(const vec_int_t& cur_nodes,
                              const std::vector<int>& walk_lens,
-                             const WalkerInfo& walker_info,
+                             const WalkerInfo& walker_info, uint64_t seed,
                              std::vector<vec_int_t>* seqs) const {
-  random_walker_->Traverse(cur_nodes, walk_lens, walker_info, seqs, nullptr);
+  std::vector<uint64_t> seeds;
+  if (seed != 0) {
+    RandomStreamSeeder seeder(seed);
+    for (auto cur_node : cur_nodes) {
+      seeds.emplace_back(seeder.Next(cur_node));
+    }
+  }
+  random_walker_->Traverse(cur_nodes, walk_lens, walker_info, seeds, seqs,
+                           nullptr);
   return true;
 }
 
 int StaticRandomWalker::HandleRpc(const StaticRandomWalkerRequest& req,
                                   StaticRandomWalkerResponse* resp) const {
-  if (!Run(req.cur_nodes, req.walk_lens, req.walker_info, &resp->seqs)) {
-    return -1;
-  }
+  // The walkers are seeded by the client, a walk may span several requests.
+  random_walker_->Traverse(req.cur_nodes, req.walk_lens, req.walker_info,
+                           req.seeds, &resp->seqs, nullptr);
   return 0;
 }
 
@@ -10,6 +10,7 @@
 //
 
 #pragma once
+#include <cstdint>
 #include <memory>  // std::unique_ptr
 #include <vector>
 
@@ -32,7 +33,8 @@ class StaticRandomWalker : public LocalGSOp {
 
  public:
   bool Run(const vec_int_t& cur_nodes, const std::vector<int>& walk_lens,
-           const WalkerInfo&, std::vector<vec_int_t>* seqs) const;
+           const WalkerInfo&, uint64_t seed,
+           std::vector<vec_int_t>* seqs) const;
   int HandleRpc(const StaticRandomWalkerRequest& req,
                 StaticRandomWalkerResponse* resp) const;
 
@@ -17,6 +17,8 @@ namespace rpc_key {
 
 const std::string NODE_FREQ = "__RPC_NAME_NODE_FREQ__";                // NOLINT
 const std::string MAX_NODE_PER_RPC = "__RPC_NAME_MAX_NODE_PER_RPC__";  // NOLINT
+const std::string GRAPH_VERSION = "__RPC_NAME_GRAPH_VERSION__";        // NOLINT
+const std::string MEMORY_USAGE = "__RPC_NAME_MEMORY_USAGE__";          // NOLINT
 
 }  // namespace rpc_key
 }  // namespace embedx
@@ -13,12 +13,33 @@
 
 #include <deepx_core/dx_log.h>
 
+#include "src/io/storage/adjacency.h"
+
 namespace embedx {
 
-void GraphBuilder::InitLoader(int shard_num, int shard_id, int store_type) {
-  context_loader_ = NewContextLoader(shard_num, shard_id, store_type);
-  node_feat_loader_ = NewFeatureLoader(shard_num, shard_id, store_type);
-  neigh_feat_loader_ = NewFeatureLoader(shard_num, shard_id, store_type);
+void GraphBuilder::InitLoader(int shard_num, int shard_id, int store_type,
+                              int node_feature_store_type,
+                              int neigh_feature_store_type,
+                              int partition_num) {
+  context_loader_ =
+      NewContextLoader(shard_num, shard_id, store_type, partition_num);
+  node_feat_loader_ = NewFeatureLoader(shard_num, shard_id,
+                                       node_feature_store_type, partition_num);
+  neigh_feat_loader_ = NewFeatureLoader(
+      shard_num, shard_id, neigh_feature_store_type, partition_num);
+}
+
+bool GraphBuilder::InitPartitioner(const GraphConfig& config) {
+  partitioner_ = NewShardPartitioner(
+      config.partitioner_type(), config.shard_num(), config.partition_file());
+  if (!partitioner_) {
+    return false;
+  }
+
+  context_loader_->set_partitioner(partitioner_);
+  node_feat_loader_->set_partitioner(partitioner_);
+  neigh_feat_loader_->set_partitioner(partitioner_);
+  return true;
 }
 
 /************************************************************************/
@@ -38,6 +59,7 @@ bool GraphBuilder::BuildContext(const std::string& context, int thread_num) {
     DXERROR("Failed to load context files.");
     return false;
   }
+  context_loader_->Freeze();
 
   DXINFO("Done.");
   return true;
@@ -54,6 +76,7 @@ bool GraphBuilder::BuildNodeFeature(const std::string& node_feature,
       DXERROR("Failed to load node feature.");
       return false;
     }
+    node_feat_loader_->Freeze();
   }
 
   return true;
@@ -68,21 +91,48 @@ bool GraphBuilder::BuildNeighborFeature(const std::string& neighbor_feature,
       DXERROR("Failed to load neighbor feature.");
       return false;
     }
+    neigh_feat_loader_->Freeze();
   }
 
   DXINFO("Done.");
   return true;
 }
 
+/************************************************************************/
+/* Snapshot */
+/************************************************************************/
+bool GraphBuilder::Attach(SnapshotReader* reader) {
+  DXINFO("Attaching graph storages to snapshot...");
+
+  if (!context_loader_->Attach(reader) || !node_feat_loader_->Attach(reader) ||
+      !neigh_feat_loader_->Attach(reader)) {
+    DXERROR("Failed to attach graph storages.");
+    return false;
+  }
+
+  DXINFO("Done.");
+  return true;
+}
+
+bool GraphBuilder::Dump(SnapshotWriter* writer) const {
+  return context_storage()->Dump(writer) &&
+         node_feature_storage()->Dump(writer) &&
+         neigh_feature_storage()->Dump(writer);
+}
+
 std::unique_ptr<GraphBuilder> GraphBuilder::Create(const GraphConfig& config) {
   std::unique_ptr<GraphBuilder> builder;
   builder.reset(new GraphBuilder());
 
   builder->set_estimated_size(config.estimated_size());
   builder->InitLoader(config.shard_num(), config.shard_id(),
-                      config.store_type());
+                      config.store_type(), config.feature_store_type(),
+                      config.neighbor_feature_store_type(),
+                      config.store_partition_num());
+  builder->context_loader_->set_build_in_degree(config.build_in_degree());
 
-  if (!builder->BuildContext(config.node_graph(), config.thread_num()) ||
+  if (!builder->InitPartitioner(config) ||
+      !builder->BuildContext(config.node_graph(), config.thread_num()) ||
       !builder->BuildNodeFeature(config.node_feature(), config.thread_num()) ||
       !builder->BuildNeighborFeature(config.neighbor_feature(),
                                      config.thread_num())) {
@@ -93,4 +143,27 @@ std::unique_ptr<GraphBuilder> GraphBuilder::Create(const GraphConfig& config) {
   return builder;
 }
 
+std::unique_ptr<GraphBuilder> GraphBuilder::Create(const GraphConfig& config,
+                                                   SnapshotReader* reader) {
+  std::unique_ptr<GraphBuilder> builder;
+  builder.reset(new GraphBuilder());
+
+  // Dump writes every storage in csr layout, only csr attaches to it.
+  const int csr = (int)AdjacencyEnum::ADJ_CSR;
+  if (config.store_type() != csr || config.feature_store_type() != csr ||
+      config.neighbor_feature_store_type() != csr) {
+    DXINFO("Snapshot storages are csr, ignoring store types: %d, %d, %d.",
+           config.store_type(), config.feature_store_type(),
+           config.neighbor_feature_store_type());
+  }
+  builder->InitLoader(config.shard_num(), config.shard_id(), csr, csr, csr);
+
+  if (!builder->InitPartitioner(config) || !builder->Attach(reader)) {
+    DXERROR("Failed to create graph builder.");
+    builder.reset();
+  }
+
+  return builder;
+}
+
 }  // namespace embedx
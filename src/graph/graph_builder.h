@@ -10,12 +10,14 @@
 //
 
 #pragma once
-#include <memory>  // std::unique_ptr
+#include <memory>  // std::shared_ptr, std::unique_ptr
 #include <string>
 
 #include "src/common/data_types.h"
 #include "src/graph/graph_config.h"
 #include "src/io/loader/loader.h"
+#include "src/io/shard_partitioner.h"
+#include "src/io/snapshot.h"
 #include "src/io/storage/storage.h"
 
 namespace embedx {
@@ -26,9 +28,16 @@ class GraphBuilder {
   std::unique_ptr<Loader> context_loader_;
   std::unique_ptr<Loader> node_feat_loader_;
   std::unique_ptr<Loader> neigh_feat_loader_;
+  std::shared_ptr<const ShardPartitioner> partitioner_;
 
  public:
   static std::unique_ptr<GraphBuilder> Create(const GraphConfig& config);
+  // Storages read from a snapshot are always csr adjacency.
+  static std::unique_ptr<GraphBuilder> Create(const GraphConfig& config,
+                                              SnapshotReader* reader);
+
+ public:
+  bool Dump(SnapshotWriter* writer) const;
 
  public:
   const Storage* context_storage() const noexcept {
@@ -40,14 +49,22 @@ class GraphBuilder {
   const Storage* neigh_feature_storage() const noexcept {
     return neigh_feat_loader_->storage();
   }
+  // the partitioner the nodes of this shard were selected with
+  const std::shared_ptr<const ShardPartitioner>& partitioner() const noexcept {
+    return partitioner_;
+  }
 
  private:
   void set_estimated_size(uint64_t size) noexcept { estimated_size_ = size; }
-  void InitLoader(int shard_num, int shard_id, int store_type);
+  void InitLoader(int shard_num, int shard_id, int store_type,
+                  int node_feature_store_type, int neigh_feature_store_type,
+                  int partition_num = 1);
+  bool InitPartitioner(const GraphConfig& config);
   bool BuildContext(const std::string& context, int thread_num);
   bool BuildNodeFeature(const std::string& node_feature, int thread_num);
   bool BuildNeighborFeature(const std::string& neighbor_feature,
                             int thread_num);
+  bool Attach(SnapshotReader* reader);
 
  private:
   GraphBuilder() = default;
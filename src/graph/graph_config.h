@@ -26,6 +26,10 @@ class GraphConfig {
   std::string node_feat_;
   std::string neigh_feat_;
   int store_type_ = 0;
+  // -1 for store_type
+  int feature_store_type_ = -1;
+  // -1 for feature_store_type
+  int neigh_feature_store_type_ = -1;
 
   int negative_sampler_type_ = 0;
   int neighbor_sampler_type_ = 0;
@@ -33,15 +37,32 @@ class GraphConfig {
 
   int shard_num_ = 1;
   int shard_id_ = 0;
+  // see PartitionerEnum, servers and clients must agree on them
+  int partitioner_type_ = 0;
+  std::string partition_file_;
 
   int thread_num_ = 1;
   std::string ip_ports_;
+  // > 1 lets loader threads insert into hash partitioned storages without a
+  // global lock.
+  int store_partition_num_ = 1;
+  // false skips counting in-degrees after loading, GetInDegree then returns 0
+  bool build_in_degree_ = true;
 
   int cache_type_ = 0;
   double cache_thld_ = 0.0;
   int max_node_per_rpc_ = 2000;
 
   std::string success_out_;
+  // true prints the memory usage of the graph once it is built
+  bool print_memory_ = false;
+
+  std::string dump_snapshot_;
+  std::string load_snapshot_;
+
+  std::string delta_dir_;
+  std::string reload_dir_;
+  int watch_interval_ = 60;
 
  public:
   // data
@@ -50,6 +71,13 @@ class GraphConfig {
   const std::string& node_feature() const noexcept { return node_feat_; }
   const std::string& neighbor_feature() const noexcept { return neigh_feat_; }
   int store_type() const noexcept { return store_type_; }
+  int feature_store_type() const noexcept {
+    return feature_store_type_ < 0 ? store_type_ : feature_store_type_;
+  }
+  int neighbor_feature_store_type() const noexcept {
+    return neigh_feature_store_type_ < 0 ? feature_store_type()
+                                         : neigh_feature_store_type_;
+  }
 
   // sampler type
   int negative_sampler_type() const noexcept { return negative_sampler_type_; }
@@ -59,11 +87,17 @@ class GraphConfig {
   // dist
   int shard_num() const noexcept { return shard_num_; }
   int shard_id() const noexcept { return shard_id_; }
+  int partitioner_type() const noexcept { return partitioner_type_; }
+  const std::string& partition_file() const noexcept {
+    return partition_file_;
+  }
 
   // performance
   int thread_num() const noexcept { return thread_num_; }
   const std::string& ip_ports() const noexcept { return ip_ports_; }
   uint64_t estimated_size() const noexcept { return ESTIMATED_SIZE; }
+  int store_partition_num() const noexcept { return store_partition_num_; }
+  bool build_in_degree() const noexcept { return build_in_degree_; }
 
   // cache
   int cache_type() const noexcept { return cache_type_; }
@@ -72,6 +106,16 @@ class GraphConfig {
 
   // output
   const std::string& success_out() const noexcept { return success_out_; }
+  bool print_memory() const noexcept { return print_memory_; }
+
+  // snapshot
+  const std::string& dump_snapshot() const noexcept { return dump_snapshot_; }
+  const std::string& load_snapshot() const noexcept { return load_snapshot_; }
+
+  // delta and reload
+  const std::string& delta_dir() const noexcept { return delta_dir_; }
+  const std::string& reload_dir() const noexcept { return reload_dir_; }
+  int watch_interval() const noexcept { return watch_interval_; }
 
  public:
   // data
@@ -84,6 +128,12 @@ class GraphConfig {
     neigh_feat_ = path;
   }
   void set_store_type(int store_type) noexcept { store_type_ = store_type; }
+  void set_feature_store_type(int store_type) noexcept {
+    feature_store_type_ = store_type;
+  }
+  void set_neighbor_feature_store_type(int store_type) noexcept {
+    neigh_feature_store_type_ = store_type;
+  }
 
   // sampler type
   void set_negative_sampler_type(int type) noexcept {
@@ -97,12 +147,22 @@ class GraphConfig {
   // dist
   void set_shard_num(int shard_num) noexcept { shard_num_ = shard_num; }
   void set_shard_id(int shard_id) noexcept { shard_id_ = shard_id; }
+  void set_partitioner_type(int type) noexcept { partitioner_type_ = type; }
+  void set_partition_file(const std::string& file) noexcept {
+    partition_file_ = file;
+  }
 
   // performance
   void set_thread_num(int thread_num) noexcept { thread_num_ = thread_num; }
   void set_ip_ports(const std::string& ip_ports) noexcept {
     ip_ports_ = ip_ports;
   }
+  void set_store_partition_num(int partition_num) noexcept {
+    store_partition_num_ = partition_num;
+  }
+  void set_build_in_degree(bool build_in_degree) noexcept {
+    build_in_degree_ = build_in_degree;
+  }
 
   // cache
   void set_cache_type(int cache_type) noexcept { cache_type_ = cache_type; }
@@ -115,6 +175,22 @@ class GraphConfig {
   void set_success_out(const std::string& success_out) noexcept {
     success_out_ = success_out;
   }
+  void set_print_memory(bool print_memory) noexcept {
+    print_memory_ = print_memory;
+  }
+
+  // snapshot
+  void set_dump_snapshot(const std::string& file) noexcept {
+    dump_snapshot_ = file;
+  }
+  void set_load_snapshot(const std::string& file) noexcept {
+    load_snapshot_ = file;
+  }
+
+  // delta and reload
+  void set_delta_dir(const std::string& dir) noexcept { delta_dir_ = dir; }
+  void set_reload_dir(const std::string& dir) noexcept { reload_dir_ = dir; }
+  void set_watch_interval(int seconds) noexcept { watch_interval_ = seconds; }
 };
 
 }  // namespace embedx
@@ -0,0 +1,130 @@
+// Tencent is pleased to support the open source community by making embedx
+// available.
+//
+// Copyright (C) 2021 THL A29 Limited, a Tencent company.  All rights reserved.
+//
+// Licensed under the BSD 3-Clause License and other third-party components,
+// please refer to LICENSE for details.
+//
+
+#include "src/graph/graph_delta.h"
+
+#include <deepx_core/common/stream.h>
+#include <deepx_core/dx_log.h>
+
+#include <algorithm>  // std::sort, std::stable_sort
+
+#include "src/io/io_util.h"
+#include "src/io/storage/adjacency.h"
+
+namespace embedx {
+namespace {
+
+// the order of AdjacencyImpl::SortByNode
+bool NodeLess(const pair_t& a, const pair_t& b) {
+  uint16_t type_a = io_util::GetNodeType(a.first);
+  uint16_t type_b = io_util::GetNodeType(b.first);
+  if (type_a == type_b) {
+    return a.first < b.first;
+  } else {
+    return type_a < type_b;
+  }
+}
+
+bool Contains(const vec_int_t& sorted_nodes, int_t node) {
+  return std::binary_search(sorted_nodes.begin(), sorted_nodes.end(), node);
+}
+
+}  // namespace
+
+void GraphDelta::InitLoader(
+    int shard_num, int shard_id,
+    const std::shared_ptr<const ShardPartitioner>& partitioner) {
+  int store_type = (int)AdjacencyEnum::ADJ_LIST;
+  add_context_loader_ = NewContextLoader(shard_num, shard_id, store_type);
+  remove_context_loader_ = NewContextLoader(shard_num, shard_id, store_type);
+  // InMemoryGraph keeps the in-degrees of the graph as built.
+  add_context_loader_->set_build_in_degree(false);
+  remove_context_loader_->set_build_in_degree(false);
+  node_feat_loader_ = NewFeatureLoader(shard_num, shard_id, store_type);
+  neigh_feat_loader_ = NewFeatureLoader(shard_num, shard_id, store_type);
+
+  add_context_loader_->set_partitioner(partitioner);
+  remove_context_loader_->set_partitioner(partitioner);
+  node_feat_loader_->set_partitioner(partitioner);
+  neigh_feat_loader_->set_partitioner(partitioner);
+}
+
+bool GraphDelta::Load(const std::string& path, int thread_num,
+                      Loader* loader) {
+  if (!deepx_core::AutoFileSystem::Exists(path)) {
+    return true;
+  }
+
+  DXINFO("Loading delta files: %s...", path.c_str());
+  loader->Clear();
+  if (!loader->Load(path, thread_num)) {
+    DXERROR("Failed to load delta files: %s.", path.c_str());
+    return false;
+  }
+  loader->Freeze();
+  return true;
+}
+
+void MergeContext(pair_view_t context, pair_view_t added, pair_view_t removed,
+                  vec_pair_t* merged) {
+  // Added edges replace the existing ones.
+  vec_int_t skipped_nodes;
+  for (const auto& entry : added) {
+    skipped_nodes.emplace_back(entry.first);
+  }
+  for (const auto& entry : removed) {
+    skipped_nodes.emplace_back(entry.first);
+  }
+  std::sort(skipped_nodes.begin(), skipped_nodes.end());
+
+  merged->clear();
+  for (const auto& entry : context) {
+    if (!Contains(skipped_nodes, entry.first)) {
+      merged->emplace_back(entry);
+    }
+  }
+
+  vec_int_t removed_nodes;
+  for (const auto& entry : removed) {
+    removed_nodes.emplace_back(entry.first);
+  }
+  std::sort(removed_nodes.begin(), removed_nodes.end());
+  for (const auto& entry : added) {
+    if (!Contains(removed_nodes, entry.first)) {
+      merged->emplace_back(entry);
+    }
+  }
+
+  std::stable_sort(merged->begin(), merged->end(), NodeLess);
+}
+
+std::unique_ptr<GraphDelta> GraphDelta::Create(
+    const std::string& dir, const GraphConfig& config,
+    std::shared_ptr<const ShardPartitioner> partitioner) {
+  std::unique_ptr<GraphDelta> delta;
+  delta.reset(new GraphDelta());
+
+  delta->InitLoader(config.shard_num(), config.shard_id(), partitioner);
+
+  int thread_num = config.thread_num();
+  if (!Load(dir + "/add_graph", thread_num, delta->add_context_loader_.get()) ||
+      !Load(dir + "/remove_graph", thread_num,
+            delta->remove_context_loader_.get()) ||
+      !Load(dir + "/node_feature", thread_num,
+            delta->node_feat_loader_.get()) ||
+      !Load(dir + "/neighbor_feature", thread_num,
+            delta->neigh_feat_loader_.get())) {
+    DXERROR("Failed to create graph delta: %s.", dir.c_str());
+    delta.reset();
+  }
+
+  return delta;
+}
+
+}  // namespace embedx
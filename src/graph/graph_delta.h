@@ -0,0 +1,78 @@
+// Tencent is pleased to support the open source community by making embedx
+// available.
+//
+// Copyright (C) 2021 THL A29 Limited, a Tencent company.  All rights reserved.
+//
+// Licensed under the BSD 3-Clause License and other third-party components,
+// please refer to LICENSE for details.
+//
+
+#pragma once
+#include <memory>  // std::shared_ptr, std::unique_ptr
+#include <string>
+
+#include "src/common/data_types.h"
+#include "src/common/layered_map.h"
+#include "src/graph/graph_config.h"
+#include "src/io/loader/loader.h"
+#include "src/io/shard_partitioner.h"
+#include "src/io/storage/storage.h"
+
+namespace embedx {
+
+// Changes to a built graph, read from a delta directory with the optional
+// sub directories, all in the format of the graph files:
+//   add_graph: edges to add, the weights of existing edges are replaced.
+//   remove_graph: edges to remove, the weights are ignored.
+//   node_feature, neighbor_feature: features replacing those of the nodes.
+class GraphDelta {
+ private:
+  std::unique_ptr<Loader> add_context_loader_;
+  std::unique_ptr<Loader> remove_context_loader_;
+  std::unique_ptr<Loader> node_feat_loader_;
+  std::unique_ptr<Loader> neigh_feat_loader_;
+
+ public:
+  // Keeps the nodes 'partitioner' puts in the shard of 'config'.
+  static std::unique_ptr<GraphDelta> Create(
+      const std::string& dir, const GraphConfig& config,
+      std::shared_ptr<const ShardPartitioner> partitioner);
+
+ public:
+  const Storage* add_context_storage() const noexcept {
+    return add_context_loader_->storage();
+  }
+  const Storage* remove_context_storage() const noexcept {
+    return remove_context_loader_->storage();
+  }
+  const Storage* node_feature_storage() const noexcept {
+    return node_feat_loader_->storage();
+  }
+  const Storage* neigh_feature_storage() const noexcept {
+    return neigh_feat_loader_->storage();
+  }
+
+ private:
+  void InitLoader(int shard_num, int shard_id,
+                  const std::shared_ptr<const ShardPartitioner>& partitioner);
+  static bool Load(const std::string& path, int thread_num, Loader* loader);
+
+ private:
+  GraphDelta() = default;
+};
+
+// Lists of a node replaced by deltas, nullptr if unchanged.
+struct DeltaLists {
+  std::shared_ptr<const vec_pair_t> context;
+  std::shared_ptr<const vec_pair_t> node_feature;
+  std::shared_ptr<const vec_pair_t> neigh_feature;
+};
+
+// Grows with the nodes ever changed, until a reload replaces the graph.
+using delta_map_t = LayeredMap<int_t, DeltaLists>;
+
+// Applies the edges 'added' to and 'removed' from a node to its 'context'.
+void MergeContext(pair_view_t context, pair_view_t added, pair_view_t removed,
+                  vec_pair_t* merged);
+
+}  // namespace embedx
@@ -13,6 +13,11 @@
 
 #include <deepx_core/dx_log.h>
 
+#include <cinttypes>  // PRIu64
+#include <utility>    // std::move
+
+#include "src/io/io_util.h"
+
 namespace embedx {
 
 /************************************************************************/
@@ -36,9 +41,126 @@ bool InMemoryGraph::Build(const GraphConfig& config) {
     return false;
   }
 
-  PrintGraphTopo();
+  BuildFeatureRows();
+  PrintGraphTopo(config);
+
+  DXINFO("Done.");
+  return true;
+}
+
+bool InMemoryGraph::Load(const GraphConfig& config, SnapshotReader* reader) {
+  DXINFO("Load in memory graph from snapshot...");
+
+  graph_builder_ = GraphBuilder::Create(config, reader);
+  if (!graph_builder_) {
+    return false;
+  }
+
+  post_builder_ = PostBuilder::Create(reader);
+  if (!post_builder_) {
+    return false;
+  }
+
+  if (!CheckSizeValid()) {
+    return false;
+  }
+
+  BuildFeatureRows();
+  PrintGraphTopo(config);
+
+  DXINFO("Done.");
+  return true;
+}
+
+bool InMemoryGraph::Dump(SnapshotWriter* writer) const {
+  return graph_builder_->Dump(writer) && post_builder_->Dump(writer);
+}
+
+bool InMemoryGraph::ApplyDelta(const GraphDelta& delta, vec_int_t* nodes) {
+  std::vector<pair_view_t> contexts;
+  auto delta_map = PrepareDelta(delta, nodes, &contexts);
+  if (!delta_map) {
+    return false;
+  }
+  PublishDelta(std::move(delta_map));
+  return true;
+}
+
+std::shared_ptr<const delta_map_t> InMemoryGraph::PrepareDelta(
+    const GraphDelta& delta, vec_int_t* nodes,
+    std::vector<pair_view_t>* contexts) const {
+  DXINFO("Preparing graph delta...");
+
+  auto delta_map = delta_map_.load();
+  // Only the changed lists are copied, the others are shared.
+  std::shared_ptr<delta_map_t> next_delta_map(
+      delta_map ? new delta_map_t(*delta_map) : new delta_map_t);
+
+  const auto* add_storage = delta.add_context_storage();
+  const auto* remove_storage = delta.remove_context_storage();
+  size_t begin = nodes->size();
+  nodes->insert(nodes->end(), add_storage->Keys().begin(),
+                add_storage->Keys().end());
+  for (auto node : remove_storage->Keys()) {
+    if (add_storage->FindNeighbor(node).empty()) {
+      nodes->emplace_back(node);
+    }
+  }
+  for (size_t i = begin; i < nodes->size(); ++i) {
+    int_t node = (*nodes)[i];
+    auto added = add_storage->FindNeighbor(node);
+    if (!CheckNamespace(node)) {
+      return nullptr;
+    }
+    for (const auto& entry : added) {
+      if (!CheckNamespace(entry.first)) {
+        return nullptr;
+      }
+    }
+
+    auto context = std::make_shared<vec_pair_t>();
+    MergeContext(FindContext(node), added, remove_storage->FindNeighbor(node),
+                 context.get());
+    (*next_delta_map)[node].context = std::move(context);
+  }
+  for (size_t i = begin; i < nodes->size(); ++i) {
+    contexts->emplace_back(*next_delta_map->Find((*nodes)[i])->context);
+  }
+
+  for (auto node : delta.node_feature_storage()->Keys()) {
+    auto feature = delta.node_feature_storage()->FindNeighbor(node);
+    (*next_delta_map)[node].node_feature =
+        std::make_shared<vec_pair_t>(feature.begin(), feature.end());
+  }
+  for (auto node : delta.neigh_feature_storage()->Keys()) {
+    auto feature = delta.neigh_feature_storage()->FindNeighbor(node);
+    (*next_delta_map)[node].neigh_feature =
+        std::make_shared<vec_pair_t>(feature.begin(), feature.end());
+  }
 
+  DXINFO("Changed contexts: %zu, node features: %zu, neighbor features: %zu.",
+         nodes->size() - begin, delta.node_feature_storage()->Size(),
+         delta.neigh_feature_storage()->Size());
+  next_delta_map->Compact(nodes->size() - begin +
+                          delta.node_feature_storage()->Size() +
+                          delta.neigh_feature_storage()->Size());
   DXINFO("Done.");
+  return next_delta_map;
+}
+
+void InMemoryGraph::PublishDelta(std::shared_ptr<const delta_map_t> delta_map) {
+  delta_map_.Publish(std::move(delta_map));
+  ++delta_num_;
+}
+
+bool InMemoryGraph::CheckNamespace(int_t node) const {
+  uint16_t ns_id = io_util::GetNodeType(node);
+  if (id_name_map().find(ns_id) == id_name_map().end()) {
+    DXERROR("Couldn't find node: %" PRIu64
+            " namespace id: %d in the config file.",
+            node, (int)ns_id);
+    return false;
+  }
   return true;
 }
 
@@ -68,7 +190,66 @@ bool InMemoryGraph::CheckSizeValid() const {
   return true;
 }
 
-void InMemoryGraph::PrintGraphTopo() const {
+void InMemoryGraph::BuildFeatureRows() {
+  // Translates the context rows to feature rows once, so that lookups by
+  // dense id hash a node only once.
+  auto build = [this](const Storage* storage, std::vector<int>* feat_rows) {
+    feat_rows->clear();
+    if (storage->Empty()) {
+      return;
+    }
+
+    feat_rows->assign(node_size(), -1);
+    for (auto node : node_keys()) {
+      int row = 0;
+      int feat_row = 0;
+      if (LookupRow(node, &row) && storage->LookupRow(node, &feat_row)) {
+        (*feat_rows)[row] = feat_row;
+      }
+    }
+  };
+
+  build(graph_builder_->node_feature_storage(), &node_feat_rows_);
+  build(graph_builder_->neigh_feature_storage(), &neigh_feat_rows_);
+}
+
+void InMemoryGraph::CollectMemory(MemoryUsage* usage) const {
+  MemoryUsage storage_usage;
+  graph_builder_->context_storage()->CollectMemory(&storage_usage);
+  usage->Merge("context", storage_usage);
+  storage_usage.Clear();
+  graph_builder_->node_feature_storage()->CollectMemory(&storage_usage);
+  usage->Merge("node_feature", storage_usage);
+  storage_usage.Clear();
+  graph_builder_->neigh_feature_storage()->CollectMemory(&storage_usage);
+  usage->Merge("neighbor_feature", storage_usage);
+
+  usage->Add("feature_rows",
+             VectorBytes(node_feat_rows_) + VectorBytes(neigh_feat_rows_),
+             node_feat_rows_.size() + neigh_feat_rows_.size());
+
+  MemoryUsage post_usage;
+  post_builder_->CollectMemory(&post_usage);
+  usage->Merge("post_builder", post_usage);
+
+  // Lists shared by consecutive delta maps are counted once per map.
+  const auto* delta_map = delta_map_.get();
+  if (delta_map) {
+    uint64_t bytes = MapBytes(*delta_map);
+    delta_map->ForEach([&bytes](int_t /*node*/, const DeltaLists& lists) {
+      for (const auto* list :
+           {lists.context.get(), lists.node_feature.get(),
+            lists.neigh_feature.get()}) {
+        if (list) {
+          bytes += sizeof(vec_pair_t) + VectorBytes(*list);
+        }
+      }
+    });
+    usage->Add("delta", bytes, delta_map->size());
+  }
+}
+
+void InMemoryGraph::PrintGraphTopo(const GraphConfig& config) const {
   for (const auto& entry : id_name_map()) {
     auto ns_id = entry.first;
     auto ns_name = entry.second;
@@ -79,6 +260,12 @@ void InMemoryGraph::PrintGraphTopo() const {
     DXINFO("Frequency of namespace: %s nodes are: %d.", ns_name.c_str(),
            (int)freq);
   }
+
+  if (config.print_memory()) {
+    MemoryUsage usage;
+    CollectMemory(&usage);
+    DXINFO("Memory usage of graph:\n%s", usage.ToString().c_str());
+  }
 }
 
 std::unique_ptr<InMemoryGraph> InMemoryGraph::Create(
@@ -94,4 +281,17 @@ std::unique_ptr<InMemoryGraph> InMemoryGraph::Create(
   return graph;
 }
 
+std::unique_ptr<InMemoryGraph> InMemoryGraph::Create(const GraphConfig& config,
+                                                     SnapshotReader* reader) {
+  std::unique_ptr<InMemoryGraph> graph;
+  graph.reset(new InMemoryGraph());
+
+  if (!graph->Load(config, reader)) {
+    DXERROR("Failed to create in memory graph.");
+    graph.reset();
+  }
+
+  return graph;
+}
+
 }  // namespace embedx
@@ -10,13 +10,18 @@
 //
 
 #pragma once
-#include <memory>  // std::unique_ptr
+#include <atomic>
+#include <memory>  // std::shared_ptr, std::unique_ptr
 #include <vector>
 
 #include "src/common/data_types.h"
+#include "src/common/memory_usage.h"
+#include "src/common/published_ptr.h"
 #include "src/graph/graph_builder.h"
 #include "src/graph/graph_config.h"
+#include "src/graph/graph_delta.h"
 #include "src/graph/post_builder.h"
+#include "src/io/snapshot.h"
 
 namespace embedx {
 
@@ -24,9 +29,52 @@ class InMemoryGraph {
  private:
   std::unique_ptr<GraphBuilder> graph_builder_;
   std::unique_ptr<PostBuilder> post_builder_;
+  // feature row of each context row, -1 if the node has no feature
+  std::vector<int> node_feat_rows_;
+  std::vector<int> neigh_feat_rows_;
+  // lists changed by ApplyDelta, copied on write
+  PublishedPtr<delta_map_t> delta_map_;
+  std::atomic<int> delta_num_{0};
 
  public:
   static std::unique_ptr<InMemoryGraph> Create(const GraphConfig& config);
+  static std::unique_ptr<InMemoryGraph> Create(const GraphConfig& config,
+                                               SnapshotReader* reader);
+
+ public:
+  bool Dump(SnapshotWriter* writer) const;
+
+  // Replaces the lists changed by 'delta' atomically, the nodes with a changed
+  // context are added to 'nodes'. Deltas are applied by one thread at a time.
+  //
+  // Replaced lists are freed once no PublishedPins hold them, readers running
+  // beside ApplyDelta pin them with PinDelta.
+  //
+  // Node keys, in-degrees and the topology, with the negative sampler tables
+  // built from it, are those of the graph as built. Nodes only added by
+  // deltas can be found by id but are never drawn as negatives. The changed
+  // lists are kept beside the graph until a reload builds a new one.
+  bool ApplyDelta(const GraphDelta& delta, vec_int_t* nodes);
+  // ApplyDelta in two steps, so that tables built from the changed contexts
+  // can be published with them. PrepareDelta returns the lists to publish,
+  // nullptr on failure, and adds the new contexts of 'nodes' to 'contexts'.
+  // They stay valid while the returned lists live.
+  std::shared_ptr<const delta_map_t> PrepareDelta(
+      const GraphDelta& delta, vec_int_t* nodes,
+      std::vector<pair_view_t>* contexts) const;
+  void PublishDelta(std::shared_ptr<const delta_map_t> delta_map);
+  // Keeps the lists of the deltas applied so far for the reads of the calling
+  // thread.
+  void PinDelta(PublishedPins* pins) const { pins->Add(delta_map_); }
+  // number of deltas applied
+  int delta_num() const noexcept { return delta_num_.load(); }
+  // Adds the bytes of the storages, named like "context.neighbors", and of
+  // the tables built from them.
+  void CollectMemory(MemoryUsage* usage) const;
+  // deltas must be loaded with it
+  const std::shared_ptr<const ShardPartitioner>& partitioner() const noexcept {
+    return graph_builder_->partitioner();
+  }
 
  public:
   int ns_size() const noexcept { return post_builder_->ns_size(); }
@@ -49,6 +97,10 @@ class InMemoryGraph {
     return graph_builder_->context_storage()->GetInDegree(dst_node);
   }
   int GetOutDegree(int_t src_node) const {
+    const auto* lists = FindDelta(src_node);
+    if (lists && lists->context) {
+      return (int)lists->context->size();
+    }
     return graph_builder_->context_storage()->GetOutDegree(src_node);
   }
 
@@ -64,16 +116,52 @@ class InMemoryGraph {
   }
 
   // find
-  const vec_pair_t* FindContext(int_t node) const {
+  pair_view_t FindContext(int_t node) const {
+    const auto* lists = FindDelta(node);
+    if (lists && lists->context) {
+      return *lists->context;
+    }
     return graph_builder_->context_storage()->FindNeighbor(node);
   }
-  const vec_pair_t* FindNodeFeature(int_t node) const {
+  pair_view_t FindNodeFeature(int_t node) const {
+    const auto* lists = FindDelta(node);
+    if (lists && lists->node_feature) {
+      return *lists->node_feature;
+    }
     return graph_builder_->node_feature_storage()->FindNeighbor(node);
   }
-  const vec_pair_t* FindNeighFeature(int_t node) const {
+  pair_view_t FindNeighFeature(int_t node) const {
+    const auto* lists = FindDelta(node);
+    if (lists && lists->neigh_feature) {
+      return *lists->neigh_feature;
+    }
     return graph_builder_->neigh_feature_storage()->FindNeighbor(node);
   }
 
+  // find by dense id, the context row of a node
+  //
+  // Rows address the graph as built, nodes changed by deltas have no row and
+  // are found by id.
+  bool LookupRow(int_t node, int* row) const {
+    return FindDelta(node) == nullptr && LookupBaseRow(node, row);
+  }
+  // Like LookupRow, but ignores deltas. For tables built from the graph as
+  // built, e.g. sampler tables.
+  bool LookupBaseRow(int_t node, int* row) const {
+    return graph_builder_->context_storage()->LookupRow(node, row);
+  }
+  pair_view_t FindContextAt(int row) const {
+    return graph_builder_->context_storage()->FindNeighborAt(row);
+  }
+  pair_view_t FindNodeFeatureAt(int row) const {
+    return FindFeatureAt(graph_builder_->node_feature_storage(),
+                         node_feat_rows_, row);
+  }
+  pair_view_t FindNeighFeatureAt(int row) const {
+    return FindFeatureAt(graph_builder_->neigh_feature_storage(),
+                         neigh_feat_rows_, row);
+  }
+
   // size
   size_t node_size() const noexcept {
     return graph_builder_->context_storage()->Size();
@@ -98,8 +186,26 @@ class InMemoryGraph {
 
  private:
   bool Build(const GraphConfig& config);
+  bool Load(const GraphConfig& config, SnapshotReader* reader);
   bool CheckSizeValid() const;
-  void PrintGraphTopo() const;
+  bool CheckNamespace(int_t node) const;
+  void BuildFeatureRows();
+  const DeltaLists* FindDelta(int_t node) const {
+    const auto* delta_map = delta_map_.get();
+    if (delta_map == nullptr) {
+      return nullptr;
+    }
+    return delta_map->Find(node);
+  }
+  void PrintGraphTopo(const GraphConfig& config) const;
+
+  static pair_view_t FindFeatureAt(const Storage* storage,
+                                   const std::vector<int>& feat_rows, int row) {
+    if (feat_rows.empty() || feat_rows[row] < 0) {
+      return pair_view_t();
+    }
+    return storage->FindNeighborAt(feat_rows[row]);
+  }
 
  private:
   InMemoryGraph() = default;
@@ -14,11 +14,15 @@
 
 #include <gtest/gtest.h>
 
-#include <memory>  // std::unique_ptr
+#include <algorithm>  // std::sort
+#include <cstdio>     // std::remove
+#include <memory>     // std::unique_ptr
 #include <string>
 
 #include "src/common/data_types.h"
 #include "src/graph/graph_config.h"
+#include "src/graph/graph_delta.h"
+#include "src/io/snapshot.h"
 #include "src/io/storage/adjacency.h"
 
 namespace embedx {
@@ -34,6 +38,8 @@ class InMemoryGraphTest : public ::testing::Test {
   const std::string USER_ITEM_CONFIG = "testdata/user_item_config";
   const std::string NODE_FEATURE = "testdata/node_feature";
   const std::string NEIGHBOR_FEATURE = "testdata/neigh_feature";
+  const std::string SNAPSHOT_FILE = "in_memory_graph_test.snapshot";
+  const std::string DELTA = "testdata/delta";
 
   const int SHARD_NUM = 1;
   const int SHARD_ID = 0;
@@ -52,6 +58,125 @@ class InMemoryGraphTest : public ::testing::Test {
     config_.set_thread_num(THREAD_NUM);
   }
 
+  void TearDown() override { std::remove(SNAPSHOT_FILE.c_str()); }
+
+  void ExpectSameFind(const vec_int_t& nodes, const InMemoryGraph& graph,
+                      pair_view_t (InMemoryGraph::*find)(int_t) const) {
+    for (auto node : nodes) {
+      auto expected = (graph_.get()->*find)(node);
+      auto actual = (graph.*find)(node);
+      ASSERT_EQ(actual.size(), expected.size());
+      for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(actual[i], expected[i]);
+      }
+    }
+  }
+
+  void TestSnapshot() {
+    config_.set_node_graph(USER_ITEM_CONTEXT);
+    config_.set_node_config(USER_ITEM_CONFIG);
+    graph_ = InMemoryGraph::Create(config_);
+    ASSERT_TRUE(graph_ != nullptr);
+
+    SnapshotWriter writer;
+    EXPECT_TRUE(writer.Open(SNAPSHOT_FILE));
+    EXPECT_TRUE(graph_->Dump(&writer));
+    EXPECT_TRUE(writer.Close());
+
+    SnapshotReader reader;
+    EXPECT_TRUE(reader.Open(SNAPSHOT_FILE));
+    auto graph = InMemoryGraph::Create(config_, &reader);
+    ASSERT_TRUE(graph != nullptr);
+    EXPECT_TRUE(reader.AtEnd());
+
+    // topology
+    EXPECT_EQ(graph->ns_size(), graph_->ns_size());
+    EXPECT_EQ(graph->id_name_map(), graph_->id_name_map());
+    EXPECT_EQ(graph->uniq_nodes_list(), graph_->uniq_nodes_list());
+    EXPECT_EQ(graph->uniq_freqs_list(), graph_->uniq_freqs_list());
+    EXPECT_EQ(graph->total_freqs(), graph_->total_freqs());
+
+    // keys
+    EXPECT_EQ(graph->node_keys(), graph_->node_keys());
+    EXPECT_EQ(graph->node_feature_keys(), graph_->node_feature_keys());
+    EXPECT_EQ(graph->neigh_feature_keys(), graph_->neigh_feature_keys());
+
+    // find
+    ExpectSameFind(graph_->node_keys(), *graph, &InMemoryGraph::FindContext);
+    ExpectSameFind(graph_->node_feature_keys(), *graph,
+                   &InMemoryGraph::FindNodeFeature);
+    ExpectSameFind(graph_->neigh_feature_keys(), *graph,
+                   &InMemoryGraph::FindNeighFeature);
+
+    // degree
+    for (auto node : graph_->node_keys()) {
+      EXPECT_EQ(graph->GetInDegree(node), graph_->GetInDegree(node));
+      EXPECT_EQ(graph->GetOutDegree(node), graph_->GetOutDegree(node));
+    }
+  }
+
+  static void ExpectSamePairs(pair_view_t actual, const vec_pair_t& expected) {
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+      EXPECT_EQ(actual[i].first, expected[i].first);
+      EXPECT_FLOAT_EQ(actual[i].second, expected[i].second);
+    }
+  }
+
+  void TestApplyDelta() {
+    graph_ = InMemoryGraph::Create(config_);
+    ASSERT_TRUE(graph_ != nullptr);
+    auto base_neigh_feature = graph_->FindNeighFeature(0);
+    auto base_context = graph_->FindContext(6);
+
+    auto delta = GraphDelta::Create(DELTA, config_, graph_->partitioner());
+    ASSERT_TRUE(delta != nullptr);
+    vec_int_t nodes;
+    EXPECT_EQ(graph_->delta_num(), 0);
+    EXPECT_TRUE(graph_->ApplyDelta(*delta, &nodes));
+    EXPECT_EQ(graph_->delta_num(), 1);
+    std::sort(nodes.begin(), nodes.end());
+    EXPECT_EQ(nodes, vec_int_t({0, 3, 100}));
+
+    // changed
+    auto context = graph_->FindContext(0);
+    ExpectSamePairs(context, {{10, 1.3}, {11, 3.0}, {13, 2.0}});
+    EXPECT_EQ(graph_->GetOutDegree(0), 3);
+    ExpectSamePairs(graph_->FindNodeFeature(0), {{99, 1.5}});
+    EXPECT_TRUE(graph_->FindContext(3).empty());
+    ExpectSamePairs(graph_->FindContext(100), {{0, 1.0}, {3, 1.0}});
+
+    // unchanged
+    ExpectSamePairs(graph_->FindNeighFeature(0),
+                    vec_pair_t(base_neigh_feature.begin(),
+                               base_neigh_feature.end()));
+    ExpectSamePairs(graph_->FindContext(6),
+                    vec_pair_t(base_context.begin(), base_context.end()));
+
+    // rows
+    int row = 0;
+    EXPECT_FALSE(graph_->LookupRow(0, &row));
+    EXPECT_TRUE(graph_->LookupBaseRow(0, &row));
+    EXPECT_TRUE(graph_->LookupRow(6, &row));
+    EXPECT_FALSE(graph_->LookupRow(100, &row));
+
+    // Pinned lists survive the next deltas.
+    {
+      PublishedPins pins;
+      graph_->PinDelta(&pins);
+      context = graph_->FindContext(0);
+      for (int i = 0; i < 2; ++i) {
+        nodes.clear();
+        EXPECT_TRUE(graph_->ApplyDelta(*delta, &nodes));
+        EXPECT_EQ(nodes.size(), 3u);
+      }
+      EXPECT_EQ(graph_->FindContext(0).data(), context.data());
+      ExpectSamePairs(context, {{10, 1.3}, {11, 3.0}, {13, 2.0}});
+    }
+    EXPECT_NE(graph_->FindContext(0).data(), context.data());
+    ExpectSamePairs(graph_->FindContext(0), {{10, 1.3}, {11, 3.0}, {13, 2.0}});
+  }
+
   void TestOneNameSpace() {
     graph_ = InMemoryGraph::Create(config_);
     EXPECT_TRUE(graph_ != nullptr);
@@ -141,6 +266,10 @@ TEST_F(InMemoryGraphTest, Build_OneNameSpace) {
   // AdjMatrix
   config_.set_store_type((int)AdjacencyEnum::ADJ_MATRIX);
   TestOneNameSpace();
+
+  // AdjCsr
+  config_.set_store_type((int)AdjacencyEnum::ADJ_CSR);
+  TestOneNameSpace();
 }
 
 TEST_F(InMemoryGraphTest, Build_TwoNameSpace) {
@@ -151,6 +280,10 @@ TEST_F(InMemoryGraphTest, Build_TwoNameSpace) {
   // AdjMatrix
   config_.set_store_type((int)AdjacencyEnum::ADJ_MATRIX);
   TestTwoNameSpace();
+
+  // AdjCsr
+  config_.set_store_type((int)AdjacencyEnum::ADJ_CSR);
+  TestTwoNameSpace();
 }
 
 TEST_F(InMemoryGraphTest, Build_Shard0) {
@@ -161,6 +294,10 @@ TEST_F(InMemoryGraphTest, Build_Shard0) {
   // AdjMatrix
   config_.set_store_type((int)AdjacencyEnum::ADJ_MATRIX);
   TestShard0();
+
+  // AdjCsr
+  config_.set_store_type((int)AdjacencyEnum::ADJ_CSR);
+  TestShard0();
 }
 
 TEST_F(InMemoryGraphTest, Build_Shard1) {
@@ -171,6 +308,34 @@ TEST_F(InMemoryGraphTest, Build_Shard1) {
   // AdjMatrix
   config_.set_store_type((int)AdjacencyEnum::ADJ_MATRIX);
   TestShard1();
+
+  // AdjCsr
+  config_.set_store_type((int)AdjacencyEnum::ADJ_CSR);
+  TestShard1();
+}
+
+TEST_F(InMemoryGraphTest, ApplyDelta) {
+  // AdjList
+  config_.set_store_type((int)AdjacencyEnum::ADJ_LIST);
+  TestApplyDelta();
+
+  // AdjCsr
+  config_.set_store_type((int)AdjacencyEnum::ADJ_CSR);
+  TestApplyDelta();
+}
+
+TEST_F(InMemoryGraphTest, Snapshot) {
+  // AdjList
+  config_.set_store_type((int)AdjacencyEnum::ADJ_LIST);
+  TestSnapshot();
+
+  // AdjMatrix
+  config_.set_store_type((int)AdjacencyEnum::ADJ_MATRIX);
+  TestSnapshot();
+
+  // AdjCsr
+  config_.set_store_type((int)AdjacencyEnum::ADJ_CSR);
+  TestSnapshot();
 }
 
 }  // namespace embedx
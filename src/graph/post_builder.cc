@@ -13,16 +13,29 @@
 
 #include <deepx_core/dx_log.h>
 
+#include <algorithm>  // std::sort
+#include <chrono>
 #include <cinttypes>  // PRIu64
-#include <mutex>
-#include <unordered_set>
 
+#include "src/common/flat_hash_map.h"
 #include "src/io/io_util.h"
 
 namespace embedx {
 namespace {
 
+// Each thread counts the nodes of its own rows, the counts are merged by
+// namespace at the end. No lock is taken while counting.
 class PostBuilderHelper {
+ private:
+  // counts of one thread
+  struct LocalFreqs {
+    // [ns], node -> frequency
+    std::vector<FlatHashMap<int_t, float_t>> freq_maps;
+    // [ns], in the order they were first seen
+    std::vector<vec_int_t> nodes_list;
+    vec_int_t total_freqs;
+  };
+
  private:
   const id_name_t& id_name_map_;
   uint16_t ns_size_ = 1;
@@ -33,9 +46,7 @@ class PostBuilderHelper {
   std::vector<vec_float_t>* uniq_freqs_list_ = nullptr;
   vec_int_t* total_freqs_ = nullptr;
 
-  std::mutex mtx_;
-  std::unordered_set<int_t> node_set_;
-  std::vector<weight_map_t> node_weight_maps_;
+  std::vector<LocalFreqs> local_freqs_list_;
 
  public:
   PostBuilderHelper(const id_name_t& id_name_map, uint16_t ns_size,
@@ -52,9 +63,10 @@ class PostBuilderHelper {
 
  private:
   void Clear() noexcept;
-  void Prepare(uint16_t ns_size, uint64_t estimated_size);
-  bool Insert(int_t node);
-  void AccumulateFreqs();
+  void Prepare(uint16_t ns_size, uint64_t estimated_size, int thread_num);
+  bool Insert(int_t node, LocalFreqs* local_freqs) const;
+  bool MergeFreqs(const vec_int_t& ns_ids, int thread_num);
+  void MergeNamespace(uint16_t ns_id);
   bool Process(const vec_int_t& nodes, int thread_num);
   bool ProcessEntry(const vec_int_t& nodes, int thread_id);
 };
@@ -67,7 +79,7 @@ bool PostBuilderHelper::Build(std::vector<vec_int_t>* uniq_nodes_list,
   total_freqs_ = total_freqs;
 
   Clear();
-  Prepare(ns_size_, estimated_size_);
+  Prepare(ns_size_, estimated_size_, thread_num);
 
   return Process(store_->Keys(), thread_num);
 }
@@ -77,20 +89,27 @@ void PostBuilderHelper::Clear() noexcept {
   uniq_freqs_list_->clear();
   total_freqs_->clear();
 
-  node_set_.clear();
-  node_weight_maps_.clear();
+  local_freqs_list_.clear();
 }
 
-void PostBuilderHelper::Prepare(uint16_t ns_size, uint64_t estimated_size) {
+void PostBuilderHelper::Prepare(uint16_t ns_size, uint64_t estimated_size,
+                                int thread_num) {
   uniq_nodes_list_->resize(ns_size);
   uniq_freqs_list_->resize(ns_size);
   total_freqs_->resize(ns_size, 0);
 
-  node_set_.reserve(estimated_size);
-  node_weight_maps_.resize(ns_size);
+  local_freqs_list_.resize(thread_num);
+  for (auto& local_freqs : local_freqs_list_) {
+    local_freqs.freq_maps.resize(ns_size);
+    local_freqs.nodes_list.resize(ns_size);
+    local_freqs.total_freqs.resize(ns_size, 0);
+    for (auto& freq_map : local_freqs.freq_maps) {
+      freq_map.reserve(estimated_size / thread_num / ns_size);
+    }
+  }
 }
 
-bool PostBuilderHelper::Insert(int_t node) {
+bool PostBuilderHelper::Insert(int_t node, LocalFreqs* local_freqs) const {
   uint16_t ns_id = io_util::GetNodeType(node);
   if (id_name_map_.find(ns_id) == id_name_map_.end()) {
     DXERROR("Couldn't find node: %" PRIu64
@@ -99,40 +118,70 @@ bool PostBuilderHelper::Insert(int_t node) {
     return false;
   }
 
-  if (node_set_.find(node) == node_set_.end()) {
-    node_set_.insert(node);
-    (*uniq_nodes_list_)[ns_id].emplace_back(node);
-  }
-
-  auto& node_weight_map = node_weight_maps_[ns_id];
-  auto it = node_weight_map.find(node);
-  if (it == node_weight_map.end()) {
-    node_weight_map.emplace(node, 1.0);
+  auto& freq_map = local_freqs->freq_maps[ns_id];
+  auto it = freq_map.find(node);
+  if (it == freq_map.end()) {
+    freq_map.emplace(node, 1.0);
+    local_freqs->nodes_list[ns_id].emplace_back(node);
   } else {
     it->second += 1.0;
   }
 
-  (*total_freqs_)[ns_id] += 1;
+  local_freqs->total_freqs[ns_id] += 1;
   return true;
 }
 
-void PostBuilderHelper::AccumulateFreqs() {
-  for (size_t i = 0; i < uniq_freqs_list_->size(); ++i) {
-    const auto& nodes = (*uniq_nodes_list_)[i];
-    auto& freqs = (*uniq_freqs_list_)[i];
-    freqs.reserve(nodes.size());
-
-    for (auto node : nodes) {
-      auto ns_id = io_util::GetNodeType(node);
-      auto it = node_weight_maps_[ns_id].find(node);
-      DXCHECK(it != node_weight_maps_[ns_id].end());
-      freqs.emplace_back(it->second);
+bool PostBuilderHelper::MergeFreqs(const vec_int_t& ns_ids, int thread_num) {
+  // Namespaces are merged independently.
+  return io_util::ParallelProcess<int_t>(
+      ns_ids,
+      [this](const vec_int_t& ns_ids, int /*thread_id*/) {
+        for (auto ns_id : ns_ids) {
+          MergeNamespace((uint16_t)ns_id);
+        }
+        return true;
+      },
+      thread_num);
+}
+
+void PostBuilderHelper::MergeNamespace(uint16_t ns_id) {
+  // Nodes keep the order of the threads, then the order they were seen in.
+  size_t max_size = 0;
+  for (const auto& local_freqs : local_freqs_list_) {
+    max_size += local_freqs.nodes_list[ns_id].size();
+  }
+
+  auto& uniq_nodes = (*uniq_nodes_list_)[ns_id];
+  auto& uniq_freqs = (*uniq_freqs_list_)[ns_id];
+  FlatHashMap<int_t, int> uniq_indices;
+  uniq_indices.reserve(max_size);
+  uniq_nodes.reserve(max_size);
+  uniq_freqs.reserve(max_size);
+  for (auto& local_freqs : local_freqs_list_) {
+    const auto& freq_map = local_freqs.freq_maps[ns_id];
+    for (auto node : local_freqs.nodes_list[ns_id]) {
+      float_t freq = freq_map.at(node);
+      auto it = uniq_indices.find(node);
+      if (it == uniq_indices.end()) {
+        uniq_indices.emplace(node, (int)uniq_nodes.size());
+        uniq_nodes.emplace_back(node);
+        uniq_freqs.emplace_back(freq);
+      } else {
+        uniq_freqs[it->second] += freq;
+      }
     }
+    (*total_freqs_)[ns_id] += local_freqs.total_freqs[ns_id];
+
+    local_freqs.freq_maps[ns_id] = FlatHashMap<int_t, float_t>();
+    vec_int_t().swap(local_freqs.nodes_list[ns_id]);
   }
+  uniq_nodes.shrink_to_fit();
+  uniq_freqs.shrink_to_fit();
 }
 
 bool PostBuilderHelper::Process(const vec_int_t& nodes, int thread_num) {
   DXINFO("Post building ...");
+  auto begin = std::chrono::steady_clock::now();
 
   if (!io_util::ParallelProcess<int_t>(
           nodes,
@@ -143,37 +192,44 @@ bool PostBuilderHelper::Process(const vec_int_t& nodes, int thread_num) {
     DXERROR("Failed to post building.");
     return false;
   }
+  auto counted = std::chrono::steady_clock::now();
 
-  AccumulateFreqs();
+  vec_int_t ns_ids;
+  for (const auto& entry : id_name_map_) {
+    ns_ids.emplace_back(entry.first);
+  }
+  if (!MergeFreqs(ns_ids, thread_num)) {
+    DXERROR("Failed to merge node frequencies.");
+    return false;
+  }
+  local_freqs_list_.clear();
+  auto merged = std::chrono::steady_clock::now();
 
-  DXINFO("Done.");
+  DXINFO("Done, counting took %.3f s, merging took %.3f s with %d threads.",
+         std::chrono::duration<double>(counted - begin).count(),
+         std::chrono::duration<double>(merged - counted).count(), thread_num);
   return true;
 }
 
 bool PostBuilderHelper::ProcessEntry(const vec_int_t& nodes, int thread_id) {
   DXINFO("Thread: %d is processing ...", thread_id);
 
+  auto* local_freqs = &local_freqs_list_[thread_id];
   for (auto node : nodes) {
     // node
-    {
-      std::lock_guard<std::mutex> guard(mtx_);
-      if (!Insert(node)) {
-        return false;
-      }
+    if (!Insert(node, local_freqs)) {
+      return false;
     }
 
     // context
-    const auto* context = store_->FindNeighbor(node);
-    if (context == nullptr) {
+    auto context = store_->FindNeighbor(node);
+    if (context.empty()) {
       DXERROR("Couldn't find node: %" PRIu64 " context.", node);
       return false;
     }
-    for (auto& entry : *context) {
-      {
-        std::lock_guard<std::mutex> guard(mtx_);
-        if (!Insert(entry.first)) {
-          return false;
-        }
+    for (auto& entry : context) {
+      if (!Insert(entry.first, local_freqs)) {
+        return false;
       }
     }
   }
@@ -198,6 +254,69 @@ bool PostBuilder::Build(const std::string& config, int thread_num) {
                               &total_freqs_, thread_num);
 }
 
+void PostBuilder::CollectMemory(MemoryUsage* usage) const {
+  uint64_t node_num = 0;
+  for (const auto& uniq_nodes : uniq_nodes_list_) {
+    node_num += uniq_nodes.size();
+  }
+  usage->Add("uniq_nodes", NestedVectorBytes(uniq_nodes_list_), node_num);
+  usage->Add("uniq_freqs", NestedVectorBytes(uniq_freqs_list_), node_num);
+}
+
+/************************************************************************/
+/* Snapshot */
+/************************************************************************/
+bool PostBuilder::Dump(SnapshotWriter* writer) const {
+  std::vector<uint16_t> ns_ids;
+  for (const auto& entry : id_name_map_) {
+    ns_ids.emplace_back(entry.first);
+  }
+  std::sort(ns_ids.begin(), ns_ids.end());
+
+  if (!writer->WriteValue(ns_size_) || !writer->WriteArray(ns_ids)) {
+    return false;
+  }
+  for (auto ns_id : ns_ids) {
+    if (!writer->WriteString(id_name_map_.at(ns_id))) {
+      return false;
+    }
+  }
+
+  for (size_t i = 0; i < ns_size_; ++i) {
+    if (!writer->WriteArray(uniq_nodes_list_[i]) ||
+        !writer->WriteArray(uniq_freqs_list_[i])) {
+      return false;
+    }
+  }
+  return writer->WriteArray(total_freqs_);
+}
+
+bool PostBuilder::Load(SnapshotReader* reader) {
+  std::vector<uint16_t> ns_ids;
+  if (!reader->ReadValue(&ns_size_) || !reader->ReadArray(&ns_ids)) {
+    return false;
+  }
+
+  id_name_map_.clear();
+  std::string ns_name;
+  for (auto ns_id : ns_ids) {
+    if (!reader->ReadString(&ns_name)) {
+      return false;
+    }
+    id_name_map_.emplace(ns_id, ns_name);
+  }
+
+  uniq_nodes_list_.resize(ns_size_);
+  uniq_freqs_list_.resize(ns_size_);
+  for (size_t i = 0; i < ns_size_; ++i) {
+    if (!reader->ReadArray(&uniq_nodes_list_[i]) ||
+        !reader->ReadArray(&uniq_freqs_list_[i])) {
+      return false;
+    }
+  }
+  return reader->ReadArray(&total_freqs_);
+}
+
 std::unique_ptr<PostBuilder> PostBuilder::Create(const Storage* store,
                                                  const GraphConfig& config) {
   std::unique_ptr<PostBuilder> post_builder;
@@ -214,4 +333,16 @@ std::unique_ptr<PostBuilder> PostBuilder::Create(const Storage* store,
   return post_builder;
 }
 
+std::unique_ptr<PostBuilder> PostBuilder::Create(SnapshotReader* reader) {
+  std::unique_ptr<PostBuilder> post_builder;
+  post_builder.reset(new PostBuilder());
+
+  if (!post_builder->Load(reader)) {
+    DXERROR("Failed to read post builder from snapshot.");
+    post_builder.reset();
+  }
+
+  return post_builder;
+}
+
 }  // namespace embedx
@@ -15,8 +15,10 @@
 #include <vector>
 
 #include "src/common/data_types.h"
+#include "src/common/memory_usage.h"
 #include "src/graph/graph_builder.h"
 #include "src/graph/graph_config.h"
+#include "src/io/snapshot.h"
 #include "src/io/storage/storage.h"
 
 namespace embedx {
@@ -35,6 +37,10 @@ class PostBuilder {
  public:
   static std::unique_ptr<PostBuilder> Create(const Storage* store,
                                              const GraphConfig& config);
+  static std::unique_ptr<PostBuilder> Create(SnapshotReader* reader);
+
+ public:
+  bool Dump(SnapshotWriter* writer) const;
 
  public:
   uint16_t ns_size() const noexcept { return ns_size_; }
@@ -47,11 +53,14 @@ class PostBuilder {
     return uniq_freqs_list_;
   }
   const vec_int_t& total_freqs() const noexcept { return total_freqs_; }
+  // Adds the bytes of "uniq_nodes" and "uniq_freqs".
+  void CollectMemory(MemoryUsage* usage) const;
 
  private:
   void set_store(const Storage* store) noexcept { store_ = store; }
   void set_estimated_size(uint64_t size) noexcept { estimated_size_ = size; }
   bool Build(const std::string& config, int thread_num);
+  bool Load(SnapshotReader* reader);
 
  private:
   PostBuilder() = default;
@@ -13,8 +13,10 @@
 
 #include <gtest/gtest.h>
 
+#include <map>
 #include <memory>  // std::unique_ptr
 #include <string>
+#include <vector>
 
 #include "src/common/data_types.h"
 #include "src/graph/graph_config.h"
@@ -71,4 +73,39 @@ TEST_F(PostBuilderTest, Build_TwoNameSpace) {
   EXPECT_EQ(post_builder_->total_freqs()[1], (int_t)52);
 }
 
+TEST_F(PostBuilderTest, Build_ThreadNum) {
+  loader_ = NewContextLoader();
+  EXPECT_TRUE(loader_->Load(USER_ITEM_CONTEXT, THREAD_NUM));
+  config_.set_node_config(USER_ITEM_CONFIG);
+
+  // node -> frequency of each namespace
+  auto build = [this](int thread_num,
+                      std::vector<std::map<int_t, float_t>>* freq_maps) {
+    config_.set_thread_num(thread_num);
+    post_builder_ = PostBuilder::Create(loader_->storage(), config_);
+    ASSERT_TRUE(post_builder_ != nullptr);
+
+    const auto& uniq_nodes_list = post_builder_->uniq_nodes_list();
+    const auto& uniq_freqs_list = post_builder_->uniq_freqs_list();
+    freq_maps->resize(uniq_nodes_list.size());
+    for (size_t i = 0; i < uniq_nodes_list.size(); ++i) {
+      ASSERT_EQ(uniq_nodes_list[i].size(), uniq_freqs_list[i].size());
+      float_t total_freq = 0;
+      for (size_t j = 0; j < uniq_nodes_list[i].size(); ++j) {
+        (*freq_maps)[i][uniq_nodes_list[i][j]] = uniq_freqs_list[i][j];
+        total_freq += uniq_freqs_list[i][j];
+      }
+      EXPECT_EQ(total_freq, (float_t)post_builder_->total_freqs()[i]);
+    }
+  };
+
+  std::vector<std::map<int_t, float_t>> expected_freq_maps;
+  build(1, &expected_freq_maps);
+  for (int thread_num : {2, 5}) {
+    std::vector<std::map<int_t, float_t>> freq_maps;
+    build(thread_num, &freq_maps);
+    EXPECT_EQ(freq_maps, expected_freq_maps);
+  }
+}
+
 }  // namespace embedx
@@ -13,6 +13,7 @@
 #pragma once
 #include <deepx_core/common/stream.h>
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -76,6 +77,8 @@ struct SharedNegativeSamplerRequest {
   int count;
   vec_int_t nodes;
   vec_int_t excluded_nodes;
+  // key of the sampling streams, 0 for unseeded sampling
+  uint64_t seed = 0;
 
   static int rpc_type() noexcept { return RPC_TYPE_SHARED_NEGATIVE_SAMPLER; }
 };
@@ -86,13 +89,13 @@ struct SharedNegativeSamplerResponse {
 
 inline OutputStream& operator<<(OutputStream& os,
                                 const SharedNegativeSamplerRequest& req) {
-  os << req.count << req.nodes << req.excluded_nodes;
+  os << req.count << req.nodes << req.excluded_nodes << req.seed;
   return os;
 }
 
 inline InputStream& operator>>(InputStream& is,
                                SharedNegativeSamplerRequest& req) {
-  is >> req.count >> req.nodes >> req.excluded_nodes;
+  is >> req.count >> req.nodes >> req.excluded_nodes >> req.seed;
   return is;
 }
 
@@ -115,6 +118,8 @@ struct IndepNegativeSamplerRequest {
   int count;
   vec_int_t nodes;
   vec_int_t excluded_nodes;
+  // key of the sampling streams, 0 for unseeded sampling
+  uint64_t seed = 0;
 
   static int rpc_type() noexcept { return RPC_TYPE_INDEP_NEGATIVE_SAMPLER; }
 };
@@ -125,13 +130,13 @@ struct IndepNegativeSamplerResponse {
 
 inline OutputStream& operator<<(OutputStream& os,
                                 const IndepNegativeSamplerRequest& req) {
-  os << req.count << req.nodes << req.excluded_nodes;
+  os << req.count << req.nodes << req.excluded_nodes << req.seed;
   return os;
 }
 
 inline InputStream& operator>>(InputStream& is,
                                IndepNegativeSamplerRequest& req) {
-  is >> req.count >> req.nodes >> req.excluded_nodes;
+  is >> req.count >> req.nodes >> req.excluded_nodes >> req.seed;
   return is;
 }
 
@@ -153,6 +158,8 @@ inline InputStream& operator>>(InputStream& is,
 struct RandomNeighborSamplerRequest {
   int count;
   vec_int_t nodes;
+  // key of the sampling streams, 0 for unseeded sampling
+  uint64_t seed = 0;
 
   static int rpc_type() noexcept { return RPC_TYPE_RANDOM_NEIGHBOR_SAMPLER; }
 };
@@ -163,13 +170,13 @@ struct RandomNeighborSamplerResponse {
 
 inline OutputStream& operator<<(OutputStream& os,
                                 const RandomNeighborSamplerRequest& req) {
-  os << req.count << req.nodes;
+  os << req.count << req.nodes << req.seed;
   return os;
 }
 
 inline InputStream& operator>>(InputStream& is,
                                RandomNeighborSamplerRequest& req) {
-  is >> req.count >> req.nodes;
+  is >> req.count >> req.nodes >> req.seed;
   return is;
 }
 
@@ -13,6 +13,7 @@
 #pragma once
 #include <deepx_core/common/stream.h>
 
+#include <cstdint>
 #include <vector>
 
 #include "src/common/data_types.h"
@@ -57,6 +58,8 @@ struct StaticRandomWalkerRequest {
   vec_int_t cur_nodes;
   std::vector<int> walk_lens;
   WalkerInfo walker_info;
+  // seeds of the walkers, empty for unseeded walks
+  std::vector<uint64_t> seeds;
 
   static int rpc_type() noexcept { return RPC_TYPE_STATIC_RANDOM_WALKER; }
 };
@@ -67,13 +70,13 @@ struct StaticRandomWalkerResponse {
 
 inline OutputStream& operator<<(OutputStream& os,
                                 const StaticRandomWalkerRequest& req) {
-  os << req.cur_nodes << req.walk_lens << req.walker_info;
+  os << req.cur_nodes << req.walk_lens << req.walker_info << req.seeds;
   return os;
 }
 
 inline InputStream& operator>>(InputStream& is,
                                StaticRandomWalkerRequest& req) {
-  is >> req.cur_nodes >> req.walk_lens >> req.walker_info;
+  is >> req.cur_nodes >> req.walk_lens >> req.walker_info >> req.seeds;
   return is;
 }
 
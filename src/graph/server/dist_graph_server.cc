@@ -15,8 +15,14 @@
 #include <deepx_core/common/stream.h>
 #include <deepx_core/dx_log.h>
 
+#include <atomic>
+#include <chrono>
 #include <string>
+#include <utility>  // std::move
+#include <vector>
 
+#include "src/common/memory_usage.h"
+#include "src/common/published_ptr.h"
 #include "src/graph/data_op/cache_node_lookuper_op/cache_node_lookuper.h"
 #include "src/graph/data_op/context_lookuper_op/context_lookuper.h"
 #include "src/graph/data_op/feature_lookuper_op/feature_lookuper.h"
@@ -30,6 +36,7 @@
 #include "src/graph/data_op/neighbor_sampler_op/random_neighbor_sampler.h"
 #include "src/graph/data_op/random_walker_op/static_random_walker.h"
 #include "src/graph/graph_config.h"
+#include "src/graph/graph_delta.h"
 
 namespace embedx {
 namespace {
@@ -48,47 +55,263 @@ void TouchSuccessFile(const GraphConfig& config) {
   os.Close();
 }
 
+bool WriteShard(const GraphConfig& config, SnapshotWriter* writer) {
+  return writer->WriteValue(config.shard_num()) &&
+         writer->WriteValue(config.shard_id());
+}
+
+bool CheckShard(const GraphConfig& config, SnapshotReader* reader) {
+  int shard_num = 0;
+  int shard_id = 0;
+  if (!reader->ReadValue(&shard_num) || !reader->ReadValue(&shard_id)) {
+    return false;
+  }
+
+  if (shard_num != config.shard_num() || shard_id != config.shard_id()) {
+    DXERROR(
+        "Need shard_num: %d and shard_id: %d, got shard_num: %d and "
+        "shard_id: %d in snapshot.",
+        config.shard_num(), config.shard_id(), shard_num, shard_id);
+    return false;
+  }
+  return true;
+}
+
+std::string VersionDir(const std::string& dir, int version) {
+  return dir + "/" + std::to_string(version);
+}
+
+bool IsComplete(const std::string& dir) {
+  return deepx_core::AutoFileSystem::Exists(dir + "/_SUCCESS");
+}
+
+std::string OptionalPath(const std::string& path) {
+  return deepx_core::AutoFileSystem::Exists(path) ? path : "";
+}
+
+// the graph files of a version in 'reload_dir'
+GraphConfig ReloadConfig(const GraphConfig& config, const std::string& dir) {
+  GraphConfig reload_config = config;
+  reload_config.set_node_graph(dir + "/node_graph");
+  reload_config.set_node_feature(OptionalPath(dir + "/node_feature"));
+  reload_config.set_neighbor_feature(OptionalPath(dir + "/neighbor_feature"));
+  reload_config.set_load_snapshot(OptionalPath(dir + "/snapshot"));
+  return reload_config;
+}
+
 }  // namespace
 
-using ::embedx::graph_op::LocalGSOp;
 using ::embedx::graph_op::LocalGSOpFactory;
 using ::embedx::graph_op::LocalGSOpResource;
 
 bool DistGraphServer::InitGraphServer(const GraphConfig& config) {
-  resource_.reset(new graph_op::LocalGSOpResource);
+  auto generation = NewGeneration(config, 0);
+  if (!generation) {
+    return false;
+  }
+  std::atomic_store(&generation_, generation);
+  return true;
+}
+
+std::shared_ptr<DistGraphServer::Generation> DistGraphServer::NewGeneration(
+    const GraphConfig& config, int version) const {
+  std::shared_ptr<Generation> generation(new Generation);
+  generation->resource.reset(new LocalGSOpResource);
+  auto* resource = generation->resource.get();
+
+  if (config.load_snapshot().empty()) {
+    if (!InitResource(config, nullptr, resource)) {
+      return nullptr;
+    }
+  } else {
+    DXINFO("Loading graph server from snapshot: %s...",
+           config.load_snapshot().c_str());
+    SnapshotReader reader;
+    if (!reader.Open(config.load_snapshot()) || !CheckShard(config, &reader) ||
+        !InitResource(config, &reader, resource)) {
+      DXERROR("Failed to load snapshot: %s.", config.load_snapshot().c_str());
+      return nullptr;
+    }
+    if (!reader.AtEnd()) {
+      DXERROR("Unexpected trailing data in snapshot: %s.",
+              config.load_snapshot().c_str());
+      return nullptr;
+    }
+    DXINFO("Done.");
+  }
+  resource->set_graph_version(version);
 
-  resource_->set_graph_config(config);
+  generation->factory = LocalGSOpFactory::Create();
+  if (!generation->factory->Init(resource)) {
+    return nullptr;
+  }
+  for (const auto& name : op_names_) {
+    generation->ops[name] = generation->factory->LookupOrCreate(name);
+  }
+  return generation;
+}
+
+bool DistGraphServer::InitResource(const GraphConfig& config,
+                                   SnapshotReader* reader,
+                                   LocalGSOpResource* resource) {
+  resource->set_graph_config(config);
 
   // data
-  auto graph = InMemoryGraph::Create(config);
+  auto graph = reader ? InMemoryGraph::Create(config, reader)
+                      : InMemoryGraph::Create(config);
   if (!graph) {
     return false;
   }
-  resource_->set_graph(std::move(graph));
+  resource->set_graph(std::move(graph));
 
-  auto sampler_source = NewGraphSamplerSource(resource_->graph());
+  auto sampler_source = NewGraphSamplerSource(resource->graph());
   if (!sampler_source) {
     return false;
   }
-  resource_->set_sampler_source(std::move(sampler_source));
+  resource->set_sampler_source(std::move(sampler_source));
 
   auto negative_sampler_builder = NewSamplerBuilder(
-      resource_->sampler_source(), SamplerBuilderEnum::NEGATIVE_SAMPLER,
-      config.negative_sampler_type(), config.thread_num());
+      resource->sampler_source(), SamplerBuilderEnum::NEGATIVE_SAMPLER,
+      config.negative_sampler_type(), config.thread_num(), reader);
   if (!negative_sampler_builder) {
     return false;
   }
-  resource_->set_negative_sampler_builder(std::move(negative_sampler_builder));
+  resource->set_negative_sampler_builder(std::move(negative_sampler_builder));
 
   auto neighbor_sampler_builder = NewSamplerBuilder(
-      resource_->sampler_source(), SamplerBuilderEnum::NEIGHBOR_SAMPLER,
-      config.neighbor_sampler_type(), config.thread_num());
+      resource->sampler_source(), SamplerBuilderEnum::NEIGHBOR_SAMPLER,
+      config.neighbor_sampler_type(), config.thread_num(), reader);
   if (!neighbor_sampler_builder) {
     return false;
   }
-  resource_->set_neighbor_sampler_builder(std::move(neighbor_sampler_builder));
+  resource->set_neighbor_sampler_builder(std::move(neighbor_sampler_builder));
 
-  return LocalGSOpFactory::GetInstance()->Init(resource_.get());
+  // The graph is printed by InMemoryGraph.
+  if (config.print_memory()) {
+    MemoryUsage usage;
+    resource->CollectSamplerMemory(&usage);
+    DXINFO("Memory usage of samplers:\n%s", usage.ToString().c_str());
+  }
+  return true;
+}
+
+bool DistGraphServer::DumpSnapshot(const GraphConfig& config) {
+  LocalGSOpResource resource;
+  if (!InitResource(config, nullptr, &resource)) {
+    DXERROR("Failed to init graph server.");
+    return false;
+  }
+
+  DXINFO("Dumping graph server to snapshot: %s...",
+         config.dump_snapshot().c_str());
+  SnapshotWriter writer;
+  if (!writer.Open(config.dump_snapshot())) {
+    return false;
+  }
+
+  if (!WriteShard(config, &writer) || !resource.graph()->Dump(&writer) ||
+      !resource.negative_sampler_builder()->Dump(&writer) ||
+      !resource.neighbor_sampler_builder()->Dump(&writer)) {
+    DXERROR("Failed to dump snapshot: %s.", config.dump_snapshot().c_str());
+    writer.Close();
+    return false;
+  }
+
+  if (!writer.Close()) {
+    return false;
+  }
+  DXINFO("Done.");
+  return true;
+}
+
+bool DistGraphServer::ApplyDelta(const GraphConfig& config,
+                                 const std::string& dir) {
+  DXINFO("Applying graph delta: %s...", dir.c_str());
+
+  auto generation = std::atomic_load(&generation_);
+  auto* resource = generation->resource.get();
+  auto delta =
+      GraphDelta::Create(dir, config, resource->graph()->partitioner());
+  if (!delta) {
+    return false;
+  }
+
+  // Both are built before either is published, a failed delta changes
+  // nothing.
+  vec_int_t nodes;
+  std::vector<pair_view_t> contexts;
+  auto delta_map =
+      resource->graph()->PrepareDelta(*delta, &nodes, &contexts);
+  if (!delta_map ||
+      !resource->mutable_neighbor_sampler_builder()->PrepareUpdate(nodes,
+                                                                   contexts)) {
+    DXERROR("Failed to apply graph delta: %s.", dir.c_str());
+    return false;
+  }
+  resource->PublishDeltas(std::move(delta_map));
+
+  DXINFO("Done.");
+  return true;
+}
+
+bool DistGraphServer::Reload(const GraphConfig& config, int version) {
+  DXINFO("Reloading graph version: %d...", version);
+
+  // Both graphs are in memory until the old one is released.
+  auto generation = NewGeneration(config, version);
+  if (!generation) {
+    DXERROR("Failed to reload graph version: %d.", version);
+    return false;
+  }
+  std::atomic_store(&generation_, generation);
+
+  DXINFO("Done.");
+  return true;
+}
+
+void DistGraphServer::Watch(const GraphConfig& config) {
+  // Deltas of the graph built at startup are read from 'delta_dir', those of
+  // version 'v' from 'reload_dir/v/delta'. A restarted server starts again
+  // from the graph of its config.
+  std::string delta_dir = config.delta_dir();
+  int delta_version = 1;
+  int graph_version = 0;
+  std::unique_lock<std::mutex> lock(watch_mtx_);
+  while (!watch_stop_) {
+    // Only the latest complete version is built.
+    int next_graph_version = graph_version;
+    while (!config.reload_dir().empty() &&
+           IsComplete(
+               VersionDir(config.reload_dir(), next_graph_version + 1))) {
+      ++next_graph_version;
+    }
+    std::string next_delta_dir = VersionDir(delta_dir, delta_version);
+
+    if (next_graph_version != graph_version) {
+      lock.unlock();
+      // A broken version or delta is skipped instead of being retried
+      // forever.
+      std::string dir = VersionDir(config.reload_dir(), next_graph_version);
+      if (Reload(ReloadConfig(config, dir), next_graph_version)) {
+        delta_dir = dir + "/delta";
+        delta_version = 1;
+      } else {
+        DXERROR("Skipped graph version: %s.", dir.c_str());
+      }
+      graph_version = next_graph_version;
+      lock.lock();
+    } else if (!delta_dir.empty() && IsComplete(next_delta_dir)) {
+      lock.unlock();
+      if (!ApplyDelta(config, next_delta_dir)) {
+        DXERROR("Skipped graph delta: %s.", next_delta_dir.c_str());
+      }
+      ++delta_version;
+      lock.lock();
+    } else {
+      watch_cv_.wait_for(lock, std::chrono::seconds(config.watch_interval()),
+                         [this]() { return watch_stop_; });
+    }
+  }
 }
 
 bool DistGraphServer::InitRpcServer(const GraphConfig& config) {
@@ -109,17 +332,20 @@ bool DistGraphServer::InitRpcServer(const GraphConfig& config) {
 
 // The last declaration of DistGraphServer::Name() function is to avoid compile
 // warning of extra ';'
-#define DEFINE_REQUEST_HANDLER(Name)                                           \
-  void DistGraphServer::Name() {                                               \
-    LocalGSOp* gs_op = LocalGSOpFactory::GetInstance()->LookupOrCreate(#Name); \
-    DXCHECK(gs_op != nullptr);                                                 \
-    auto* op = dynamic_cast<class ::embedx::graph_op::Name*>(gs_op);           \
-    auto rpc_type = Name##Request::rpc_type();                                 \
-    rpc_server_.RegisterRequestHandler<Name##Request, Name##Response>(         \
-        rpc_type, [op](const Name##Request& req, Name##Response* resp) {       \
-          return op->HandleRpc(req, resp);                                     \
-        });                                                                    \
-  }                                                                            \
+#define DEFINE_REQUEST_HANDLER(Name)                                          \
+  void DistGraphServer::Name() {                                              \
+    op_names_.emplace_back(#Name);                                            \
+    auto rpc_type = Name##Request::rpc_type();                                \
+    rpc_server_.RegisterRequestHandler<Name##Request, Name##Response>(        \
+        rpc_type, [this](const Name##Request& req, Name##Response* resp) {    \
+          auto generation = std::atomic_load(&generation_);                   \
+          PublishedPins pins;                                                 \
+          generation->resource->PinDeltas(&pins);                             \
+          auto* op = static_cast<class ::embedx::graph_op::Name*>(            \
+              generation->ops.at(#Name));                                     \
+          return op->HandleRpc(req, resp);                                    \
+        });                                                                   \
+  }                                                                           \
   void DistGraphServer::Name()
 
 DEFINE_REQUEST_HANDLER(MetaLookuper);
@@ -148,19 +374,36 @@ void DistGraphServer::RegisterRequestHandler() {
   CacheNodeLookuper();
 }
 
-bool DistGraphServer::Start(const GraphConfig& config) {
-  if (!InitGraphServer(config)) {
-    DXERROR("Failed to init graph server.");
-    return false;
+DistGraphServer::~DistGraphServer() {
+  if (watch_thread_.joinable()) {
+    {
+      std::lock_guard<std::mutex> guard(watch_mtx_);
+      watch_stop_ = true;
+    }
+    watch_cv_.notify_all();
+    watch_thread_.join();
   }
+}
 
+bool DistGraphServer::Start(const GraphConfig& config) {
   if (!InitRpcServer(config)) {
     DXERROR("Failed to init rpc server.");
     return false;
   }
 
+  // The ops of the handlers are created with each graph version.
   RegisterRequestHandler();
+  if (!InitGraphServer(config)) {
+    DXERROR("Failed to init graph server.");
+    return false;
+  }
+
   TouchSuccessFile(config);
+  if (!config.delta_dir().empty() || !config.reload_dir().empty()) {
+    DXINFO("Watching graph deltas in: '%s' and versions in: '%s'.",
+           config.delta_dir().c_str(), config.reload_dir().c_str());
+    watch_thread_ = std::thread([this, config]() { Watch(config); });
+  }
   rpc_server_.Run();
   return true;
 }
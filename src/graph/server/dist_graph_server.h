@@ -12,26 +12,73 @@
 #pragma once
 #include <deepx_core/ps/rpc_server.h>
 
-#include <memory>  // std::unique_ptr
+#include <condition_variable>
+#include <memory>  // std::shared_ptr, std::unique_ptr
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
+#include "src/graph/data_op/gs_op.h"
+#include "src/graph/data_op/gs_op_factory.h"
 #include "src/graph/data_op/gs_op_resource.h"
 #include "src/graph/graph_config.h"
 #include "src/graph/in_memory_graph.h"
+#include "src/io/snapshot.h"
 
 namespace embedx {
 
 class DistGraphServer {
  private:
-  std::unique_ptr<graph_op::LocalGSOpResource> resource_;
+  // A graph version with the ops serving it, replaced as a whole by Reload.
+  struct Generation {
+    std::unique_ptr<graph_op::LocalGSOpResource> resource;
+    std::unique_ptr<graph_op::LocalGSOpFactory> factory;
+    // created up front, so that handlers look them up without a lock
+    std::unordered_map<std::string, graph_op::LocalGSOp*> ops;
+  };
+
+ private:
+  // Use std::atomic_load and std::atomic_store. Requests being handled keep
+  // their generation alive, a replaced one is freed after the last of them.
+  std::shared_ptr<Generation> generation_;
+  // ops of the registered handlers
+  std::vector<std::string> op_names_;
   deepx_core::RpcServer rpc_server_;
 
+  // applies deltas and reloads while the rpc server is running
+  std::thread watch_thread_;
+  std::mutex watch_mtx_;
+  std::condition_variable watch_cv_;
+  bool watch_stop_ = false;
+
+ public:
+  ~DistGraphServer();
+
  public:
+  // Serves until Stop is called.
   bool Start(const GraphConfig& config);
+  void Stop() { rpc_server_.Stop(); }
+  // Builds the graph from text files and writes it to 'dump_snapshot', the
+  // rpc server is not started.
+  bool DumpSnapshot(const GraphConfig& config);
+  // Applies the delta in 'dir' to the running graph and neighbor sampler,
+  // see GraphDelta.
+  bool ApplyDelta(const GraphConfig& config, const std::string& dir);
+  // Builds the graph of 'config' while the running one keeps serving, then
+  // swaps it in as 'version'.
+  bool Reload(const GraphConfig& config, int version);
 
  private:
   bool InitGraphServer(const GraphConfig& config);
+  std::shared_ptr<Generation> NewGeneration(const GraphConfig& config,
+                                            int version) const;
+  static bool InitResource(const GraphConfig& config, SnapshotReader* reader,
+                           graph_op::LocalGSOpResource* resource);
   bool InitRpcServer(const GraphConfig& config);
   void RegisterRequestHandler();
+  void Watch(const GraphConfig& config);
 
  private:
 #define DECLARE_REQUEST_HANDLER(Name) void Name()
@@ -15,6 +15,8 @@
 
 #include <cinttypes>  // PRIu64
 
+#include "src/common/memory_usage.h"
+
 namespace embedx {
 
 void Indexing::Reserve(uint64_t estimated_size) {
@@ -40,10 +42,21 @@ int Indexing::Get(int_t node) const {
   }
 }
 
+bool Indexing::Lookup(int_t node, int* index) const {
+  auto it = index_map_.find(node);
+  if (it == index_map_.end()) {
+    return false;
+  }
+  *index = it->second;
+  return true;
+}
+
 bool Indexing::Find(int_t node) const {
   return index_map_.find(node) != index_map_.end();
 }
 
 size_t Indexing::Size() const noexcept { return index_map_.size(); }
 
+uint64_t Indexing::MemoryBytes() const noexcept { return MapBytes(index_map_); }
+
 }  // namespace embedx
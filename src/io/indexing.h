@@ -25,8 +25,11 @@ class Indexing {
   void Add(int_t node);
   void Emplace(int_t k, int v);
   int Get(int_t node) const;
+  bool Lookup(int_t node, int* index) const;
   bool Find(int_t node) const;
   size_t Size() const noexcept;
+  // bytes allocated by the index map
+  uint64_t MemoryBytes() const noexcept;
 };
 
 }  // namespace embedx
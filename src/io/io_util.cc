@@ -14,11 +14,40 @@
 #include <deepx_core/common/stream.h>
 #include <deepx_core/dx_log.h>
 #include <deepx_core/tensor/ll_tensor.h>
+#include <sys/stat.h>
 
-#include <sstream>  // std::istringstream
+#include <algorithm>  // std::max
+#include <sstream>    // std::istringstream
 
 namespace embedx {
 namespace io_util {
+namespace {
+
+// Smaller chunks are not worth a thread.
+constexpr uint64_t MIN_CHUNK_SIZE = 16 << 20;
+
+bool EndsWith(const std::string& str, const std::string& suffix) {
+  return str.size() >= suffix.size() &&
+         str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+// Only plain local files can be read from an offset.
+bool GetSplittableFileSize(const std::string& file, uint64_t* size) {
+  if (file.find("://") != std::string::npos || EndsWith(file, ".gz")) {
+    return false;
+  }
+
+  struct stat st;
+  if (stat(file.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) {
+    return false;
+  }
+  *size = (uint64_t)st.st_size;
+  return true;
+}
+
+}  // namespace
+
+constexpr uint64_t FileChunk::END_OF_FILE;
 
 bool ListFile(const std::string& dir, vec_str_t* files) {
   files->clear();
@@ -35,6 +64,47 @@ bool ListFile(const std::string& dir, vec_str_t* files) {
   return true;
 }
 
+bool ListFileChunk(const std::string& dir, int chunk_num,
+                   std::vector<FileChunk>* chunks) {
+  vec_str_t files;
+  if (!ListFile(dir, &files)) {
+    return false;
+  }
+
+  std::vector<uint64_t> file_sizes(files.size(), 0);
+  std::vector<bool> splittable(files.size(), false);
+  uint64_t total_size = 0;
+  for (size_t i = 0; i < files.size(); ++i) {
+    splittable[i] = GetSplittableFileSize(files[i], &file_sizes[i]);
+    total_size += file_sizes[i];
+  }
+
+  chunk_num = std::max(chunk_num, 1);
+  uint64_t chunk_size =
+      std::max((total_size + chunk_num - 1) / chunk_num, MIN_CHUNK_SIZE);
+
+  chunks->clear();
+  for (size_t i = 0; i < files.size(); ++i) {
+    if (splittable[i] && file_sizes[i] > chunk_size) {
+      SplitFile(files[i], file_sizes[i], chunk_size, chunks);
+    } else {
+      chunks->emplace_back(files[i], 0, FileChunk::END_OF_FILE);
+    }
+  }
+  return true;
+}
+
+void SplitFile(const std::string& file, uint64_t file_size,
+               uint64_t chunk_size, std::vector<FileChunk>* chunks) {
+  for (uint64_t begin = 0; begin < file_size; begin += chunk_size) {
+    uint64_t end = begin + chunk_size;
+    if (end >= file_size) {
+      end = FileChunk::END_OF_FILE;
+    }
+    chunks->emplace_back(file, begin, end);
+  }
+}
+
 uint16_t GetNodeType(int_t node) {
   return deepx_core::LLSparseTensor<float_t, int_t>::get_group_id(node);
 }
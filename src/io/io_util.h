@@ -22,7 +22,29 @@
 namespace embedx {
 namespace io_util {
 
+// Lines of 'file' starting in [begin, end).
+struct FileChunk {
+  static constexpr uint64_t END_OF_FILE = (uint64_t)-1;
+
+  std::string file;
+  uint64_t begin = 0;
+  uint64_t end = END_OF_FILE;
+
+  FileChunk() = default;
+  FileChunk(const std::string& file, uint64_t begin, uint64_t end)
+      : file(file), begin(begin), end(end) {}
+
+  bool whole() const noexcept { return begin == 0 && end == END_OF_FILE; }
+};
+
 bool ListFile(const std::string& dir, vec_str_t* files);
+// Lists files like ListFile, large local files are further split into chunks
+// so that about 'chunk_num' workers get a similar amount of bytes no matter
+// how many files there are. Remote and compressed files are never split.
+bool ListFileChunk(const std::string& dir, int chunk_num,
+                   std::vector<FileChunk>* chunks);
+void SplitFile(const std::string& file, uint64_t file_size,
+               uint64_t chunk_size, std::vector<FileChunk>* chunks);
 
 uint16_t GetNodeType(int_t node);
 void ParseMaxNodeType(int max_num, const vec_int_t& nodes,
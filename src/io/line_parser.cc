@@ -13,6 +13,9 @@
 
 #include <deepx_core/common/str_util.h>
 
+#include <cstdint>
+#include <cstdlib>  // std::strtod
+
 #include "src/common/data_types.h"
 
 namespace embedx {
@@ -30,12 +33,184 @@ bool CheckWeightInRange(float_t weight) {
   return true;
 }
 
+/************************************************************************/
+/* Scanner */
+/************************************************************************/
+// Pointer based number scanners for the fast path, they neither allocate nor
+// depend on the locale. Each one advances '*p' past the number it read.
+inline bool IsSpace(char c) noexcept {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' ||
+         c == '\f';
+}
+
+inline bool IsDigit(char c) noexcept { return c >= '0' && c <= '9'; }
+
+inline void SkipSpace(const char** p, const char* end) noexcept {
+  while (*p != end && IsSpace(**p)) {
+    ++*p;
+  }
+}
+
+bool ScanUInt64(const char** p, const char* end, uint64_t* value) noexcept {
+  const char* cur = *p;
+  if (cur == end || !IsDigit(*cur)) {
+    return false;
+  }
+
+  uint64_t v = 0;
+  for (; cur != end && IsDigit(*cur); ++cur) {
+    uint64_t digit = (uint64_t)(*cur - '0');
+    if (v > (UINT64_MAX - digit) / 10) {
+      return false;
+    }
+    v = v * 10 + digit;
+  }
+
+  *value = v;
+  *p = cur;
+  return true;
+}
+
+// [+-]digits[.digits][(e|E)[+-]digits], rounded as std::strtod does.
+bool ScanFloat(const char** p, const char* end, float_t* value) noexcept {
+  static const double POW10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,
+                                 1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                 1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+                                 1e18, 1e19, 1e20, 1e21, 1e22};
+  constexpr uint64_t MAX_EXACT_MANTISSA = (uint64_t)1 << 53;
+
+  const char* cur = *p;
+  bool negative = false;
+  if (cur != end && (*cur == '+' || *cur == '-')) {
+    negative = *cur == '-';
+    ++cur;
+  }
+
+  uint64_t mantissa = 0;
+  int digits = 0;
+  int exp10 = 0;
+  bool exact = true;
+  for (; cur != end && IsDigit(*cur); ++cur, ++digits) {
+    if (mantissa < MAX_EXACT_MANTISSA) {
+      mantissa = mantissa * 10 + (uint64_t)(*cur - '0');
+    } else {
+      exact = false;
+    }
+  }
+  if (cur != end && *cur == '.') {
+    for (++cur; cur != end && IsDigit(*cur); ++cur, ++digits) {
+      if (mantissa < MAX_EXACT_MANTISSA) {
+        mantissa = mantissa * 10 + (uint64_t)(*cur - '0');
+        --exp10;
+      } else {
+        exact = false;
+      }
+    }
+  }
+  if (digits == 0) {
+    return false;
+  }
+
+  if (cur != end && (*cur == 'e' || *cur == 'E')) {
+    const char* exp_begin = cur + 1;
+    bool exp_negative = false;
+    if (exp_begin != end && (*exp_begin == '+' || *exp_begin == '-')) {
+      exp_negative = *exp_begin == '-';
+      ++exp_begin;
+    }
+    uint64_t exp = 0;
+    if (ScanUInt64(&exp_begin, end, &exp)) {
+      if (exp > 1000) {
+        exact = false;
+      } else {
+        exp10 += exp_negative ? -(int)exp : (int)exp;
+      }
+      cur = exp_begin;
+    }
+  }
+
+  double v = 0;
+  if (exact && mantissa <= MAX_EXACT_MANTISSA && exp10 >= -22 &&
+      exp10 <= 22) {
+    // Both operands are exact, so the result is correctly rounded.
+    v = exp10 < 0 ? (double)mantissa / POW10[-exp10]
+                  : (double)mantissa * POW10[exp10];
+    if (negative) {
+      v = -v;
+    }
+  } else {
+    // Rare, long mantissas or large exponents.
+    char* strtod_end = nullptr;
+    v = std::strtod(*p, &strtod_end);
+    if (strtod_end != cur) {
+      return false;
+    }
+  }
+
+  *value = (float_t)v;
+  *p = cur;
+  return true;
+}
+
+// id:weight, followed by a space or the end of the line.
+bool ScanPair(const char** p, const char* end, pair_t* pair) noexcept {
+  const char* cur = *p;
+  if (!ScanUInt64(&cur, end, &pair->first) || cur == end || *cur != ':') {
+    return false;
+  }
+  ++cur;
+  if (!ScanFloat(&cur, end, &pair->second) ||
+      (cur != end && !IsSpace(*cur))) {
+    return false;
+  }
+  *p = cur;
+  return true;
+}
+
+std::string TokenAt(const char* p, const char* end) {
+  const char* token_end = p;
+  while (token_end != end && !IsSpace(*token_end)) {
+    ++token_end;
+  }
+  return std::string(p, token_end);
+}
+
 }  // namespace
 
+bool LineParser::Open(const io_util::FileChunk& chunk) {
+  if (chunk.whole()) {
+    return Open(chunk.file);
+  }
+
+  Close();
+  chunk_ifs_.clear();
+  chunk_ifs_.open(chunk.file, std::ios::binary);
+  if (!chunk_ifs_) {
+    DXERROR("Failed to open file: %s.", chunk.file.c_str());
+    return false;
+  }
+
+  chunked_ = true;
+  offset_ = chunk.begin;
+  end_ = chunk.end;
+  if (offset_ > 0) {
+    // The line crossing 'begin' belongs to the previous chunk, skip it
+    // unless 'begin' is right after a newline.
+    chunk_ifs_.seekg(offset_ - 1);
+    if (!std::getline(chunk_ifs_, line_)) {
+      offset_ = end_;
+      return true;
+    }
+    offset_ += line_.size();
+  }
+  return true;
+}
+
 /************************************************************************/
 /* NodeValue */
 /************************************************************************/
-bool LineParser::ParseValue(const std::string& line, NodeValue* value) {
+bool LineParser::StreamParseValue(const std::string& line, NodeValue* value) {
+  value->weight = 1;
   iss_.clear();
   iss_.str(line);
 
@@ -53,10 +228,32 @@ bool LineParser::ParseValue(const std::string& line, NodeValue* value) {
   return true;
 }
 
+bool LineParser::FastParseValue(const std::string& line, NodeValue* value) {
+  const char* p = line.data();
+  const char* end = p + line.size();
+
+  SkipSpace(&p, end);
+  if (!ScanUInt64(&p, end, &value->node)) {
+    DXERROR("Failed to parse node from line: %s.", line.c_str());
+    return false;
+  }
+
+  // IF a NODE is made up of [node, weight].
+  value->weight = 1;
+  SkipSpace(&p, end);
+  float_t weight;
+  if (ScanFloat(&p, end, &weight) && p == end) {
+    value->weight = weight;
+  }
+
+  return true;
+}
+
 /************************************************************************/
 /* EdgeValue */
 /************************************************************************/
-bool LineParser::ParseValue(const std::string& line, EdgeValue* value) {
+bool LineParser::StreamParseValue(const std::string& line, EdgeValue* value) {
+  value->weight = 1;
   iss_.clear();
   iss_.str(line);
 
@@ -77,6 +274,32 @@ bool LineParser::ParseValue(const std::string& line, EdgeValue* value) {
   return true;
 }
 
+bool LineParser::FastParseValue(const std::string& line, EdgeValue* value) {
+  const char* p = line.data();
+  const char* end = p + line.size();
+
+  SkipSpace(&p, end);
+  bool ok = ScanUInt64(&p, end, &value->src_node);
+  SkipSpace(&p, end);
+  if (!ok || !ScanUInt64(&p, end, &value->dst_node)) {
+    DXERROR("Failed to parse edge from line: %s.", line.c_str());
+    return false;
+  }
+
+  // IF an EDGE is made up of [src_node, dst_node, weight].
+  value->weight = 1;
+  SkipSpace(&p, end);
+  float_t weight;
+  if (ScanFloat(&p, end, &weight) && p == end) {
+    if (!CheckWeightInRange(weight)) {
+      return false;
+    }
+    value->weight = weight;
+  }
+
+  return true;
+}
+
 /************************************************************************/
 /* SeqValue */
 /************************************************************************/
@@ -96,7 +319,7 @@ bool LineParser::ParseValue(const std::string& line, SeqValue* value) {
 /************************************************************************/
 /* AdjValue */
 /************************************************************************/
-bool LineParser::ParseValue(const std::string& line, AdjValue* value) {
+bool LineParser::StreamParseValue(const std::string& line, AdjValue* value) {
   // AdjValue is make up of [node, id:weight, id:weight ...]
   iss_.clear();
   iss_.str(line);
@@ -128,6 +351,36 @@ bool LineParser::ParseValue(const std::string& line, AdjValue* value) {
   return !value->pairs.empty();
 }
 
+bool LineParser::FastParseValue(const std::string& line, AdjValue* value) {
+  // AdjValue is make up of [node, id:weight, id:weight ...]
+  const char* p = line.data();
+  const char* end = p + line.size();
+
+  SkipSpace(&p, end);
+  if (!ScanUInt64(&p, end, &value->node)) {
+    DXERROR("Failed to parse node from line: %s.", line.c_str());
+    return false;
+  }
+
+  // pair, parsed into the buffer left by the previous line
+  value->pairs.clear();
+  pair_t pair;
+  for (SkipSpace(&p, end); p != end; SkipSpace(&p, end)) {
+    if (!ScanPair(&p, end, &pair)) {
+      DXERROR("The pair: %s format must be id:value.",
+              TokenAt(p, end).c_str());
+      return false;
+    }
+
+    if (!CheckWeightInRange(pair.second)) {
+      return false;
+    }
+    value->pairs.emplace_back(pair);
+  }
+
+  return !value->pairs.empty();
+}
+
 /************************************************************************/
 /* NodeAndLabelValue */
 /************************************************************************/
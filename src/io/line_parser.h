@@ -13,10 +13,12 @@
 #include <deepx_core/common/stream.h>
 #include <deepx_core/dx_log.h>
 
+#include <fstream>
 #include <sstream>  // std::istringstream
 #include <string>
 #include <vector>
 
+#include "src/io/io_util.h"
 #include "src/io/value.h"
 
 namespace embedx {
@@ -27,46 +29,95 @@ class LineParser {
   std::istringstream iss_;
   deepx_core::AutoInputFileStream ifs_;
 
+  // chunk of a local file
+  bool chunked_ = false;
+  std::ifstream chunk_ifs_;
+  uint64_t offset_ = 0;
+  uint64_t end_ = 0;
+
+  // Node, edge and adjacency lines are scanned in place instead of going
+  // through iss_.
+  bool fast_path_ = true;
+
+ public:
+  void set_fast_path(bool fast_path) noexcept { fast_path_ = fast_path; }
+
  public:
   bool Open(const std::string& file) {
-    ifs_.Close();
+    Close();
     if (!ifs_.Open(file)) {
       DXERROR("Failed to open file: %s.", file.c_str());
       return false;
     }
     return true;
   }
-  void Close() noexcept { ifs_.Close(); }
+  // Parses the lines starting in the chunk, the last one may run past
+  // 'chunk.end'.
+  bool Open(const io_util::FileChunk& chunk);
+  void Close() noexcept {
+    ifs_.Close();
+    chunk_ifs_.close();
+    chunked_ = false;
+  }
 
  public:
   template <typename ValueType>
   bool NextBatch(int batch, std::vector<ValueType>* values) {
-    values->clear();
-    ValueType value;
+    // Values are parsed in place, the buffers they own are reused from batch
+    // to batch.
+    if (values->size() < (size_t)batch) {
+      values->resize(batch);
+    }
 
-    for (;;) {
-      if (!GetLine(ifs_, line_)) {
-        break;
+    size_t size = 0;
+    while (size < (size_t)batch && NextLine()) {
+      if (ParseValue(line_, &(*values)[size])) {
+        ++size;
       }
+    }
+
+    values->resize(size);
+    return size != 0;
+  }
 
-      if (ParseValue(line_, &value)) {
-        values->emplace_back(value);
-        if (values->size() == (size_t)batch) {
-          break;
-        }
+ private:
+  bool NextLine() {
+    if (!chunked_) {
+      if (!GetLine(ifs_, line_)) {
+        return false;
       }
+      return true;
     }
 
-    return !values->empty();
+    if (offset_ >= end_ || !std::getline(chunk_ifs_, line_)) {
+      return false;
+    }
+    offset_ += line_.size() + 1;
+    return true;
   }
 
- private:
-  bool ParseValue(const std::string& line, NodeValue* node);
-  bool ParseValue(const std::string& line, EdgeValue* value);
+  bool ParseValue(const std::string& line, NodeValue* value) {
+    return fast_path_ ? FastParseValue(line, value)
+                      : StreamParseValue(line, value);
+  }
+  bool ParseValue(const std::string& line, EdgeValue* value) {
+    return fast_path_ ? FastParseValue(line, value)
+                      : StreamParseValue(line, value);
+  }
+  bool ParseValue(const std::string& line, AdjValue* value) {
+    return fast_path_ ? FastParseValue(line, value)
+                      : StreamParseValue(line, value);
+  }
   bool ParseValue(const std::string& line, SeqValue* value);
-  bool ParseValue(const std::string& line, AdjValue* value);
   bool ParseValue(const std::string& line, NodeAndLabelValue* value);
   bool ParseValue(const std::string& line, EdgeAndLabelValue* value);
+
+  bool FastParseValue(const std::string& line, NodeValue* value);
+  bool FastParseValue(const std::string& line, EdgeValue* value);
+  bool FastParseValue(const std::string& line, AdjValue* value);
+  bool StreamParseValue(const std::string& line, NodeValue* value);
+  bool StreamParseValue(const std::string& line, EdgeValue* value);
+  bool StreamParseValue(const std::string& line, AdjValue* value);
 };
 
 }  // namespace embedx
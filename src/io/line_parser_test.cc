@@ -13,10 +13,13 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdio>  // std::remove
+#include <fstream>
 #include <memory>  // std::unique_ptr
 #include <string>
 #include <vector>
 
+#include "src/io/io_util.h"
 #include "src/io/value.h"
 
 namespace embedx {
@@ -30,10 +33,33 @@ class LineParserTest : public ::testing::Test {
   const std::string FEATURE_FILE = "testdata/node_feature/feature-0";
   const std::string WALK_FILE = "testdata/walk_file";
   const std::string LABEL_FILE = "testdata/label_file";
+  const std::string TRICKY_FILE = "line_parser_test.tricky";
   const int BATCH = 2;
 
  protected:
   void SetUp() override { parser_.reset(new LineParser); }
+
+  template <typename ValueType>
+  void ExpectSameAsStream(const std::string& file) {
+    LineParser stream_parser;
+    stream_parser.set_fast_path(false);
+    EXPECT_TRUE(parser_->Open(file));
+    EXPECT_TRUE(stream_parser.Open(file));
+
+    std::vector<ValueType> values;
+    std::vector<ValueType> stream_values;
+    for (;;) {
+      bool ok = parser_->NextBatch<ValueType>(BATCH, &values);
+      EXPECT_EQ(stream_parser.NextBatch<ValueType>(BATCH, &stream_values), ok);
+      if (!ok) {
+        break;
+      }
+      ASSERT_EQ(values.size(), stream_values.size());
+      for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(values[i].ToString(), stream_values[i].ToString());
+      }
+    }
+  }
 };
 
 TEST_F(LineParserTest, NextBatch_Node) {
@@ -156,4 +182,69 @@ TEST_F(LineParserTest, NextBatch_NodeAndLabel) {
   EXPECT_FALSE(parser_->NextBatch<NodeAndLabelValue>(BATCH, &values));
 }
 
+TEST_F(LineParserTest, FastPath) {
+  std::ofstream ofs(TRICKY_FILE);
+  ofs << "1 2:1e-1 3:-0.5\t4:+2.50\n"
+      << "  5 6:1.1   7:0.0000001  \n"
+      << "8 9:0.123456789012345678901234567890\n"
+      << "12 13:1.5:2\n"
+      << "14 15:11\n"
+      << "\n"
+      << "16 17:3\n";
+  ofs.close();
+
+  ExpectSameAsStream<NodeValue>(CONTEXT);
+  ExpectSameAsStream<AdjValue>(CONTEXT);
+  ExpectSameAsStream<AdjValue>(FEATURE_FILE);
+  ExpectSameAsStream<EdgeValue>(WALK_FILE);
+  ExpectSameAsStream<AdjValue>(TRICKY_FILE);
+  ExpectSameAsStream<NodeValue>(TRICKY_FILE);
+
+  // The stream parser throws on invalid numbers, the fast path skips them.
+  ofs.open(TRICKY_FILE);
+  ofs << "10 11:x\n"
+      << "12 13:3\n";
+  ofs.close();
+
+  std::vector<AdjValue> values;
+  EXPECT_TRUE(parser_->Open(TRICKY_FILE));
+  EXPECT_TRUE(parser_->NextBatch<AdjValue>(BATCH, &values));
+  ASSERT_EQ(values.size(), 1u);
+  EXPECT_EQ(values[0].node, 12u);
+  EXPECT_FALSE(parser_->NextBatch<AdjValue>(BATCH, &values));
+  std::remove(TRICKY_FILE.c_str());
+}
+
+TEST_F(LineParserTest, NextBatch_Chunk) {
+  std::vector<std::string> expected;
+  std::vector<AdjValue> values;
+  EXPECT_TRUE(parser_->Open(CONTEXT));
+  while (parser_->NextBatch<AdjValue>(BATCH, &values)) {
+    for (const auto& value : values) {
+      expected.emplace_back(value.ToString());
+    }
+  }
+
+  std::ifstream ifs(CONTEXT, std::ios::binary | std::ios::ate);
+  uint64_t file_size = (uint64_t)ifs.tellg();
+  EXPECT_GT(file_size, 0u);
+
+  // Every line is parsed once, whatever the chunk size is.
+  for (uint64_t chunk_size = 1; chunk_size <= file_size + 1; ++chunk_size) {
+    std::vector<io_util::FileChunk> chunks;
+    io_util::SplitFile(CONTEXT, file_size, chunk_size, &chunks);
+
+    std::vector<std::string> actual;
+    for (const auto& chunk : chunks) {
+      EXPECT_TRUE(parser_->Open(chunk));
+      while (parser_->NextBatch<AdjValue>(BATCH, &values)) {
+        for (const auto& value : values) {
+          actual.emplace_back(value.ToString());
+        }
+      }
+    }
+    EXPECT_EQ(actual, expected);
+  }
+}
+
 }  // namespace embedx
@@ -29,15 +29,13 @@ constexpr int BATCH = 128;
 
 class ContextLoader : public Loader {
  private:
-  int shard_num_ = 1;
-  int shard_id_ = 0;
   std::unique_ptr<Storage> store_;
 
  public:
   explicit ContextLoader(int shard_num = 1, int shard_id = 0,
-                         int store_type = 0)
-      : shard_num_(shard_num), shard_id_(shard_id) {
-    store_ = NewContextStorage(store_type);
+                         int store_type = 0, int partition_num = 1)
+      : Loader(shard_num, shard_id) {
+    store_ = NewContextStorage(store_type, partition_num);
   }
 
   ~ContextLoader() override = default;
@@ -47,17 +45,28 @@ class ContextLoader : public Loader {
   void Reserve(uint64_t estimated_size) override {
     store_->Reserve(estimated_size);
   }
+  void Freeze() override {
+    store_->Freeze();
+    if (build_in_degree_) {
+      store_->BuildInDegree(thread_num_);
+    }
+  }
+  bool Attach(SnapshotReader* reader) override {
+    return store_->Attach(reader);
+  }
   const Storage* storage() const noexcept override { return store_.get(); }
 
  private:
-  bool LoadEntry(const vec_str_t& files, int thread_id) override {
+  bool LoadEntry(const std::vector<io_util::FileChunk>& chunks,
+                 int thread_id) override {
     std::vector<AdjValue> values;
     LineParser line_parser;
 
-    for (const auto& file : files) {
-      DXINFO("Thread: %d is processing file: %s.", thread_id, file.c_str());
+    for (const auto& chunk : chunks) {
+      DXINFO("Thread: %d is processing file: %s.", thread_id,
+             chunk.file.c_str());
 
-      if (!line_parser.Open(file)) {
+      if (!line_parser.Open(chunk)) {
         return false;
       }
 
@@ -65,7 +74,7 @@ class ContextLoader : public Loader {
         store_->Lock();
 
         for (auto& value : values) {
-          if (Loader::PartOfShard(value.node, shard_num_, shard_id_)) {
+          if (PartOfShard(value.node)) {
             if (!store_->InsertContext(&value)) {
               store_->UnLock();
               return false;
@@ -83,9 +92,10 @@ class ContextLoader : public Loader {
 };
 
 std::unique_ptr<Loader> NewContextLoader(int shard_num, int shard_id,
-                                         int store_type) {
+                                         int store_type, int partition_num) {
   std::unique_ptr<Loader> node_loader;
-  node_loader.reset(new ContextLoader(shard_num, shard_id, store_type));
+  node_loader.reset(
+      new ContextLoader(shard_num, shard_id, store_type, partition_num));
   return node_loader;
 }
 
@@ -27,6 +27,7 @@ class ContextLoaderTest : public ::testing::Test {
   const std::string CONTEXT = "testdata/context";
   const int THREAD_NUM = 3;
   const uint64_t ESTIMATED_SIZE = 10;
+  const int PARTITION_NUM = 4;
 
   int shard_num_ = 1;
   int shard_id_ = 0;
@@ -36,6 +37,7 @@ class ContextLoaderTest : public ::testing::Test {
     loader->Clear();
     loader->Reserve(ESTIMATED_SIZE);
     EXPECT_TRUE(loader->Load(CONTEXT, THREAD_NUM));
+    loader->Freeze();
 
     const auto* store = loader->storage();
     EXPECT_EQ(store->Size(), 13u);
@@ -50,6 +52,7 @@ class ContextLoaderTest : public ::testing::Test {
     loader->Clear();
     loader->Reserve(ESTIMATED_SIZE);
     EXPECT_TRUE(loader->Load(CONTEXT, THREAD_NUM));
+    loader->Freeze();
 
     const auto* store = loader->storage();
     EXPECT_EQ(store->Size(), 7u);
@@ -72,6 +75,7 @@ class ContextLoaderTest : public ::testing::Test {
     loader->Clear();
     loader->Reserve(ESTIMATED_SIZE);
     EXPECT_TRUE(loader->Load(CONTEXT, THREAD_NUM));
+    loader->Freeze();
 
     const auto* store = loader->storage();
     EXPECT_EQ(store->Size(), 6u);
@@ -102,6 +106,10 @@ TEST_F(ContextLoaderTest, Load_Local_AdjList) {
   loader_ =
       NewContextLoader(shard_num_, shard_id_, (int)AdjacencyEnum::ADJ_MATRIX);
   TestLocal(loader_.get());
+
+  loader_ =
+      NewContextLoader(shard_num_, shard_id_, (int)AdjacencyEnum::ADJ_CSR);
+  TestLocal(loader_.get());
 }
 
 TEST_F(ContextLoaderTest, Load_Remote_AdjList) {
@@ -134,4 +142,51 @@ TEST_F(ContextLoaderTest, Load_Remote__AdjMatrix) {
   TestRemoteShard1(loader_.get());
 }
 
+TEST_F(ContextLoaderTest, Load_Remote_AdjCsr) {
+  // shard 0
+  shard_num_ = 2;
+  shard_id_ = 0;
+  loader_ =
+      NewContextLoader(shard_num_, shard_id_, (int)AdjacencyEnum::ADJ_CSR);
+  TestRemoteShard0(loader_.get());
+
+  // shard 1
+  shard_id_ = 1;
+  loader_ =
+      NewContextLoader(shard_num_, shard_id_, (int)AdjacencyEnum::ADJ_CSR);
+  TestRemoteShard1(loader_.get());
+}
+
+TEST_F(ContextLoaderTest, Load_Partitioned) {
+  for (auto type : {AdjacencyEnum::ADJ_LIST, AdjacencyEnum::ADJ_MATRIX,
+                    AdjacencyEnum::ADJ_CSR}) {
+    loader_ = NewContextLoader(1, 0, (int)type, PARTITION_NUM);
+    TestLocal(loader_.get());
+    EXPECT_EQ(loader_->storage()->Keys().size(), 13u);
+
+    loader_ = NewContextLoader(2, 0, (int)type, PARTITION_NUM);
+    TestRemoteShard0(loader_.get());
+
+    loader_ = NewContextLoader(2, 1, (int)type, PARTITION_NUM);
+    TestRemoteShard1(loader_.get());
+  }
+}
+
+TEST_F(ContextLoaderTest, SkipInDegree) {
+  for (auto type : {AdjacencyEnum::ADJ_LIST, AdjacencyEnum::ADJ_MATRIX,
+                    AdjacencyEnum::ADJ_CSR, AdjacencyEnum::ADJ_COMPRESSED}) {
+    loader_ = NewContextLoader(1, 0, (int)type);
+    loader_->set_build_in_degree(false);
+    EXPECT_TRUE(loader_->Load(CONTEXT, THREAD_NUM));
+    loader_->Freeze();
+
+    const auto* store = loader_->storage();
+    EXPECT_EQ(store->Size(), 13u);
+    for (auto node : store->Keys()) {
+      EXPECT_EQ(store->GetInDegree(node), 0);
+      EXPECT_EQ(store->GetOutDegree(node), 3);
+    }
+  }
+}
+
 }  // namespace embedx
@@ -11,12 +11,17 @@
 
 #include <deepx_core/dx_log.h>
 
-#include <memory>  // std::unique_ptr
+#include <algorithm>  // std::min
+#include <memory>     // std::unique_ptr
+#include <string>
+#include <utility>    // std::move
 #include <vector>
 
 #include "src/common/data_types.h"
 #include "src/io/line_parser.h"
+#include "src/io/io_util.h"
 #include "src/io/loader/loader.h"
+#include "src/io/storage/edge_vector.h"
 #include "src/io/storage/storage.h"
 #include "src/io/value.h"
 
@@ -27,16 +32,20 @@ constexpr int BATCH = 128;
 
 }
 
+// Builds the csr of the edges with two passes over the files, see
+// EdgeVector.
 class EdgeLoader : public Loader {
  private:
-  int shard_num_;
-  int shard_id_;
+  EdgeVector* edges_;
   std::unique_ptr<Storage> store_;
+  bool scattering_ = false;
 
  public:
   explicit EdgeLoader(int shard_num = 1, int shard_id = 0, int store_type = 0)
-      : shard_num_(shard_num), shard_id_(shard_id) {
-    store_ = NewEdgeStorage(store_type);
+      : Loader(shard_num, shard_id) {
+    auto edges = NewEdgeVector(store_type);
+    edges_ = edges.get();
+    store_ = NewEdgeStorage(std::move(edges));
   }
 
   ~EdgeLoader() override = default;
@@ -46,33 +55,73 @@ class EdgeLoader : public Loader {
   void Reserve(uint64_t estimated_size) override {
     store_->Reserve(estimated_size);
   }
+  void Freeze() override { store_->Freeze(); }
+  bool Attach(SnapshotReader* reader) override {
+    return store_->Attach(reader);
+  }
   const Storage* storage() const noexcept override { return store_.get(); }
 
+ public:
+  // Replaces the edges with those of 'path'.
+  bool Load(const std::string& path, int thread_num) override {
+    thread_num_ = thread_num;
+    std::vector<io_util::FileChunk> chunks;
+    if (!io_util::ListFileChunk(path, thread_num, &chunks)) {
+      return false;
+    }
+
+    thread_num = std::min(thread_num, (int)chunks.size());
+    auto load_entry = [this](const std::vector<io_util::FileChunk>& chunks,
+                             int thread_id) {
+      return LoadEntry(chunks, thread_id);
+    };
+
+    edges_->BeginCount(thread_num);
+    scattering_ = false;
+    if (!io_util::ParallelProcess<io_util::FileChunk>(chunks, load_entry,
+                                                      thread_num)) {
+      DXERROR("Failed to count edges.");
+      return false;
+    }
+
+    edges_->BeginScatter();
+    scattering_ = true;
+    if (!io_util::ParallelProcess<io_util::FileChunk>(chunks, load_entry,
+                                                      thread_num)) {
+      DXERROR("Failed to scatter edges.");
+      return false;
+    }
+    edges_->EndScatter();
+    return true;
+  }
+
  private:
-  bool LoadEntry(const vec_str_t& files, int thread_id) override {
+  // Runs the current pass over 'chunks'.
+  bool LoadEntry(const std::vector<io_util::FileChunk>& chunks,
+                 int thread_id) override {
     std::vector<EdgeValue> values;
     LineParser line_parser;
 
-    for (const auto& file : files) {
-      DXINFO("Thread: %d is processing file: %s.", thread_id, file.c_str());
+    for (const auto& chunk : chunks) {
+      DXINFO("Thread: %d is %s file: %s.", thread_id,
+             scattering_ ? "scattering" : "counting", chunk.file.c_str());
 
-      if (!line_parser.Open(file)) {
+      if (!line_parser.Open(chunk)) {
         return false;
       }
 
       while (line_parser.NextBatch<EdgeValue>(BATCH, &values)) {
-        store_->Lock();
-
-        for (auto& value : values) {
-          if (Loader::PartOfShard(value.src_node, shard_num_, shard_id_)) {
-            if (!store_->InsertEdge(&value)) {
-              store_->UnLock();
-              return false;
-            }
+        for (const auto& value : values) {
+          if (!PartOfShard(value.src_node)) {
+            continue;
           }
-        }
 
-        store_->UnLock();
+          if (!scattering_) {
+            edges_->Count(thread_id, value);
+          } else if (!edges_->Scatter(thread_id, value)) {
+            return false;
+          }
+        }
       }
     }
 
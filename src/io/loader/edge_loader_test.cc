@@ -0,0 +1,83 @@
+// Tencent is pleased to support the open source community by making embedx
+// available.
+//
+// Copyright (C) 2021 THL A29 Limited, a Tencent company.  All rights reserved.
+//
+// Licensed under the BSD 3-Clause License and other third-party components,
+// please refer to LICENSE for details.
+//
+
+#include <gtest/gtest.h>
+
+#include <memory>  // std::unique_ptr
+#include <string>
+
+#include "src/common/data_types.h"
+#include "src/io/loader/loader.h"
+
+namespace embedx {
+
+class EdgeLoaderTest : public ::testing::Test {
+ protected:
+  std::unique_ptr<Loader> loader_;
+
+ protected:
+  const std::string EDGE = "testdata/edge";
+  const uint64_t ESTIMATED_SIZE = 10;
+
+ protected:
+  void ExpectNeighbor(int_t node, const vec_pair_t& expected) const {
+    auto neighbor = loader_->storage()->FindNeighbor(node);
+    ASSERT_EQ(neighbor.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+      EXPECT_EQ(neighbor[i].first, expected[i].first);
+      EXPECT_FLOAT_EQ(neighbor[i].second, expected[i].second);
+    }
+  }
+};
+
+TEST_F(EdgeLoaderTest, Load) {
+  loader_ = NewEdgeLoader();
+  loader_->Reserve(ESTIMATED_SIZE);
+  ASSERT_TRUE(loader_->Load(EDGE, 1));
+  loader_->Freeze();
+
+  const auto* store = loader_->storage();
+  EXPECT_EQ(store->Size(), 6u);
+  EXPECT_EQ(store->Keys(), vec_int_t({0, 1, 2}));
+
+  // edges of a src node are contiguous, in file order
+  ExpectNeighbor(0, {{1, 1.5}, {2, 1}, {3, 1}});
+  ExpectNeighbor(1, {{2, 0.5}, {0, 1}});
+  ExpectNeighbor(2, {{0, 2}});
+  ExpectNeighbor(3, {});
+  EXPECT_EQ(store->Print(3), "src_node:1 dst_node:2 weight:0.5");
+
+  EXPECT_EQ(store->GetOutDegree(0), 3);
+  EXPECT_EQ(store->GetOutDegree(3), 0);
+  EXPECT_EQ(store->GetInDegree(0), 2);
+  EXPECT_EQ(store->GetInDegree(2), 2);
+  EXPECT_EQ(store->GetInDegree(3), 1);
+
+  // reloading replaces the edges
+  ASSERT_TRUE(loader_->Load(EDGE, 3));
+  EXPECT_EQ(store->Size(), 6u);
+  EXPECT_EQ(store->GetOutDegree(0), 3);
+  EXPECT_EQ(store->GetInDegree(0), 2);
+}
+
+TEST_F(EdgeLoaderTest, Shard) {
+  loader_ = NewEdgeLoader(2, 0);
+  ASSERT_TRUE(loader_->Load(EDGE, 2));
+  loader_->Freeze();
+
+  const auto* store = loader_->storage();
+  EXPECT_EQ(store->Size(), 4u);
+  EXPECT_EQ(store->Keys(), vec_int_t({0, 2}));
+  EXPECT_EQ(store->GetOutDegree(1), 0);
+  // edges from other shards are not counted
+  EXPECT_EQ(store->GetInDegree(0), 1);
+  EXPECT_EQ(store->GetInDegree(2), 1);
+}
+
+}  // namespace embedx
@@ -58,9 +58,9 @@ class FeatureLoaderTest : public ::testing::Test {
 
     for (size_t i = 0; i < store->Keys().size(); ++i) {
       auto node = store->Keys()[i];
-      auto* feature = store->FindNeighbor(node);
+      auto feature = store->FindNeighbor(node);
       EXPECT_EQ(node % 2, 0u);
-      EXPECT_EQ(feature->size(), 2u);
+      EXPECT_EQ(feature.size(), 2u);
       EXPECT_EQ(store->GetInDegree(node), 0);
       EXPECT_EQ(store->GetOutDegree(node), 0);
     }
@@ -77,9 +77,9 @@ class FeatureLoaderTest : public ::testing::Test {
 
     for (size_t i = 0; i < store->Keys().size(); ++i) {
       auto node = store->Keys()[i];
-      auto* feature = store->FindNeighbor(node);
+      auto feature = store->FindNeighbor(node);
       EXPECT_EQ(node % 2, 1u);
-      EXPECT_EQ(feature->size(), 2u);
+      EXPECT_EQ(feature.size(), 2u);
       EXPECT_EQ(store->GetInDegree(node), 0);
       EXPECT_EQ(store->GetOutDegree(node), 0);
     }
@@ -128,4 +128,22 @@ TEST_F(FeatureLoaderTest, Load_Remote_AdjMatrix) {
   TestRemoteShard1(loader_.get());
 }
 
+TEST_F(FeatureLoaderTest, Load_Partitioned) {
+  const int PARTITION_NUM = 4;
+  loader_ = NewFeatureLoader(shard_num_, shard_id_,
+                             (int)AdjacencyEnum::ADJ_LIST, PARTITION_NUM);
+  TestLocal(loader_.get());
+
+  shard_num_ = 2;
+  shard_id_ = 0;
+  loader_ = NewFeatureLoader(shard_num_, shard_id_,
+                             (int)AdjacencyEnum::ADJ_MATRIX, PARTITION_NUM);
+  TestRemoteShard0(loader_.get());
+
+  shard_id_ = 1;
+  loader_ = NewFeatureLoader(shard_num_, shard_id_,
+                             (int)AdjacencyEnum::ADJ_MATRIX, PARTITION_NUM);
+  TestRemoteShard1(loader_.get());
+}
+
 }  // namespace embedx
@@ -37,8 +37,8 @@ bool FreqFileLoader::LoadConfig(const std::string& config_file) {
 bool FreqFileLoader::LoadFreq(const std::string& dir, int thread_num) {
   DXINFO("Loading files from dir: %s.", dir.c_str());
 
-  vec_str_t freq_files;
-  if (!io_util::ListFile(dir, &freq_files)) {
+  std::vector<io_util::FileChunk> freq_chunks;
+  if (!io_util::ListFileChunk(dir, thread_num, &freq_chunks)) {
     DXERROR("Failed to list files from dir: %s.", dir.c_str());
     return false;
   }
@@ -48,11 +48,12 @@ bool FreqFileLoader::LoadFreq(const std::string& dir, int thread_num) {
   nodes_list_.resize(ns_size_);
   freqs_list_.resize(ns_size_);
 
-  thread_num = std::min(thread_num, (int)freq_files.size());
-  if (!io_util::ParallelProcess<std::string>(
-          freq_files,
-          [this](const vec_str_t& freq_files, int thread_id) {
-            return LoadFreqEntry(freq_files, thread_id);
+  thread_num = std::min(thread_num, (int)freq_chunks.size());
+  if (!io_util::ParallelProcess<io_util::FileChunk>(
+          freq_chunks,
+          [this](const std::vector<io_util::FileChunk>& freq_chunks,
+                 int thread_id) {
+            return LoadFreqEntry(freq_chunks, thread_id);
           },
           thread_num)) {
     DXERROR("Failed to load files.");
@@ -63,15 +64,17 @@ bool FreqFileLoader::LoadFreq(const std::string& dir, int thread_num) {
   return true;
 }
 
-bool FreqFileLoader::LoadFreqEntry(const vec_str_t& freq_files, int thread_id) {
+bool FreqFileLoader::LoadFreqEntry(
+    const std::vector<io_util::FileChunk>& freq_chunks, int thread_id) {
   LineParser line_parser;
   std::vector<NodeValue> node_freqs;
 
-  for (const auto& file : freq_files) {
-    DXINFO("Thread: %d is processing file: %s.", thread_id, file.c_str());
+  for (const auto& chunk : freq_chunks) {
+    DXINFO("Thread: %d is processing file: %s.", thread_id,
+           chunk.file.c_str());
 
-    if (!line_parser.Open(file)) {
-      DXERROR("Failed to open file: %s.", file.c_str());
+    if (!line_parser.Open(chunk)) {
+      DXERROR("Failed to open file: %s.", chunk.file.c_str());
       return false;
     }
 
@@ -16,6 +16,7 @@
 #include <vector>
 
 #include "src/common/data_types.h"
+#include "src/io/io_util.h"
 
 namespace embedx {
 
@@ -40,7 +41,8 @@ class FreqFileLoader {
  private:
   bool LoadConfig(const std::string& config_file);
   bool LoadFreq(const std::string& dir, int thread_num);
-  bool LoadFreqEntry(const vec_str_t& freq_files, int thread_id);
+  bool LoadFreqEntry(const std::vector<io_util::FileChunk>& freq_chunks,
+                     int thread_id);
 
  private:
   FreqFileLoader() = default;
@@ -17,66 +17,136 @@
 
 #include "src/io/io_util.h"
 #include "src/io/line_parser.h"
+#include "src/io/snapshot.h"
 #include "src/io/value.h"
 
 namespace embedx {
 namespace {
 
 constexpr int BATCH = 128;
+// first block of a binary instance file
+constexpr char BINARY_TAG[] = "inst";
 
 }  // namespace
 
 bool InstFileLoader::Load(const std::string& dir, int thread_num) {
   DXINFO("Loading files from dir: %s.", dir.c_str());
 
-  vec_str_t files;
-  if (!io_util::ListFile(dir, &files)) {
+  std::vector<io_util::FileChunk> chunks;
+  if (!io_util::ListFileChunk(dir, thread_num, &chunks)) {
     DXERROR("Failed to load files from dir: %s.", dir.c_str());
     return false;
   }
 
-  thread_num = std::min(thread_num, (int)files.size());
-  if (!io_util::ParallelProcess<std::string>(
-          files,
-          [this](const vec_str_t& files, int thread_id) {
-            return LoadEntry(files, thread_id);
+  label_offset_buf_.assign(1, 0);
+  thread_num = std::min(thread_num, (int)chunks.size());
+  if (!io_util::ParallelProcess<io_util::FileChunk>(
+          chunks,
+          [this](const std::vector<io_util::FileChunk>& chunks, int thread_id) {
+            return LoadEntry(chunks, thread_id);
           },
           thread_num)) {
     DXERROR("Failed to load files.");
     return false;
   }
+  ResetViews();
 
   DXINFO("Done.");
   return true;
 }
 
-bool InstFileLoader::LoadEntry(const vec_str_t& files, int thread_id) {
+bool InstFileLoader::LoadEntry(const std::vector<io_util::FileChunk>& chunks,
+                               int thread_id) {
   std::vector<NodeAndLabelValue> label_values;
   LineParser line_parser;
-
-  for (const auto& file : files) {
-    DXINFO("Thread: %d is processing file: %s.", thread_id, file.c_str());
-    if (!line_parser.Open(file)) {
-      DXERROR("Failed to open file: %s.", file.c_str());
+  vec_int_t insts;
+  std::vector<uint64_t> label_sizes;
+  vecl_t labels;
+
+  for (const auto& chunk : chunks) {
+    DXINFO("Thread: %d is processing file: %s.", thread_id,
+           chunk.file.c_str());
+    if (!line_parser.Open(chunk)) {
+      DXERROR("Failed to open file: %s.", chunk.file.c_str());
       return false;
     }
 
     // (node, label)
     while (line_parser.NextBatch<NodeAndLabelValue>(BATCH, &label_values)) {
-      vec_int_t batch_nodes = Collect<NodeAndLabelValue, int_t>(
-          label_values, &NodeAndLabelValue::node);
-      std::vector<vecl_t> batch_labels_list =
-          Collect<NodeAndLabelValue, vecl_t>(label_values,
-                                             &NodeAndLabelValue::labels);
-
-      std::lock_guard<std::mutex> guard(mtx_);
-      insts_.insert(insts_.end(), batch_nodes.begin(), batch_nodes.end());
-      for (auto& batch_labels : batch_labels_list) {
-        vec_labels_list_.emplace_back(batch_labels);
+      for (const auto& value : label_values) {
+        insts.emplace_back(value.node);
+        label_sizes.emplace_back(value.labels.size());
+        labels.insert(labels.end(), value.labels.begin(), value.labels.end());
       }
     }
   }
 
+  // Instances of a thread are appended at once.
+  std::lock_guard<std::mutex> guard(mtx_);
+  inst_buf_.insert(inst_buf_.end(), insts.begin(), insts.end());
+  for (auto label_size : label_sizes) {
+    label_offset_buf_.emplace_back(label_offset_buf_.back() + label_size);
+  }
+  label_buf_.insert(label_buf_.end(), labels.begin(), labels.end());
+
+  DXINFO("Done.");
+  return true;
+}
+
+bool InstFileLoader::LoadBinary(const std::string& file) {
+  DXINFO("Mapping binary instance file: %s.", file.c_str());
+
+  SnapshotReader reader;
+  if (!reader.Open(file)) {
+    return false;
+  }
+
+  std::string tag;
+  if (!reader.ReadString(&tag) || !reader.ReadArray(&insts_) ||
+      !reader.ReadArray(&label_offsets_) || !reader.ReadArray(&labels_)) {
+    DXERROR("Failed to read binary instance file: %s.", file.c_str());
+    return false;
+  }
+
+  // Offsets are not scanned, so that no page is touched before sampling.
+  if (tag != BINARY_TAG || !reader.AtEnd() ||
+      label_offsets_.size() != insts_.size() + 1 ||
+      label_offsets_.front() != 0 || label_offsets_.back() != labels_.size()) {
+    DXERROR("Invalid binary instance file: %s.", file.c_str());
+    return false;
+  }
+  file_ = reader.file();
+
+  DXINFO("Done.");
+  return true;
+}
+
+void InstFileLoader::ResetViews() {
+  insts_ = inst_buf_;
+  label_offsets_ = label_offset_buf_;
+  labels_ = label_buf_;
+}
+
+bool InstFileLoader::Dump(const std::string& file) const {
+  DXINFO("Dumping %zu instances to binary file: %s...", size(), file.c_str());
+
+  SnapshotWriter writer;
+  if (!writer.Open(file)) {
+    return false;
+  }
+
+  if (!writer.WriteString(BINARY_TAG) ||
+      !writer.WriteArray(insts_.data(), insts_.size()) ||
+      !writer.WriteArray(label_offsets_.data(), label_offsets_.size()) ||
+      !writer.WriteArray(labels_.data(), labels_.size())) {
+    DXERROR("Failed to dump binary instance file: %s.", file.c_str());
+    writer.Close();
+    return false;
+  }
+
+  if (!writer.Close()) {
+    return false;
+  }
   DXINFO("Done.");
   return true;
 }
@@ -93,4 +163,16 @@ std::unique_ptr<InstFileLoader> InstFileLoader::Create(const std::string& dir,
   return loader;
 }
 
+std::unique_ptr<InstFileLoader> InstFileLoader::CreateFromBinary(
+    const std::string& file) {
+  std::unique_ptr<InstFileLoader> loader;
+  loader.reset(new InstFileLoader());
+
+  if (!loader->LoadBinary(file)) {
+    DXERROR("Failed to create inst file loader.");
+    loader.reset();
+  }
+  return loader;
+}
+
 }  // namespace embedx
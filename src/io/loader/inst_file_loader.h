@@ -10,30 +10,56 @@
 //
 
 #pragma once
+#include <cstdint>
 #include <memory>  // std::unique_ptr
 #include <mutex>
 #include <string>
 #include <vector>
 
+#include "src/common/array_view.h"
 #include "src/common/data_types.h"
+#include "src/io/io_util.h"
+#include "src/io/mapped_file.h"
 
 namespace embedx {
 
+// Instances and their labels.
+//
+// Labels of all instances are packed into one array, labels of instance i are
+// labels[label_offsets[i], label_offsets[i + 1]). Instances loaded from text
+// files can be dumped to a binary file, which is mapped on load instead of
+// being parsed, so that trainers on one host share its pages.
 class InstFileLoader {
  private:
   std::mutex mtx_;
-  vec_int_t insts_;
-  std::vector<vecl_t> vec_labels_list_;
+  // built from text files
+  vec_int_t inst_buf_;
+  std::vector<uint64_t> label_offset_buf_;
+  vecl_t label_buf_;
+  // mapped from a binary file
+  std::shared_ptr<MappedFile> file_;
+
+  ArrayView<int_t> insts_;
+  ArrayView<uint64_t> label_offsets_;
+  ArrayView<int> labels_;
 
  public:
-  const vec_int_t& insts() const noexcept { return insts_; }
-  const std::vector<vecl_t>& vec_labels_list() const noexcept {
-    return vec_labels_list_;
+  size_t size() const noexcept { return insts_.size(); }
+  ArrayView<int_t> insts() const noexcept { return insts_; }
+  ArrayView<int> labels(size_t i) const noexcept {
+    return ArrayView<int>(labels_.data() + label_offsets_[i],
+                          label_offsets_[i + 1] - label_offsets_[i]);
   }
 
+ public:
+  bool Dump(const std::string& file) const;
+
  private:
   bool Load(const std::string& dir, int thread_num);
-  bool LoadEntry(const vec_str_t& files, int thread_id);
+  bool LoadEntry(const std::vector<io_util::FileChunk>& chunks,
+                 int thread_id);
+  bool LoadBinary(const std::string& file);
+  void ResetViews();
 
  private:
   InstFileLoader() = default;
@@ -41,6 +67,8 @@ class InstFileLoader {
  public:
   static std::unique_ptr<InstFileLoader> Create(const std::string& dir,
                                                 int thread_num);
+  static std::unique_ptr<InstFileLoader> CreateFromBinary(
+      const std::string& file);
 };
 
 }  // namespace embedx
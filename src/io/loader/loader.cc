@@ -20,16 +20,17 @@
 namespace embedx {
 
 bool Loader::Load(const std::string& path, int thread_num) {
-  vec_str_t files;
-  if (!io_util::ListFile(path, &files)) {
+  thread_num_ = thread_num;
+  std::vector<io_util::FileChunk> chunks;
+  if (!io_util::ListFileChunk(path, thread_num, &chunks)) {
     return false;
   }
 
-  thread_num = std::min(thread_num, (int)files.size());
-  if (!io_util::ParallelProcess<std::string>(
-          files,
-          [this](const vec_str_t& files, int thread_id) {
-            return LoadEntry(files, thread_id);
+  thread_num = std::min(thread_num, (int)chunks.size());
+  if (!io_util::ParallelProcess<io_util::FileChunk>(
+          chunks,
+          [this](const std::vector<io_util::FileChunk>& chunks, int thread_id) {
+            return LoadEntry(chunks, thread_id);
           },
           thread_num)) {
     DXERROR("Failed to load files.");
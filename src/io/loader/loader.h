@@ -10,38 +10,68 @@
 //
 
 #pragma once
-#include <memory>  // std::unique_ptr
+#include <memory>   // std::shared_ptr, std::unique_ptr
 #include <string>
+#include <utility>  // std::move
+#include <vector>
 
 #include "src/common/data_types.h"
+#include "src/io/io_util.h"
+#include "src/io/shard_partitioner.h"
+#include "src/io/snapshot.h"
 #include "src/io/storage/storage.h"
 
 namespace embedx {
 
 class Loader {
+ protected:
+  // threads of the last Load, reused by the passes of Freeze
+  int thread_num_ = 1;
+  bool build_in_degree_ = true;
+  int shard_id_ = 0;
+  std::shared_ptr<const ShardPartitioner> partitioner_;
+
  public:
-  Loader() = default;
+  // Nodes are hash-mod partitioned until set_partitioner.
+  explicit Loader(int shard_num = 1, int shard_id = 0)
+      : shard_id_(shard_id),
+        partitioner_(NewShardPartitioner((int)PartitionerEnum::HASH_MOD,
+                                         shard_num)) {}
   virtual ~Loader() = default;
 
  public:
   virtual void Clear() noexcept = 0;
   virtual void Reserve(uint64_t estimated_size) = 0;
+  virtual void Freeze() = 0;
+  virtual bool Attach(SnapshotReader* reader) = 0;
   virtual const Storage* storage() const noexcept = 0;
+  // Whether Freeze counts in-degrees, only needed by the importance cache
+  // and snapshots.
+  void set_build_in_degree(bool build_in_degree) noexcept {
+    build_in_degree_ = build_in_degree;
+  }
+  void set_partitioner(
+      std::shared_ptr<const ShardPartitioner> partitioner) noexcept {
+    partitioner_ = std::move(partitioner);
+  }
 
  public:
   virtual bool Load(const std::string& path, int thread_num);
-  virtual bool PartOfShard(int_t node, int shard_num, int shard_id) const {
-    return node % shard_num == (size_t)shard_id;
+  bool PartOfShard(int_t node) const {
+    return partitioner_->GetShard(node) == shard_id_;
   }
 
  protected:
-  virtual bool LoadEntry(const vec_str_t& files, int thread_id) = 0;
+  virtual bool LoadEntry(const std::vector<io_util::FileChunk>& chunks,
+                         int thread_id) = 0;
 };
 
 std::unique_ptr<Loader> NewContextLoader(int shard_num = 1, int shard_id = 0,
-                                         int store_type = 0);
+                                         int store_type = 0,
+                                         int partition_num = 1);
 std::unique_ptr<Loader> NewFeatureLoader(int shard_num = 1, int shard_id = 0,
-                                         int store_type = 0);
+                                         int store_type = 0,
+                                         int partition_num = 1);
 std::unique_ptr<Loader> NewEdgeLoader(int shard_num = 1, int shard_id = 0,
                                       int store_type = 0);
 
@@ -0,0 +1,73 @@
+// Tencent is pleased to support the open source community by making embedx
+// available.
+//
+// Copyright (C) 2021 THL A29 Limited, a Tencent company.  All rights reserved.
+//
+// Licensed under the BSD 3-Clause License and other third-party components,
+// please refer to LICENSE for details.
+//
+
+#include "src/io/mapped_file.h"
+
+#include <deepx_core/dx_log.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>  // std::strerror
+
+namespace embedx {
+
+MappedFile::~MappedFile() { Close(); }
+
+bool MappedFile::Open(const std::string& file) {
+  Close();
+
+  int fd = open(file.c_str(), O_RDONLY);
+  if (fd == -1) {
+    DXERROR("Failed to open file: %s, %s.", file.c_str(),
+            std::strerror(errno));
+    return false;
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) == -1) {
+    DXERROR("Failed to stat file: %s, %s.", file.c_str(),
+            std::strerror(errno));
+    close(fd);
+    return false;
+  }
+
+  if (st.st_size == 0) {
+    DXERROR("Couldn't map empty file: %s.", file.c_str());
+    close(fd);
+    return false;
+  }
+
+  void* addr = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  // The mapping holds its own reference to the file.
+  close(fd);
+  if (addr == MAP_FAILED) {
+    DXERROR("Failed to map file: %s, %s.", file.c_str(),
+            std::strerror(errno));
+    return false;
+  }
+
+  file_ = file;
+  data_ = static_cast<const char*>(addr);
+  size_ = (size_t)st.st_size;
+  return true;
+}
+
+void MappedFile::Close() noexcept {
+  if (data_ != nullptr) {
+    munmap(const_cast<char*>(data_), size_);
+    data_ = nullptr;
+    size_ = 0;
+  }
+  file_.clear();
+}
+
+}  // namespace embedx
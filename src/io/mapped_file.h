@@ -0,0 +1,42 @@
+// Tencent is pleased to support the open source community by making embedx
+// available.
+//
+// Copyright (C) 2021 THL A29 Limited, a Tencent company.  All rights reserved.
+//
+// Licensed under the BSD 3-Clause License and other third-party components,
+// please refer to LICENSE for details.
+//
+
+#pragma once
+#include <string>
+
+namespace embedx {
+
+// Read-only memory mapping of a local file.
+//
+// Pages are shared with the page cache, so processes mapping the same file
+// on one host share its memory.
+class MappedFile {
+ private:
+  std::string file_;
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+
+ public:
+  MappedFile() = default;
+  ~MappedFile();
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+ public:
+  bool Open(const std::string& file);
+  void Close() noexcept;
+
+ public:
+  const std::string& file() const noexcept { return file_; }
+  const char* data() const noexcept { return data_; }
+  size_t size() const noexcept { return size_; }
+  bool is_open() const noexcept { return data_ != nullptr; }
+};
+
+}  // namespace embedx
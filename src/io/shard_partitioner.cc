@@ -0,0 +1,157 @@
+// Tencent is pleased to support the open source community by making embedx
+// available.
+//
+// Copyright (C) 2021 THL A29 Limited, a Tencent company.  All rights reserved.
+//
+// Licensed under the BSD 3-Clause License and other third-party components,
+// please refer to LICENSE for details.
+//
+
+#include "src/io/shard_partitioner.h"
+
+#include <deepx_core/common/stream.h>
+#include <deepx_core/dx_log.h>
+
+#include <algorithm>  // std::is_sorted, std::upper_bound
+#include <sstream>    // std::istringstream
+#include <utility>    // std::move
+
+#include "src/common/flat_hash_map.h"
+
+namespace embedx {
+namespace {
+
+class HashModPartitioner : public ShardPartitioner {
+ public:
+  explicit HashModPartitioner(int shard_num) : ShardPartitioner(shard_num) {}
+
+ public:
+  int GetShard(int_t node) const override {
+    return (int)(node % shard_num_);
+  }
+};
+
+class RangePartitioner : public ShardPartitioner {
+ private:
+  // first node of shard i + 1
+  vec_int_t bounds_;
+
+ public:
+  explicit RangePartitioner(int shard_num) : ShardPartitioner(shard_num) {}
+
+ public:
+  bool Load(const std::string& file) {
+    deepx_core::AutoInputFileStream ifs;
+    if (!ifs.Open(file)) {
+      DXERROR("Failed to open file: %s.", file.c_str());
+      return false;
+    }
+
+    std::string line;
+    std::istringstream iss;
+    int_t node = 0;
+    while (GetLine(ifs, line)) {
+      iss.clear();
+      iss.str(line);
+      if (iss >> node) {
+        bounds_.emplace_back(node);
+      }
+    }
+
+    if (bounds_.size() + 1 != (size_t)shard_num_) {
+      DXERROR("Need %d range bounds for %d shards, got: %zu.", shard_num_ - 1,
+              shard_num_, bounds_.size());
+      return false;
+    }
+    if (!std::is_sorted(bounds_.begin(), bounds_.end())) {
+      DXERROR("Need increasing range bounds in file: %s.", file.c_str());
+      return false;
+    }
+    return true;
+  }
+
+  int GetShard(int_t node) const override {
+    return (int)(std::upper_bound(bounds_.begin(), bounds_.end(), node) -
+                 bounds_.begin());
+  }
+};
+
+class MapPartitioner : public ShardPartitioner {
+ private:
+  FlatHashMap<int_t, int> shards_;
+
+ public:
+  explicit MapPartitioner(int shard_num) : ShardPartitioner(shard_num) {}
+
+ public:
+  bool Load(const std::string& file) {
+    deepx_core::AutoInputFileStream ifs;
+    if (!ifs.Open(file)) {
+      DXERROR("Failed to open file: %s.", file.c_str());
+      return false;
+    }
+
+    std::string line;
+    std::istringstream iss;
+    int_t node = 0;
+    int shard = 0;
+    while (GetLine(ifs, line)) {
+      if (line.empty() || line[0] == '#') {
+        continue;
+      }
+
+      iss.clear();
+      iss.str(line);
+      if (!(iss >> node >> shard) || shard < 0 || shard >= shard_num_) {
+        DXERROR("Need 'node shard' with shard < %d, got line: %s.", shard_num_,
+                line.c_str());
+        return false;
+      }
+      shards_[node] = shard;
+    }
+
+    DXINFO("Loaded shards of %zu nodes.", shards_.size());
+    return true;
+  }
+
+  int GetShard(int_t node) const override {
+    auto it = shards_.find(node);
+    return it != shards_.end() ? it->second : (int)(node % shard_num_);
+  }
+};
+
+}  // namespace
+
+std::unique_ptr<ShardPartitioner> NewShardPartitioner(
+    int type, int shard_num, const std::string& partition_file) {
+  std::unique_ptr<ShardPartitioner> partitioner;
+  if (shard_num <= 0) {
+    DXERROR("Number of shard: %d must be greater than 0.", shard_num);
+    return partitioner;
+  }
+
+  switch ((PartitionerEnum)type) {
+    case PartitionerEnum::HASH_MOD:
+      partitioner.reset(new HashModPartitioner(shard_num));
+      break;
+    case PartitionerEnum::RANGE: {
+      std::unique_ptr<RangePartitioner> range(new RangePartitioner(shard_num));
+      if (range->Load(partition_file)) {
+        partitioner = std::move(range);
+      }
+    } break;
+    case PartitionerEnum::MAP: {
+      std::unique_ptr<MapPartitioner> map(new MapPartitioner(shard_num));
+      if (map->Load(partition_file)) {
+        partitioner = std::move(map);
+      }
+    } break;
+    default:
+      DXERROR("Need type: HASH_MOD(0) || RANGE(1) || MAP(2), got type: %d.",
+              type);
+      break;
+  }
+  return partitioner;
+}
+
+}  // namespace embedx
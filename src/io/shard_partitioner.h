@@ -0,0 +1,48 @@
+// Tencent is pleased to support the open source community by making embedx
+// available.
+//
+// Copyright (C) 2021 THL A29 Limited, a Tencent company.  All rights reserved.
+//
+// Licensed under the BSD 3-Clause License and other third-party components,
+// please refer to LICENSE for details.
+//
+
+#pragma once
+#include <memory>  // std::unique_ptr
+#include <string>
+
+#include "src/common/data_types.h"
+
+namespace embedx {
+
+// Maps nodes to graph server shards. Loaders keep the nodes of their shard
+// and clients send requests to the shard of each node, so both sides must
+// use the same partitioner.
+class ShardPartitioner {
+ protected:
+  int shard_num_ = 1;
+
+ public:
+  explicit ShardPartitioner(int shard_num) : shard_num_(shard_num) {}
+  virtual ~ShardPartitioner() = default;
+
+ public:
+  int shard_num() const noexcept { return shard_num_; }
+  virtual int GetShard(int_t node) const = 0;
+};
+
+enum class PartitionerEnum : int {
+  // node % shard_num
+  HASH_MOD = 0,
+  // The partition file holds shard_num - 1 increasing nodes, one per line.
+  // Shard i has the nodes in [node i - 1, node i).
+  RANGE = 1,
+  // The partition file holds lines of 'node shard', e.g. from an offline
+  // partitioner, nodes not in the file are hash-mod partitioned.
+  MAP = 2,
+};
+
+std::unique_ptr<ShardPartitioner> NewShardPartitioner(
+    int type, int shard_num, const std::string& partition_file = "");
+
+}  // namespace embedx
@@ -0,0 +1,76 @@
+// Tencent is pleased to support the open source community by making embedx
+// available.
+//
+// Copyright (C) 2021 THL A29 Limited, a Tencent company.  All rights reserved.
+//
+// Licensed under the BSD 3-Clause License and other third-party components,
+// please refer to LICENSE for details.
+//
+
+#include "src/io/shard_partitioner.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>  // std::unique_ptr
+#include <string>
+
+#include "src/common/data_types.h"
+
+namespace embedx {
+
+class ShardPartitionerTest : public ::testing::Test {
+ protected:
+  std::unique_ptr<ShardPartitioner> partitioner_;
+
+ protected:
+  const std::string RANGE = "testdata/partition/range";
+  const std::string MAP = "testdata/partition/map";
+  const int SHARD_NUM = 3;
+};
+
+TEST_F(ShardPartitionerTest, HashMod) {
+  partitioner_ =
+      NewShardPartitioner((int)PartitionerEnum::HASH_MOD, SHARD_NUM);
+  ASSERT_TRUE(partitioner_ != nullptr);
+  EXPECT_EQ(partitioner_->shard_num(), SHARD_NUM);
+  for (int_t node = 0; node < 10; ++node) {
+    EXPECT_EQ(partitioner_->GetShard(node), (int)(node % SHARD_NUM));
+  }
+}
+
+TEST_F(ShardPartitionerTest, Range) {
+  partitioner_ =
+      NewShardPartitioner((int)PartitionerEnum::RANGE, SHARD_NUM, RANGE);
+  ASSERT_TRUE(partitioner_ != nullptr);
+  // bounds: 4, 8
+  EXPECT_EQ(partitioner_->GetShard(0), 0);
+  EXPECT_EQ(partitioner_->GetShard(3), 0);
+  EXPECT_EQ(partitioner_->GetShard(4), 1);
+  EXPECT_EQ(partitioner_->GetShard(7), 1);
+  EXPECT_EQ(partitioner_->GetShard(8), 2);
+  EXPECT_EQ(partitioner_->GetShard(((int_t)1 << 48) | 1), 2);
+
+  // two bounds are not enough for four shards
+  EXPECT_TRUE(NewShardPartitioner((int)PartitionerEnum::RANGE, 4, RANGE) ==
+              nullptr);
+}
+
+TEST_F(ShardPartitionerTest, Map) {
+  partitioner_ =
+      NewShardPartitioner((int)PartitionerEnum::MAP, SHARD_NUM, MAP);
+  ASSERT_TRUE(partitioner_ != nullptr);
+  EXPECT_EQ(partitioner_->GetShard(0), 2);
+  EXPECT_EQ(partitioner_->GetShard(7), 1);
+  EXPECT_EQ(partitioner_->GetShard(((int_t)1 << 48) | 5), 0);
+  // nodes not in the map
+  EXPECT_EQ(partitioner_->GetShard(5), 2);
+  EXPECT_EQ(partitioner_->GetShard(6), 0);
+
+  // shard 2 is out of range
+  EXPECT_TRUE(NewShardPartitioner((int)PartitionerEnum::MAP, 2, MAP) ==
+              nullptr);
+  EXPECT_TRUE(NewShardPartitioner((int)PartitionerEnum::MAP, SHARD_NUM,
+                                  "testdata/partition/none") == nullptr);
+}
+
+}  // namespace embedx
@@ -0,0 +1,152 @@
+// Tencent is pleased to support the open source community by making embedx
+// available.
+//
+// Copyright (C) 2021 THL A29 Limited, a Tencent company.  All rights reserved.
+//
+// Licensed under the BSD 3-Clause License and other third-party components,
+// please refer to LICENSE for details.
+//
+
+#include "src/io/snapshot.h"
+
+#include <deepx_core/dx_log.h>
+
+#include <cinttypes>  // PRIu64
+#include <cstring>    // std::memcmp, std::memcpy
+
+#include "src/common/data_types.h"
+
+namespace embedx {
+namespace {
+
+constexpr char MAGIC[8] = {'E', 'M', 'B', 'X', 'S', 'N', 'A', 'P'};
+constexpr uint64_t ALIGNMENT = 8;
+
+struct SnapshotHeader {
+  char magic[8];
+  uint32_t version;
+  // Guards against reading a snapshot dumped with another pair_t layout.
+  uint32_t pair_size;
+};
+
+uint64_t PaddingOf(uint64_t size) {
+  return (ALIGNMENT - size % ALIGNMENT) % ALIGNMENT;
+}
+
+}  // namespace
+
+constexpr uint32_t SnapshotWriter::VERSION;
+
+/************************************************************************/
+/* SnapshotWriter */
+/************************************************************************/
+bool SnapshotWriter::Open(const std::string& file) {
+  if (!os_.Open(file)) {
+    DXERROR("Failed to open snapshot file: %s.", file.c_str());
+    return false;
+  }
+
+  SnapshotHeader header;
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.pair_size = (uint32_t)sizeof(pair_t);
+  os_.Write(&header, sizeof(header));
+  if (!os_) {
+    DXERROR("Failed to write snapshot header.");
+    return false;
+  }
+  return true;
+}
+
+bool SnapshotWriter::Close() {
+  if (!os_) {
+    DXERROR("Failed to write snapshot.");
+    os_.Close();
+    return false;
+  }
+  os_.Close();
+  return true;
+}
+
+bool SnapshotWriter::WriteBlock(const void* data, uint64_t size) {
+  static const char ZEROS[ALIGNMENT] = {0};
+  os_.Write(&size, sizeof(size));
+  if (size > 0) {
+    os_.Write(data, size);
+  }
+  uint64_t padding = PaddingOf(size);
+  if (padding > 0) {
+    os_.Write(ZEROS, padding);
+  }
+  if (!os_) {
+    DXERROR("Failed to write snapshot block, size: %" PRIu64 ".", size);
+    return false;
+  }
+  return true;
+}
+
+/************************************************************************/
+/* SnapshotReader */
+/************************************************************************/
+bool SnapshotReader::Open(const std::string& file) {
+  file_.reset(new MappedFile);
+  if (!file_->Open(file)) {
+    file_.reset();
+    return false;
+  }
+
+  SnapshotHeader header;
+  if (file_->size() < sizeof(header)) {
+    DXERROR("Snapshot file: %s is truncated.", file.c_str());
+    file_.reset();
+    return false;
+  }
+  std::memcpy(&header, file_->data(), sizeof(header));
+
+  if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+    DXERROR("File: %s is not a graph snapshot.", file.c_str());
+    file_.reset();
+    return false;
+  }
+
+  if (header.version != SnapshotWriter::VERSION ||
+      header.pair_size != sizeof(pair_t)) {
+    DXERROR(
+        "Need snapshot version: %u and pair size: %zu, got version: %u and "
+        "pair size: %u.",
+        SnapshotWriter::VERSION, sizeof(pair_t), header.version,
+        header.pair_size);
+    file_.reset();
+    return false;
+  }
+
+  cur_ = file_->data() + sizeof(header);
+  end_ = file_->data() + file_->size();
+  return true;
+}
+
+bool SnapshotReader::ReadBlock(const char** data, uint64_t* size) {
+  if ((uint64_t)(end_ - cur_) < sizeof(*size)) {
+    DXERROR("Snapshot file is truncated.");
+    return false;
+  }
+  std::memcpy(size, cur_, sizeof(*size));
+  cur_ += sizeof(*size);
+
+  uint64_t padded_size = *size + PaddingOf(*size);
+  if ((uint64_t)(end_ - cur_) < padded_size) {
+    DXERROR("Snapshot file is truncated, need block size: %" PRIu64 ".",
+            *size);
+    return false;
+  }
+  *data = cur_;
+  cur_ += padded_size;
+  return true;
+}
+
+bool SnapshotReader::CorruptBlock(uint64_t size) const {
+  DXERROR("Unexpected snapshot block size: %" PRIu64 ".", size);
+  return false;
+}
+
+}  // namespace embedx
@@ -0,0 +1,131 @@
+// Tencent is pleased to support the open source community by making embedx
+// available.
+//
+// Copyright (C) 2021 THL A29 Limited, a Tencent company.  All rights reserved.
+//
+// Licensed under the BSD 3-Clause License and other third-party components,
+// please refer to LICENSE for details.
+//
+
+#pragma once
+#include <deepx_core/common/stream.h>
+
+#include <cstdint>
+#include <memory>  // std::shared_ptr
+#include <string>
+#include <vector>
+
+#include "src/common/array_view.h"
+#include "src/io/mapped_file.h"
+
+namespace embedx {
+
+// Binary snapshot of a built graph server.
+//
+// A snapshot is a header followed by blocks, each block is its byte size
+// (uint64) and its payload padded to 8 bytes. The file is mapped on load, so
+// arrays are used in place without being parsed or copied. Arrays hold plain
+// values (numbers and pair_t) in host byte order. Bump VERSION whenever the
+// order or the layout of the blocks changes.
+class SnapshotWriter {
+ public:
+  static constexpr uint32_t VERSION = 2;
+
+ private:
+  deepx_core::AutoOutputFileStream os_;
+
+ public:
+  bool Open(const std::string& file);
+  bool Close();
+
+ public:
+  template <typename T>
+  bool WriteArray(const T* data, size_t size) {
+    return WriteBlock(data, size * sizeof(T));
+  }
+
+  template <typename T>
+  bool WriteArray(const std::vector<T>& vec) {
+    return WriteArray(vec.data(), vec.size());
+  }
+
+  template <typename T>
+  bool WriteValue(const T& value) {
+    return WriteArray(&value, 1);
+  }
+
+  bool WriteString(const std::string& str) {
+    return WriteArray(str.data(), str.size());
+  }
+
+ private:
+  bool WriteBlock(const void* data, uint64_t size);
+};
+
+class SnapshotReader {
+ private:
+  std::shared_ptr<MappedFile> file_;
+  const char* cur_ = nullptr;
+  const char* end_ = nullptr;
+
+ public:
+  bool Open(const std::string& file);
+
+ public:
+  // Views point into the mapping, holders keep file() alive.
+  const std::shared_ptr<MappedFile>& file() const noexcept { return file_; }
+  bool AtEnd() const noexcept { return cur_ == end_; }
+
+ public:
+  template <typename T>
+  bool ReadArray(ArrayView<T>* view) {
+    const char* data = nullptr;
+    uint64_t size = 0;
+    if (!ReadBlock(&data, &size)) {
+      return false;
+    }
+    if (size % sizeof(T) != 0) {
+      return CorruptBlock(size);
+    }
+    *view = ArrayView<T>(reinterpret_cast<const T*>(data), size / sizeof(T));
+    return true;
+  }
+
+  template <typename T>
+  bool ReadArray(std::vector<T>* vec) {
+    ArrayView<T> view;
+    if (!ReadArray(&view)) {
+      return false;
+    }
+    vec->assign(view.begin(), view.end());
+    return true;
+  }
+
+  template <typename T>
+  bool ReadValue(T* value) {
+    ArrayView<T> view;
+    if (!ReadArray(&view)) {
+      return false;
+    }
+    if (view.size() != 1) {
+      return CorruptBlock(view.size() * sizeof(T));
+    }
+    *value = view.front();
+    return true;
+  }
+
+  bool ReadString(std::string* str) {
+    ArrayView<char> view;
+    if (!ReadArray(&view)) {
+      return false;
+    }
+    str->assign(view.begin(), view.end());
+    return true;
+  }
+
+ private:
+  bool ReadBlock(const char** data, uint64_t* size);
+  bool CorruptBlock(uint64_t size) const;
+};
+
+}  // namespace embedx
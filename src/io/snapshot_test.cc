@@ -0,0 +1,88 @@
+// Tencent is pleased to support the open source community by making embedx
+// available.
+//
+// Copyright (C) 2021 THL A29 Limited, a Tencent company.  All rights reserved.
+//
+// Licensed under the BSD 3-Clause License and other third-party components,
+// please refer to LICENSE for details.
+//
+
+#include "src/io/snapshot.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>  // std::remove
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "src/common/data_types.h"
+
+namespace embedx {
+
+class SnapshotTest : public ::testing::Test {
+ protected:
+  const std::string SNAPSHOT_FILE = "snapshot_test.snapshot";
+
+ protected:
+  void TearDown() override { std::remove(SNAPSHOT_FILE.c_str()); }
+};
+
+TEST_F(SnapshotTest, WriteRead) {
+  vec_int_t keys = {1, 2, 3};
+  vec_pair_t pairs = {{1, 0.5}, {2, 1.5}};
+  std::string name = "user";
+
+  SnapshotWriter writer;
+  EXPECT_TRUE(writer.Open(SNAPSHOT_FILE));
+  EXPECT_TRUE(writer.WriteArray(keys));
+  EXPECT_TRUE(writer.WriteString(name));
+  EXPECT_TRUE(writer.WriteArray(pairs));
+  EXPECT_TRUE(writer.WriteValue(7));
+  EXPECT_TRUE(writer.WriteArray(vec_float_t()));
+  EXPECT_TRUE(writer.Close());
+
+  SnapshotReader reader;
+  EXPECT_TRUE(reader.Open(SNAPSHOT_FILE));
+
+  vec_int_t read_keys;
+  EXPECT_TRUE(reader.ReadArray(&read_keys));
+  EXPECT_EQ(read_keys, keys);
+
+  std::string read_name;
+  EXPECT_TRUE(reader.ReadString(&read_name));
+  EXPECT_EQ(read_name, name);
+
+  // views point into the mapping
+  ArrayView<pair_t> read_pairs;
+  EXPECT_TRUE(reader.ReadArray(&read_pairs));
+  EXPECT_EQ(read_pairs.size(), pairs.size());
+  EXPECT_EQ((uintptr_t)read_pairs.data() % alignof(pair_t), 0u);
+  for (size_t i = 0; i < pairs.size(); ++i) {
+    EXPECT_EQ(read_pairs[i], pairs[i]);
+  }
+
+  int value = 0;
+  EXPECT_TRUE(reader.ReadValue(&value));
+  EXPECT_EQ(value, 7);
+
+  vec_float_t empty;
+  EXPECT_TRUE(reader.ReadArray(&empty));
+  EXPECT_TRUE(empty.empty());
+
+  EXPECT_TRUE(reader.AtEnd());
+  EXPECT_FALSE(reader.ReadValue(&value));
+}
+
+TEST_F(SnapshotTest, Invalid) {
+  SnapshotReader reader;
+  EXPECT_FALSE(reader.Open(SNAPSHOT_FILE));
+
+  std::ofstream ofs(SNAPSHOT_FILE);
+  ofs << "not a snapshot file";
+  ofs.close();
+  EXPECT_FALSE(reader.Open(SNAPSHOT_FILE));
+}
+
+}  // namespace embedx
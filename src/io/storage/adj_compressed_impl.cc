@@ -0,0 +1,266 @@
+// Tencent is pleased to support the open source community by making embedx
+// available.
+//
+// Copyright (C) 2021 THL A29 Limited, a Tencent company.  All rights reserved.
+//
+// Licensed under the BSD 3-Clause License and other third-party components,
+// please refer to LICENSE for details.
+//
+
+#include <deepx_core/dx_log.h>
+
+#include <algorithm>  // std::rotate
+#include <atomic>
+#include <cinttypes>  // PRIu64
+#include <memory>     // std::unique_ptr
+#include <sstream>    // std::stringstream
+#include <string>
+#include <vector>
+
+#include "src/common/data_types.h"
+#include "src/io/indexing.h"
+#include "src/io/storage/adjacency_impl.h"
+#include "src/io/storage/neighbor_codec.h"
+#include "src/io/value.h"
+
+namespace embedx {
+
+// Compressed adjacency.
+//
+// Rows are encoded with EncodeNeighbor and packed into one byte array, row i
+// starts at offsets_[i]. Context weights and feature values have their own
+// codecs, e.g. quantized weights with float features.
+//
+// FindNeighbor decodes the row into a per thread buffer of the store, which
+// remembers the last row so that repeated lookups of one node (e.g. sampling
+// its neighbors) decode it only once. The returned view stays valid until the
+// same thread looks up another node in this store, or in more than
+// THREAD_CACHE_SIZE other stores.
+class AdjCompressedImpl : public AdjacencyImpl {
+ private:
+  // the last row a thread decoded from the store 'owner'
+  struct DecodeCache {
+    const AdjCompressedImpl* owner = nullptr;
+    uint64_t generation = 0;
+    int row = -1;
+    vec_pair_t pairs;
+  };
+  static constexpr int THREAD_CACHE_SIZE = 8;
+
+ private:
+  WeightCodecEnum context_codec_;
+  WeightCodecEnum feature_codec_;
+  // unique among stores, renewed by Clear
+  uint64_t generation_;
+  Indexing indexing_;
+  vec_int_t keys_;
+  std::vector<uint64_t> offsets_;
+  std::vector<uint8_t> bytes_;
+  // sorted by node
+  vec_int_t in_degree_nodes_;
+  std::vector<int> in_degrees_;
+  bool has_context_ = false;
+  bool frozen_ = false;
+
+ public:
+  AdjCompressedImpl(WeightCodecEnum context_codec,
+                    WeightCodecEnum feature_codec)
+      : context_codec_(context_codec),
+        feature_codec_(feature_codec),
+        generation_(NextGeneration()) {}
+  ~AdjCompressedImpl() override = default;
+
+ public:
+  size_t Size() const noexcept override { return keys_.size(); }
+  bool Empty() const noexcept override { return keys_.empty(); }
+  const vec_int_t& Keys() const noexcept override { return keys_; }
+
+ public:
+  void Clear() noexcept override {
+    indexing_.Clear();
+    keys_.clear();
+    offsets_.clear();
+    bytes_.clear();
+    in_degree_nodes_.clear();
+    in_degrees_.clear();
+    has_context_ = false;
+    frozen_ = false;
+    // Rows of the cleared store must not be served from the cache.
+    generation_ = NextGeneration();
+  }
+
+  void Reserve(uint64_t estimated_size) override {
+    indexing_.Reserve(estimated_size);
+    keys_.reserve(estimated_size);
+    offsets_.reserve(estimated_size);
+  }
+
+  bool AddContext(AdjValue* value) override {
+    if (!CanAdd(value->node, "graph")) {
+      return false;
+    }
+
+    AdjacencyImpl::SortByNode(&value->pairs);
+    Append(*value, context_codec_);
+    has_context_ = true;
+    return true;
+  }
+
+  bool AddFeature(AdjValue* value) override {
+    if (!CanAdd(value->node, "feature")) {
+      return false;
+    }
+
+    Append(*value, feature_codec_);
+    return true;
+  }
+
+  void Freeze() override {
+    if (frozen_) {
+      return;
+    }
+
+    keys_.shrink_to_fit();
+    offsets_.shrink_to_fit();
+    bytes_.shrink_to_fit();
+
+    in_degree_nodes_.clear();
+    in_degrees_.clear();
+
+    frozen_ = true;
+    DXINFO("Froze compressed adjacency, nodes: %zu, bytes: %zu.",
+           keys_.size(), bytes_.size());
+  }
+
+  void BuildInDegree(int thread_num) override {
+    if (has_context_) {
+      CountInDegree(thread_num, &in_degree_nodes_, &in_degrees_);
+    }
+  }
+
+  pair_view_t FindNeighbor(int_t node) const override {
+    int row = 0;
+    if (!indexing_.Lookup(node, &row)) {
+      return pair_view_t();
+    }
+    return FindNeighborAt(row);
+  }
+
+  bool LookupRow(int_t node, int* row) const override {
+    return indexing_.Lookup(node, row);
+  }
+
+  pair_view_t FindNeighborAt(int row) const override {
+    auto* cache = ThreadCache();
+    if (cache->row != row) {
+      NeighborDecoder decoder(bytes_.data() + offsets_[row]);
+      decoder.DecodeAll(&cache->pairs);
+      cache->row = row;
+    }
+    return cache->pairs;
+  }
+
+  std::string Print(int_t node) const override {
+    std::stringstream ss;
+    ss << "Key:" << node;
+    ss << " value:";
+    int row = 0;
+    if (indexing_.Lookup(node, &row)) {
+      NeighborDecoder decoder(bytes_.data() + offsets_[row]);
+      pair_t pair;
+      while (decoder.Next(&pair)) {
+        ss << " " << pair.first << ":" << pair.second;
+      }
+    } else {
+      ss << " is nullptr.";
+    }
+
+    return ss.str();
+  }
+
+  int GetInDegree(int_t node) const override {
+    return FindInDegree(in_degree_nodes_, in_degrees_, node);
+  }
+
+  int GetOutDegree(int_t node) const override {
+    int row = 0;
+    if (!indexing_.Lookup(node, &row)) {
+      return 0;
+    }
+    return (int)DecodeNeighborSize(bytes_.data() + offsets_[row]);
+  }
+
+  void CollectMemory(MemoryUsage* usage) const override {
+    usage->Add("indexing", VectorBytes(keys_) + indexing_.MemoryBytes(),
+               keys_.size());
+    uint64_t pair_num = 0;
+    for (auto offset : offsets_) {
+      pair_num += DecodeNeighborSize(bytes_.data() + offset);
+    }
+    usage->Add("neighbors", VectorBytes(offsets_) + VectorBytes(bytes_),
+               pair_num);
+    usage->Add("in_degree",
+               VectorBytes(in_degree_nodes_) + VectorBytes(in_degrees_),
+               in_degree_nodes_.size());
+  }
+
+ private:
+  static uint64_t NextGeneration() {
+    static std::atomic<uint64_t> next_generation{0};
+    return ++next_generation;
+  }
+
+  // Each thread keeps the caches of the stores it used last, most recent
+  // first, so that cleared or destroyed stores don't hold memory.
+  DecodeCache* ThreadCache() const {
+    thread_local DecodeCache caches[THREAD_CACHE_SIZE];
+    int i = 0;
+    while (i < THREAD_CACHE_SIZE - 1 &&
+           (caches[i].owner != this || caches[i].generation != generation_)) {
+      ++i;
+    }
+    // Moving the vectors keeps their buffers and the views into them.
+    std::rotate(caches, caches + i, caches + i + 1);
+    if (caches[0].owner != this || caches[0].generation != generation_) {
+      caches[0].owner = this;
+      caches[0].generation = generation_;
+      caches[0].row = -1;
+    }
+    return &caches[0];
+  }
+
+  bool CanAdd(int_t node, const char* file_type) const {
+    if (frozen_) {
+      DXERROR("Couldn't add node: %" PRIu64
+              " to a frozen compressed adjacency.",
+              node);
+      return false;
+    }
+
+    if (indexing_.Find(node)) {
+      DXERROR(
+          "Need unique node in the %s file, got duplicate node: %" PRIu64,
+          file_type, node);
+      return false;
+    }
+    return true;
+  }
+
+  void Append(const AdjValue& value, WeightCodecEnum codec) {
+    indexing_.Add(value.node);
+    keys_.emplace_back(value.node);
+    offsets_.emplace_back(bytes_.size());
+    EncodeNeighbor(value.pairs, codec, &bytes_);
+  }
+};
+
+constexpr int AdjCompressedImpl::THREAD_CACHE_SIZE;
+
+std::unique_ptr<AdjacencyImpl> NewAdjCompressedImpl(
+    WeightCodecEnum context_codec, WeightCodecEnum feature_codec) {
+  std::unique_ptr<AdjacencyImpl> adjacency_impl;
+  adjacency_impl.reset(new AdjCompressedImpl(context_codec, feature_codec));
+  return adjacency_impl;
+}
+
+}  // namespace embedx
@@ -0,0 +1,263 @@
+// Tencent is pleased to support the open source community by making embedx
+// available.
+//
+// Copyright (C) 2021 THL A29 Limited, a Tencent company.  All rights reserved.
+//
+// Licensed under the BSD 3-Clause License and other third-party components,
+// please refer to LICENSE for details.
+//
+
+#include <deepx_core/dx_log.h>
+
+#include <cinttypes>  // PRIu64
+#include <memory>     // std::shared_ptr, std::unique_ptr
+#include <sstream>    // std::stringstream
+#include <string>
+#include <vector>
+
+#include "src/common/array_view.h"
+#include "src/common/data_types.h"
+#include "src/io/indexing.h"
+#include "src/io/mapped_file.h"
+#include "src/io/snapshot.h"
+#include "src/io/storage/adjacency_impl.h"
+#include "src/io/value.h"
+
+namespace embedx {
+
+// Compressed sparse row adjacency.
+//
+// Each node is a row and all rows are packed into one array of pairs, row i
+// lives in [offsets_[i], offsets_[i + 1]). Values are appended as they are
+// loaded, Freeze() then releases the spare capacity, after which the store is
+// read-only.
+//
+// Lookups go through the views, which point to the vectors of the store or,
+// after Attach(), into a mapped snapshot.
+class AdjCsrImpl : public AdjacencyImpl {
+ private:
+  Indexing indexing_;
+  vec_int_t keys_;
+  std::vector<uint64_t> offsets_{0};
+  vec_pair_t pairs_;
+  // sorted by node
+  vec_int_t in_degree_nodes_;
+  std::vector<int> in_degrees_;
+  bool has_context_ = false;
+  bool frozen_ = false;
+
+  std::shared_ptr<MappedFile> mapped_file_;
+  ArrayView<uint64_t> offsets_view_;
+  ArrayView<pair_t> pairs_view_;
+  ArrayView<int_t> in_degree_nodes_view_;
+  ArrayView<int> in_degrees_view_;
+
+ public:
+  ~AdjCsrImpl() override = default;
+
+ public:
+  size_t Size() const noexcept override { return keys_.size(); }
+  bool Empty() const noexcept override { return keys_.empty(); }
+  const vec_int_t& Keys() const noexcept override { return keys_; }
+
+ public:
+  void Clear() noexcept override {
+    indexing_.Clear();
+    keys_.clear();
+    offsets_.assign(1, 0);
+    pairs_.clear();
+    in_degree_nodes_.clear();
+    in_degrees_.clear();
+    has_context_ = false;
+    frozen_ = false;
+    mapped_file_.reset();
+    ResetViews();
+  }
+
+  void Reserve(uint64_t estimated_size) override {
+    indexing_.Reserve(estimated_size);
+    keys_.reserve(estimated_size);
+    offsets_.reserve(estimated_size + 1);
+  }
+
+  bool AddContext(AdjValue* value) override {
+    if (!CanAdd(value->node, "graph")) {
+      return false;
+    }
+
+    AdjacencyImpl::SortByNode(&value->pairs);
+    Append(*value);
+    has_context_ = true;
+    return true;
+  }
+
+  bool AddFeature(AdjValue* value) override {
+    if (!CanAdd(value->node, "feature")) {
+      return false;
+    }
+
+    Append(*value);
+    return true;
+  }
+
+  void Freeze() override {
+    if (frozen_) {
+      return;
+    }
+
+    keys_.shrink_to_fit();
+    offsets_.shrink_to_fit();
+    pairs_.shrink_to_fit();
+
+    in_degree_nodes_.clear();
+    in_degrees_.clear();
+
+    frozen_ = true;
+    ResetViews();
+    DXINFO("Froze csr adjacency, nodes: %zu, pairs: %zu.", keys_.size(),
+           pairs_.size());
+  }
+
+  void BuildInDegree(int thread_num) override {
+    if (has_context_) {
+      CountInDegree(thread_num, &in_degree_nodes_, &in_degrees_);
+      in_degree_nodes_view_ = in_degree_nodes_;
+      in_degrees_view_ = in_degrees_;
+    }
+  }
+
+  bool Attach(SnapshotReader* reader) override {
+    Clear();
+    if (!reader->ReadArray(&keys_) || !reader->ReadArray(&offsets_view_) ||
+        !reader->ReadArray(&pairs_view_) ||
+        !reader->ReadArray(&in_degree_nodes_view_) ||
+        !reader->ReadArray(&in_degrees_view_)) {
+      DXERROR("Failed to read csr adjacency from snapshot.");
+      return false;
+    }
+
+    if (offsets_view_.size() != keys_.size() + 1 ||
+        offsets_view_.back() != pairs_view_.size() ||
+        in_degree_nodes_view_.size() != in_degrees_view_.size()) {
+      DXERROR("Invalid csr adjacency in snapshot, nodes: %zu, pairs: %zu.",
+              keys_.size(), pairs_view_.size());
+      return false;
+    }
+
+    // Only the index is rebuilt, rows stay in the mapping.
+    indexing_.Reserve(keys_.size());
+    for (auto node : keys_) {
+      indexing_.Add(node);
+    }
+    mapped_file_ = reader->file();
+    has_context_ = !in_degree_nodes_view_.empty();
+    frozen_ = true;
+    DXINFO("Attached csr adjacency, nodes: %zu, pairs: %zu.", keys_.size(),
+           pairs_view_.size());
+    return true;
+  }
+
+  pair_view_t FindNeighbor(int_t node) const override {
+    int row = 0;
+    if (!indexing_.Lookup(node, &row)) {
+      return pair_view_t();
+    }
+    return FindNeighborAt(row);
+  }
+
+  bool LookupRow(int_t node, int* row) const override {
+    return indexing_.Lookup(node, row);
+  }
+
+  pair_view_t FindNeighborAt(int row) const override {
+    return pair_view_t(pairs_view_.data() + offsets_view_[row],
+                       offsets_view_[row + 1] - offsets_view_[row]);
+  }
+
+  std::string Print(int_t node) const override {
+    std::stringstream ss;
+    ss << "Key:" << node;
+    ss << " value:";
+    auto neighbor = FindNeighbor(node);
+    if (!neighbor.empty()) {
+      for (auto& pair : neighbor) {
+        ss << " " << pair.first << ":" << pair.second;
+      }
+    } else {
+      ss << " is nullptr.";
+    }
+
+    return ss.str();
+  }
+
+  int GetInDegree(int_t node) const override {
+    return FindInDegree(in_degree_nodes_view_, in_degrees_view_, node);
+  }
+
+  int GetOutDegree(int_t node) const override {
+    int row = 0;
+    if (!indexing_.Lookup(node, &row)) {
+      return 0;
+    }
+    return (int)(offsets_view_[row + 1] - offsets_view_[row]);
+  }
+
+  void CollectMemory(MemoryUsage* usage) const override {
+    usage->Add("indexing", VectorBytes(keys_) + indexing_.MemoryBytes(),
+               keys_.size());
+    // Attached rows are counted by the bytes they map.
+    if (mapped_file_) {
+      usage->Add("neighbors",
+                 ViewBytes(offsets_view_) + ViewBytes(pairs_view_),
+                 pairs_view_.size());
+      usage->Add("in_degree",
+                 ViewBytes(in_degree_nodes_view_) + ViewBytes(in_degrees_view_),
+                 in_degree_nodes_view_.size());
+    } else {
+      usage->Add("neighbors", VectorBytes(offsets_) + VectorBytes(pairs_),
+                 pairs_.size());
+      usage->Add("in_degree",
+                 VectorBytes(in_degree_nodes_) + VectorBytes(in_degrees_),
+                 in_degree_nodes_.size());
+    }
+  }
+
+ private:
+  bool CanAdd(int_t node, const char* file_type) const {
+    if (frozen_) {
+      DXERROR("Couldn't add node: %" PRIu64 " to a frozen csr adjacency.",
+              node);
+      return false;
+    }
+
+    if (indexing_.Find(node)) {
+      DXERROR(
+          "Need unique node in the %s file, got duplicate node: %" PRIu64,
+          file_type, node);
+      return false;
+    }
+    return true;
+  }
+
+  void Append(const AdjValue& value) {
+    indexing_.Add(value.node);
+    keys_.emplace_back(value.node);
+    pairs_.insert(pairs_.end(), value.pairs.begin(), value.pairs.end());
+    offsets_.emplace_back(pairs_.size());
+  }
+
+  void ResetViews() noexcept {
+    offsets_view_ = offsets_;
+    pairs_view_ = pairs_;
+    in_degree_nodes_view_ = in_degree_nodes_;
+    in_degrees_view_ = in_degrees_;
+  }
+};
+
+std::unique_ptr<AdjacencyImpl> NewAdjCsrImpl() {
+  std::unique_ptr<AdjacencyImpl> adjacency_impl;
+  adjacency_impl.reset(new AdjCsrImpl);
+  return adjacency_impl;
+}
+
+}  // namespace embedx
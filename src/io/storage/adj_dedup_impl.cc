@@ -0,0 +1,270 @@
+// Tencent is pleased to support the open source community by making embedx
+// available.
+//
+// Copyright (C) 2021 THL A29 Limited, a Tencent company.  All rights reserved.
+//
+// Licensed under the BSD 3-Clause License and other third-party components,
+// please refer to LICENSE for details.
+//
+
+#include <deepx_core/dx_log.h>
+
+#include <algorithm>   // std::equal, std::stable_sort
+#include <cinttypes>   // PRIu64
+#include <functional>  // std::hash
+#include <memory>      // std::unique_ptr
+#include <sstream>     // std::stringstream
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "src/common/data_types.h"
+#include "src/io/indexing.h"
+#include "src/io/io_util.h"
+#include "src/io/storage/adjacency_impl.h"
+#include "src/io/value.h"
+
+namespace embedx {
+
+// Deduplicated adjacency, meant for features.
+//
+// Identical rows are stored once: each node points to a unique row, and the
+// unique rows are packed into one array of pairs like AdjCsrImpl. Freeze()
+// lays the unique rows out namespace by namespace, in the order their nodes
+// were added, so that the features of a namespace are contiguous. The store
+// is read-only after Freeze().
+class AdjDedupImpl : public AdjacencyImpl {
+ private:
+  Indexing indexing_;
+  vec_int_t keys_;
+  // unique row of each row
+  std::vector<int> uniq_rows_;
+  // unique row i lives in [offsets_[i], offsets_[i + 1])
+  std::vector<uint64_t> offsets_{0};
+  vec_pair_t pairs_;
+  // hash of a row -> unique rows with the hash, dropped by Freeze()
+  std::unordered_map<uint64_t, std::vector<int>> dedup_map_;
+  // sorted by node
+  vec_int_t in_degree_nodes_;
+  std::vector<int> in_degrees_;
+  bool has_context_ = false;
+  bool frozen_ = false;
+
+ public:
+  ~AdjDedupImpl() override = default;
+
+ public:
+  size_t Size() const noexcept override { return keys_.size(); }
+  bool Empty() const noexcept override { return keys_.empty(); }
+  const vec_int_t& Keys() const noexcept override { return keys_; }
+
+ public:
+  void Clear() noexcept override {
+    indexing_.Clear();
+    keys_.clear();
+    uniq_rows_.clear();
+    offsets_.assign(1, 0);
+    pairs_.clear();
+    dedup_map_.clear();
+    in_degree_nodes_.clear();
+    in_degrees_.clear();
+    has_context_ = false;
+    frozen_ = false;
+  }
+
+  void Reserve(uint64_t estimated_size) override {
+    indexing_.Reserve(estimated_size);
+    keys_.reserve(estimated_size);
+    uniq_rows_.reserve(estimated_size);
+  }
+
+  bool AddContext(AdjValue* value) override {
+    if (!CanAdd(value->node, "graph")) {
+      return false;
+    }
+
+    AdjacencyImpl::SortByNode(&value->pairs);
+    Append(*value);
+    has_context_ = true;
+    return true;
+  }
+
+  bool AddFeature(AdjValue* value) override {
+    if (!CanAdd(value->node, "feature")) {
+      return false;
+    }
+
+    Append(*value);
+    return true;
+  }
+
+  void Freeze() override {
+    if (frozen_) {
+      return;
+    }
+    std::unordered_map<uint64_t, std::vector<int>>().swap(dedup_map_);
+
+    // rows of each namespace in the order they were added
+    std::vector<int> rows(keys_.size());
+    for (size_t i = 0; i < rows.size(); ++i) {
+      rows[i] = (int)i;
+    }
+    std::stable_sort(rows.begin(), rows.end(), [this](int a, int b) {
+      return io_util::GetNodeType(keys_[a]) < io_util::GetNodeType(keys_[b]);
+    });
+
+    std::vector<int> new_uniq_rows(offsets_.size() - 1, -1);
+    std::vector<uint64_t> offsets{0};
+    offsets.reserve(offsets_.size());
+    vec_pair_t pairs;
+    pairs.reserve(pairs_.size());
+    for (auto row : rows) {
+      int uniq_row = uniq_rows_[row];
+      if (new_uniq_rows[uniq_row] < 0) {
+        new_uniq_rows[uniq_row] = (int)offsets.size() - 1;
+        pairs.insert(pairs.end(), pairs_.begin() + offsets_[uniq_row],
+                     pairs_.begin() + offsets_[uniq_row + 1]);
+        offsets.emplace_back(pairs.size());
+      }
+      uniq_rows_[row] = new_uniq_rows[uniq_row];
+    }
+    offsets_.swap(offsets);
+    pairs_.swap(pairs);
+
+    keys_.shrink_to_fit();
+    uniq_rows_.shrink_to_fit();
+    frozen_ = true;
+    DXINFO("Froze dedup adjacency, nodes: %zu, unique rows: %zu, pairs: %zu.",
+           keys_.size(), offsets_.size() - 1, pairs_.size());
+  }
+
+  void BuildInDegree(int thread_num) override {
+    if (has_context_) {
+      CountInDegree(thread_num, &in_degree_nodes_, &in_degrees_);
+    }
+  }
+
+  pair_view_t FindNeighbor(int_t node) const override {
+    int row = 0;
+    if (!indexing_.Lookup(node, &row)) {
+      return pair_view_t();
+    }
+    return FindNeighborAt(row);
+  }
+
+  bool LookupRow(int_t node, int* row) const override {
+    return indexing_.Lookup(node, row);
+  }
+
+  pair_view_t FindNeighborAt(int row) const override {
+    return UniqRow(uniq_rows_[row]);
+  }
+
+  std::string Print(int_t node) const override {
+    std::stringstream ss;
+    ss << "Key:" << node;
+    ss << " value:";
+    int row = 0;
+    if (indexing_.Lookup(node, &row)) {
+      for (const auto& pair : FindNeighborAt(row)) {
+        ss << " " << pair.first << ":" << pair.second;
+      }
+    } else {
+      ss << " is nullptr.";
+    }
+
+    return ss.str();
+  }
+
+  int GetInDegree(int_t node) const override {
+    return FindInDegree(in_degree_nodes_, in_degrees_, node);
+  }
+
+  int GetOutDegree(int_t node) const override {
+    int row = 0;
+    if (!indexing_.Lookup(node, &row)) {
+      return 0;
+    }
+    return (int)FindNeighborAt(row).size();
+  }
+
+  void CollectMemory(MemoryUsage* usage) const override {
+    usage->Add("indexing", VectorBytes(keys_) + indexing_.MemoryBytes(),
+               keys_.size());
+    // per pair of all rows, so that the saving of dedup shows
+    uint64_t pair_num = 0;
+    for (auto uniq_row : uniq_rows_) {
+      pair_num += offsets_[uniq_row + 1] - offsets_[uniq_row];
+    }
+    usage->Add("neighbors",
+               VectorBytes(uniq_rows_) + VectorBytes(offsets_) +
+                   VectorBytes(pairs_),
+               pair_num);
+    usage->Add("in_degree",
+               VectorBytes(in_degree_nodes_) + VectorBytes(in_degrees_),
+               in_degree_nodes_.size());
+  }
+
+ private:
+  static uint64_t HashRow(const vec_pair_t& pairs) {
+    uint64_t hash = pairs.size();
+    for (const auto& pair : pairs) {
+      hash = (hash ^ pair.first) * 0x9E3779B97F4A7C15ULL;
+      hash = (hash ^ std::hash<float_t>()(pair.second)) * 0x9E3779B97F4A7C15ULL;
+    }
+    return hash ^ (hash >> 32);
+  }
+
+  pair_view_t UniqRow(int uniq_row) const {
+    return pair_view_t(pairs_.data() + offsets_[uniq_row],
+                       offsets_[uniq_row + 1] - offsets_[uniq_row]);
+  }
+
+  bool CanAdd(int_t node, const char* file_type) const {
+    if (frozen_) {
+      DXERROR("Couldn't add node: %" PRIu64 " to a frozen dedup adjacency.",
+              node);
+      return false;
+    }
+
+    if (indexing_.Find(node)) {
+      DXERROR(
+          "Need unique node in the %s file, got duplicate node: %" PRIu64,
+          file_type, node);
+      return false;
+    }
+    return true;
+  }
+
+  void Append(const AdjValue& value) {
+    auto& candidates = dedup_map_[HashRow(value.pairs)];
+    int uniq_row = -1;
+    for (auto candidate : candidates) {
+      auto row = UniqRow(candidate);
+      if (row.size() == value.pairs.size() &&
+          std::equal(row.begin(), row.end(), value.pairs.begin())) {
+        uniq_row = candidate;
+        break;
+      }
+    }
+
+    if (uniq_row < 0) {
+      uniq_row = (int)offsets_.size() - 1;
+      pairs_.insert(pairs_.end(), value.pairs.begin(), value.pairs.end());
+      offsets_.emplace_back(pairs_.size());
+      candidates.emplace_back(uniq_row);
+    }
+
+    indexing_.Add(value.node);
+    keys_.emplace_back(value.node);
+    uniq_rows_.emplace_back(uniq_row);
+  }
+};
+
+std::unique_ptr<AdjacencyImpl> NewAdjDedupImpl() {
+  std::unique_ptr<AdjacencyImpl> adjacency_impl;
+  adjacency_impl.reset(new AdjDedupImpl);
+  return adjacency_impl;
+}
+
+}  // namespace embedx
@@ -15,8 +15,10 @@
 #include <memory>     // std::unique_ptr
 #include <sstream>    // std::stringstream
 #include <string>
+#include <vector>
 
 #include "src/common/data_types.h"
+#include "src/io/indexing.h"
 #include "src/io/storage/adjacency_impl.h"
 #include "src/io/value.h"
 
@@ -25,8 +27,13 @@ namespace embedx {
 class AdjListImpl : public AdjacencyImpl {
  private:
   vec_int_t keys_;
-  adj_list_t adj_list_;
-  index_map_t in_degree_;
+  // row of each node in keys_ and adj_list_
+  Indexing indexing_;
+  std::vector<vec_pair_t> adj_list_;
+  // sorted by node, see BuildInDegree
+  vec_int_t in_degree_nodes_;
+  std::vector<int> in_degrees_;
+  bool has_context_ = false;
 
  public:
   ~AdjListImpl() override = default;
@@ -38,19 +45,22 @@ class AdjListImpl : public AdjacencyImpl {
 
  public:
   void Clear() noexcept override {
+    indexing_.Clear();
     adj_list_.clear();
-    in_degree_.clear();
+    in_degree_nodes_.clear();
+    in_degrees_.clear();
     keys_.clear();
+    has_context_ = false;
   }
 
   void Reserve(uint64_t estimated_size) override {
+    indexing_.Reserve(estimated_size);
     adj_list_.reserve(estimated_size);
-    in_degree_.reserve(estimated_size);
     keys_.reserve(estimated_size);
   }
 
   bool AddContext(AdjValue* value) override {
-    if (FindNeighbor(value->node) != nullptr) {
+    if (indexing_.Find(value->node)) {
       DXERROR(
           "Need unique node in the graph file, got duplicate node: %" PRIu64,
           value->node);
@@ -59,51 +69,57 @@ class AdjListImpl : public AdjacencyImpl {
 
     // TODO(longsail): which sorting function to use
     AdjacencyImpl::SortByNode(&value->pairs);
+    indexing_.Add(value->node);
     keys_.emplace_back(value->node);
-    adj_list_.emplace(value->node, value->pairs);
-
-    for (auto& pair : value->pairs) {
-      auto it = in_degree_.find(pair.first);
-      if (it != in_degree_.end()) {
-        ++it->second;
-      } else {
-        in_degree_.emplace(pair.first, 1);
-      }
-    }
+    adj_list_.emplace_back(value->pairs);
+    has_context_ = true;
 
     return true;
   }
 
   bool AddFeature(AdjValue* value) override {
-    if (FindNeighbor(value->node) != nullptr) {
+    if (indexing_.Find(value->node)) {
       DXERROR(
           "Need unique node in the feature file, got duplicate node: %" PRIu64,
           value->node);
       return false;
     }
 
+    indexing_.Add(value->node);
     keys_.emplace_back(value->node);
-    adj_list_.emplace(value->node, value->pairs);
+    adj_list_.emplace_back(value->pairs);
 
     return true;
   }
 
-  const vec_pair_t* FindNeighbor(int_t node) const override {
-    auto it = adj_list_.find(node);
-    if (it != adj_list_.end()) {
-      return &it->second;
+  void BuildInDegree(int thread_num) override {
+    if (has_context_) {
+      CountInDegree(thread_num, &in_degree_nodes_, &in_degrees_);
     }
+  }
+
+  pair_view_t FindNeighbor(int_t node) const override {
+    int row = 0;
+    if (indexing_.Lookup(node, &row)) {
+      return adj_list_[row];
+    }
+
+    return pair_view_t();
+  }
 
-    return nullptr;
+  bool LookupRow(int_t node, int* row) const override {
+    return indexing_.Lookup(node, row);
   }
 
+  pair_view_t FindNeighborAt(int row) const override { return adj_list_[row]; }
+
   std::string Print(int_t node) const override {
     std::stringstream ss;
     ss << "Key:" << node;
     ss << " value:";
-    auto* it = FindNeighbor(node);
-    if (it != nullptr) {
-      for (auto& pair : *it) {
+    int row = 0;
+    if (indexing_.Lookup(node, &row)) {
+      for (auto& pair : adj_list_[row]) {
         ss << " " << pair.first << ":" << pair.second;
       }
     } else {
@@ -114,20 +130,29 @@ class AdjListImpl : public AdjacencyImpl {
   }
 
   int GetInDegree(int_t node) const override {
-    auto it = in_degree_.find(node);
-    if (it != in_degree_.end()) {
-      return it->second;
-    }
-    return 0;
+    return FindInDegree(in_degree_nodes_, in_degrees_, node);
   }
 
   int GetOutDegree(int_t node) const override {
-    auto it = adj_list_.find(node);
-    if (it != adj_list_.end()) {
-      return it->second.size();
+    int row = 0;
+    if (indexing_.Lookup(node, &row)) {
+      return adj_list_[row].size();
     }
     return 0;
   }
+
+  void CollectMemory(MemoryUsage* usage) const override {
+    usage->Add("indexing", VectorBytes(keys_) + indexing_.MemoryBytes(),
+               keys_.size());
+    uint64_t pair_num = 0;
+    for (const auto& pairs : adj_list_) {
+      pair_num += pairs.size();
+    }
+    usage->Add("neighbors", NestedVectorBytes(adj_list_), pair_num);
+    usage->Add("in_degree",
+               VectorBytes(in_degree_nodes_) + VectorBytes(in_degrees_),
+               in_degree_nodes_.size());
+  }
 };
 
 std::unique_ptr<AdjacencyImpl> NewAdjListImpl() {
@@ -20,7 +20,6 @@
 #include "src/common/data_types.h"
 #include "src/io/indexing.h"
 #include "src/io/storage/adjacency_impl.h"
-#include "src/io/storage/graph_statics.h"
 #include "src/io/value.h"
 
 namespace embedx {
@@ -28,32 +27,33 @@ namespace embedx {
 class AdjMatrixImpl : public AdjacencyImpl {
  private:
   Indexing src_indexing_;
-  Indexing dst_indexing_;
+  vec_int_t src_nodes_;
   std::vector<vec_pair_t> adj_matrix_;
-  std::unique_ptr<GraphStatics> graph_statics_;
+  // sorted by node, see BuildInDegree
+  vec_int_t in_degree_nodes_;
+  std::vector<int> in_degrees_;
+  bool has_context_ = false;
 
  public:
-  AdjMatrixImpl() {
-    graph_statics_ = NewGraphStatics(&src_indexing_, &dst_indexing_);
-  }
   ~AdjMatrixImpl() override = default;
 
  public:
   size_t Size() const noexcept override { return adj_matrix_.size(); }
   bool Empty() const noexcept override { return adj_matrix_.empty(); }
-  const vec_int_t& Keys() const noexcept override {
-    return *graph_statics_->src_node_list();
-  }
+  const vec_int_t& Keys() const noexcept override { return src_nodes_; }
 
   void Clear() noexcept override {
     src_indexing_.Clear();
-    dst_indexing_.Clear();
+    src_nodes_.clear();
     adj_matrix_.clear();
+    in_degree_nodes_.clear();
+    in_degrees_.clear();
+    has_context_ = false;
   }
 
   void Reserve(uint64_t estimated_size) override {
     src_indexing_.Reserve(estimated_size);
-    dst_indexing_.Reserve(estimated_size);
+    src_nodes_.reserve(estimated_size);
     adj_matrix_.reserve(estimated_size);
   }
 
@@ -68,15 +68,9 @@ class AdjMatrixImpl : public AdjacencyImpl {
     // TODO(longsail): which sorting function to use
     AdjacencyImpl::SortByNode(&value->pairs);
     src_indexing_.Add(value->node);
+    src_nodes_.emplace_back(value->node);
     adj_matrix_.emplace_back(value->pairs);
-
-    for (auto& pair : value->pairs) {
-      dst_indexing_.Add(pair.first);
-      // edge : [value->node, pair.first]
-      if (!graph_statics_->Add(value->node, pair.first)) {
-        return false;
-      }
-    }
+    has_context_ = true;
 
     return true;
   }
@@ -90,12 +84,19 @@ class AdjMatrixImpl : public AdjacencyImpl {
     }
 
     src_indexing_.Add(value->node);
+    src_nodes_.emplace_back(value->node);
     adj_matrix_.emplace_back(value->pairs);
 
     return true;
   }
 
-  const vec_pair_t* FindNeighbor(int_t node) const override {
+  void BuildInDegree(int thread_num) override {
+    if (has_context_) {
+      CountInDegree(thread_num, &in_degree_nodes_, &in_degrees_);
+    }
+  }
+
+  pair_view_t FindNeighbor(int_t node) const override {
     int src_index = src_indexing_.Get(node);
     int adj_matrix_size = (int)adj_matrix_.size();
     if (src_index < 0 || src_index > (int)adj_matrix_.size()) {
@@ -103,9 +104,17 @@ class AdjMatrixImpl : public AdjacencyImpl {
           "Need 0 <= src_index < adj_matrix.size(), Got src_index: %d vs "
           "adj_matrix.size(): %d",
           src_index, adj_matrix_size);
-      return nullptr;
+      return pair_view_t();
     }
-    return &adj_matrix_[src_index];
+    return adj_matrix_[src_index];
+  }
+
+  bool LookupRow(int_t node, int* row) const override {
+    return src_indexing_.Lookup(node, row);
+  }
+
+  pair_view_t FindNeighborAt(int row) const override {
+    return adj_matrix_[row];
   }
 
   std::string Print(int_t node) const override {
@@ -132,11 +141,29 @@ class AdjMatrixImpl : public AdjacencyImpl {
   }
 
   int GetInDegree(int_t node) const override {
-    return graph_statics_->GetInDegree(node);
+    return FindInDegree(in_degree_nodes_, in_degrees_, node);
   }
 
   int GetOutDegree(int_t node) const override {
-    return graph_statics_->GetOutDegree(node);
+    int row = 0;
+    if (src_indexing_.Lookup(node, &row)) {
+      return (int)adj_matrix_[row].size();
+    }
+    return 0;
+  }
+
+  void CollectMemory(MemoryUsage* usage) const override {
+    usage->Add("indexing",
+               VectorBytes(src_nodes_) + src_indexing_.MemoryBytes(),
+               src_nodes_.size());
+    uint64_t pair_num = 0;
+    for (const auto& pairs : adj_matrix_) {
+      pair_num += pairs.size();
+    }
+    usage->Add("neighbors", NestedVectorBytes(adj_matrix_), pair_num);
+    usage->Add("in_degree",
+               VectorBytes(in_degree_nodes_) + VectorBytes(in_degrees_),
+               in_degree_nodes_.size());
   }
 };
 
@@ -0,0 +1,168 @@
+// Tencent is pleased to support the open source community by making embedx
+// available.
+//
+// Copyright (C) 2021 THL A29 Limited, a Tencent company.  All rights reserved.
+//
+// Licensed under the BSD 3-Clause License and other third-party components,
+// please refer to LICENSE for details.
+//
+
+#include <algorithm>  // std::upper_bound
+#include <memory>     // std::unique_ptr
+#include <mutex>
+#include <string>
+#include <utility>  // std::move
+#include <vector>
+
+#include "src/common/data_types.h"
+#include "src/io/storage/adjacency_impl.h"
+#include "src/io/value.h"
+
+namespace embedx {
+
+// Hash partitioned adjacency.
+//
+// Nodes are spread over independent adjacencies, each guarded by its own
+// lock, so that AddContext and AddFeature may be called from many loader
+// threads at once. Keys() and rows are only valid after Freeze(), the rows of
+// partition i follow the ones of partition i - 1.
+class AdjPartitionImpl : public AdjacencyImpl {
+ private:
+  std::vector<std::unique_ptr<AdjacencyImpl>> partitions_;
+  std::unique_ptr<std::mutex[]> mtxs_;
+  vec_int_t keys_;
+  // first row of each partition
+  std::vector<int> bases_;
+
+ public:
+  explicit AdjPartitionImpl(
+      std::vector<std::unique_ptr<AdjacencyImpl>>&& partitions)
+      : partitions_(std::move(partitions)),
+        mtxs_(new std::mutex[partitions_.size()]) {}
+  ~AdjPartitionImpl() override = default;
+
+ public:
+  size_t Size() const noexcept override {
+    size_t size = 0;
+    for (const auto& partition : partitions_) {
+      size += partition->Size();
+    }
+    return size;
+  }
+
+  bool Empty() const noexcept override {
+    for (const auto& partition : partitions_) {
+      if (!partition->Empty()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  const vec_int_t& Keys() const noexcept override { return keys_; }
+
+ public:
+  void Clear() noexcept override {
+    for (auto& partition : partitions_) {
+      partition->Clear();
+    }
+    keys_.clear();
+    bases_.clear();
+  }
+
+  void Reserve(uint64_t estimated_size) override {
+    for (auto& partition : partitions_) {
+      partition->Reserve(estimated_size / partitions_.size() + 1);
+    }
+  }
+
+  bool AddContext(AdjValue* value) override {
+    size_t i = PartitionOf(value->node);
+    std::lock_guard<std::mutex> guard(mtxs_[i]);
+    return partitions_[i]->AddContext(value);
+  }
+
+  bool AddFeature(AdjValue* value) override {
+    size_t i = PartitionOf(value->node);
+    std::lock_guard<std::mutex> guard(mtxs_[i]);
+    return partitions_[i]->AddFeature(value);
+  }
+
+  void Freeze() override {
+    keys_.clear();
+    keys_.reserve(Size());
+    bases_.clear();
+    for (auto& partition : partitions_) {
+      partition->Freeze();
+      bases_.emplace_back((int)keys_.size());
+      const auto& keys = partition->Keys();
+      keys_.insert(keys_.end(), keys.begin(), keys.end());
+    }
+  }
+
+  // Each partition counts the in-degrees of its own rows, GetInDegree sums
+  // them.
+  void BuildInDegree(int thread_num) override {
+    for (auto& partition : partitions_) {
+      partition->BuildInDegree(thread_num);
+    }
+  }
+
+  pair_view_t FindNeighbor(int_t node) const override {
+    return partitions_[PartitionOf(node)]->FindNeighbor(node);
+  }
+
+  bool LookupRow(int_t node, int* row) const override {
+    size_t i = PartitionOf(node);
+    if (!partitions_[i]->LookupRow(node, row)) {
+      return false;
+    }
+    *row += bases_[i];
+    return true;
+  }
+
+  pair_view_t FindNeighborAt(int row) const override {
+    auto it = std::upper_bound(bases_.begin(), bases_.end(), row) - 1;
+    return partitions_[it - bases_.begin()]->FindNeighborAt(row - *it);
+  }
+
+  std::string Print(int_t node) const override {
+    return partitions_[PartitionOf(node)]->Print(node);
+  }
+
+  int GetInDegree(int_t node) const override {
+    // Edges pointing to the node may come from any partition.
+    int in_degree = 0;
+    for (const auto& partition : partitions_) {
+      in_degree += partition->GetInDegree(node);
+    }
+    return in_degree;
+  }
+
+  int GetOutDegree(int_t node) const override {
+    return partitions_[PartitionOf(node)]->GetOutDegree(node);
+  }
+
+  void CollectMemory(MemoryUsage* usage) const override {
+    for (const auto& partition : partitions_) {
+      partition->CollectMemory(usage);
+    }
+    usage->Add("indexing", VectorBytes(keys_) + VectorBytes(bases_), 0);
+  }
+
+ private:
+  size_t PartitionOf(int_t node) const noexcept {
+    // Nodes of one graph shard share 'node % shard_num', mix the bits before
+    // taking the modulus.
+    return (size_t)((node * 0x9E3779B97F4A7C15ULL) >> 32) % partitions_.size();
+  }
+};
+
+std::unique_ptr<AdjacencyImpl> NewAdjPartitionImpl(
+    std::vector<std::unique_ptr<AdjacencyImpl>>&& partitions) {
+  std::unique_ptr<AdjacencyImpl> adjacency_impl;
+  adjacency_impl.reset(new AdjPartitionImpl(std::move(partitions)));
+  return adjacency_impl;
+}
+
+}  // namespace embedx
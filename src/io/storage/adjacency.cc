@@ -13,11 +13,130 @@
 
 #include <deepx_core/dx_log.h>
 
-#include <utility>  // std::move
+#include <algorithm>  // std::inplace_merge, std::is_sorted, std::sort, ...
+#include <thread>
+#include <utility>    // std::move, std::pair
+#include <vector>
 
+#include "src/io/io_util.h"
 #include "src/io/storage/adjacency_impl.h"
 
 namespace embedx {
+namespace {
+
+// lists from this size are sorted by many threads
+constexpr size_t PARALLEL_SORT_SIZE = 1 << 18;
+
+bool NodeLess(const pair_t& a, const pair_t& b) noexcept {
+  return a.first < b.first;
+}
+
+// Stable sorts 'part_num' parts of 'context' at once, then merges them
+// pairwise, also at once.
+void ParallelSortByNode(int part_num, vec_pair_t* context) {
+  std::vector<size_t> bounds(part_num + 1);
+  for (int i = 0; i <= part_num; ++i) {
+    bounds[i] = context->size() * i / part_num;
+  }
+  auto begin = context->begin();
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < part_num; ++i) {
+    threads.emplace_back([&bounds, begin, i]() {
+      std::stable_sort(begin + bounds[i], begin + bounds[i + 1], NodeLess);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (int width = 1; width < part_num; width *= 2) {
+    threads.clear();
+    for (int i = 0; i + width < part_num; i += 2 * width) {
+      size_t last = bounds[std::min(i + 2 * width, part_num)];
+      threads.emplace_back([&bounds, begin, i, width, last]() {
+        std::inplace_merge(begin + bounds[i], begin + bounds[i + width],
+                           begin + last, NodeLess);
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+}
+
+}  // namespace
+
+void AdjacencyImpl::SortByNode(vec_pair_t* context) {
+  if (std::is_sorted(context->begin(), context->end(), NodeLess)) {
+    return;
+  }
+
+  size_t part_num = context->size() / PARALLEL_SORT_SIZE;
+  part_num = std::min(part_num, (size_t)std::thread::hardware_concurrency());
+  if (part_num <= 1) {
+    std::stable_sort(context->begin(), context->end(), NodeLess);
+  } else {
+    ParallelSortByNode((int)part_num, context);
+  }
+}
+
+void AdjacencyImpl::CountInDegree(int thread_num, vec_int_t* nodes,
+                                  std::vector<int>* in_degrees) const {
+  std::vector<int> rows(Size());
+  for (size_t i = 0; i < rows.size(); ++i) {
+    rows[i] = (int)i;
+  }
+
+  // sorted neighbors of the rows of each thread, then counted
+  std::vector<vec_int_t> thread_nodes(thread_num);
+  std::vector<std::vector<int>> thread_counts(thread_num);
+  io_util::ParallelProcess<int>(
+      rows,
+      [this, &thread_nodes, &thread_counts](const std::vector<int>& rows,
+                                            int thread_id) {
+        vec_int_t dst_nodes;
+        for (auto row : rows) {
+          for (const auto& pair : FindNeighborAt(row)) {
+            dst_nodes.emplace_back(pair.first);
+          }
+        }
+        std::sort(dst_nodes.begin(), dst_nodes.end());
+
+        auto* uniq_nodes = &thread_nodes[thread_id];
+        auto* counts = &thread_counts[thread_id];
+        for (auto node : dst_nodes) {
+          if (uniq_nodes->empty() || uniq_nodes->back() != node) {
+            uniq_nodes->emplace_back(node);
+            counts->emplace_back(0);
+          }
+          ++counts->back();
+        }
+        return true;
+      },
+      thread_num);
+
+  // merge
+  std::vector<std::pair<int_t, int>> node_counts;
+  for (int i = 0; i < thread_num; ++i) {
+    for (size_t j = 0; j < thread_nodes[i].size(); ++j) {
+      node_counts.emplace_back(thread_nodes[i][j], thread_counts[i][j]);
+    }
+    vec_int_t().swap(thread_nodes[i]);
+    std::vector<int>().swap(thread_counts[i]);
+  }
+  std::sort(node_counts.begin(), node_counts.end());
+
+  nodes->clear();
+  in_degrees->clear();
+  for (const auto& entry : node_counts) {
+    if (nodes->empty() || nodes->back() != entry.first) {
+      nodes->emplace_back(entry.first);
+      in_degrees->emplace_back(0);
+    }
+    in_degrees->back() += entry.second;
+  }
+}
 
 Adjacency::Adjacency(std::unique_ptr<AdjacencyImpl>&& impl) {
   impl_ = std::move(impl);
@@ -35,16 +154,34 @@ bool Adjacency::AddContext(AdjValue* value) { return impl_->AddContext(value); }
 
 bool Adjacency::AddFeature(AdjValue* value) { return impl_->AddFeature(value); }
 
+void Adjacency::Freeze() { impl_->Freeze(); }
+
+void Adjacency::BuildInDegree(int thread_num) {
+  impl_->BuildInDegree(thread_num);
+}
+
+bool Adjacency::Attach(SnapshotReader* reader) {
+  return impl_->Attach(reader);
+}
+
 size_t Adjacency::Size() const noexcept { return impl_->Size(); }
 
 bool Adjacency::Empty() const noexcept { return impl_->Empty(); }
 
 const vec_int_t& Adjacency::Keys() const noexcept { return impl_->Keys(); }
 
-const vec_pair_t* Adjacency::FindNeighbor(int_t node) const {
+pair_view_t Adjacency::FindNeighbor(int_t node) const {
   return impl_->FindNeighbor(node);
 }
 
+bool Adjacency::LookupRow(int_t node, int* row) const {
+  return impl_->LookupRow(node, row);
+}
+
+pair_view_t Adjacency::FindNeighborAt(int row) const {
+  return impl_->FindNeighborAt(row);
+}
+
 std::string Adjacency::Print(int_t node) const { return impl_->Print(node); }
 
 int Adjacency::GetInDegree(int_t dst_node) const {
@@ -55,21 +192,106 @@ int Adjacency::GetOutDegree(int_t src_node) const {
   return impl_->GetOutDegree(src_node);
 }
 
-std::unique_ptr<Adjacency> NewAdjacency(AdjacencyEnum type) {
-  std::unique_ptr<Adjacency> adjacency;
+void Adjacency::CollectMemory(MemoryUsage* usage) const {
+  impl_->CollectMemory(usage);
+}
+
+bool Adjacency::Dump(SnapshotWriter* writer) const {
+  const auto& keys = impl_->Keys();
+  std::vector<uint64_t> offsets{0};
+  offsets.reserve(keys.size() + 1);
+  vec_pair_t pairs;
+  for (auto node : keys) {
+    auto neighbor = impl_->FindNeighbor(node);
+    pairs.insert(pairs.end(), neighbor.begin(), neighbor.end());
+    offsets.emplace_back(pairs.size());
+  }
+
+  // in-degree, sorted by node
+  vec_int_t dst_nodes;
+  dst_nodes.reserve(pairs.size());
+  for (const auto& pair : pairs) {
+    dst_nodes.emplace_back(pair.first);
+  }
+  std::sort(dst_nodes.begin(), dst_nodes.end());
+  dst_nodes.erase(std::unique(dst_nodes.begin(), dst_nodes.end()),
+                  dst_nodes.end());
+
+  vec_int_t in_degree_nodes;
+  std::vector<int> in_degrees;
+  for (auto node : dst_nodes) {
+    int in_degree = impl_->GetInDegree(node);
+    if (in_degree > 0) {
+      in_degree_nodes.emplace_back(node);
+      in_degrees.emplace_back(in_degree);
+    }
+  }
+
+  return writer->WriteArray(keys) && writer->WriteArray(offsets) &&
+         writer->WriteArray(pairs) && writer->WriteArray(in_degree_nodes) &&
+         writer->WriteArray(in_degrees);
+}
+
+namespace {
+
+std::unique_ptr<AdjacencyImpl> NewAdjacencyImpl(AdjacencyEnum type) {
   switch (type) {
     case AdjacencyEnum::ADJ_LIST:
-      adjacency.reset(new Adjacency(NewAdjListImpl()));
-      break;
+      return NewAdjListImpl();
     case AdjacencyEnum::ADJ_MATRIX:
-      adjacency.reset(new Adjacency(NewAdjMatrixImpl()));
-      break;
+      return NewAdjMatrixImpl();
+    case AdjacencyEnum::ADJ_CSR:
+      return NewAdjCsrImpl();
+    case AdjacencyEnum::ADJ_COMPRESSED:
+      return NewAdjCompressedImpl(WeightCodecEnum::FLOAT32,
+                                  WeightCodecEnum::FLOAT32);
+    case AdjacencyEnum::ADJ_COMPRESSED_Q16:
+      return NewAdjCompressedImpl(WeightCodecEnum::QUANT16,
+                                  WeightCodecEnum::FLOAT32);
+    case AdjacencyEnum::ADJ_COMPRESSED_Q8:
+      return NewAdjCompressedImpl(WeightCodecEnum::QUANT8,
+                                  WeightCodecEnum::FLOAT32);
+    case AdjacencyEnum::ADJ_DEDUP:
+      return NewAdjDedupImpl();
+    case AdjacencyEnum::ADJ_COMPRESSED_F16:
+      return NewAdjCompressedImpl(WeightCodecEnum::FLOAT16,
+                                  WeightCodecEnum::FLOAT16);
+    case AdjacencyEnum::ADJ_COMPRESSED_BF16:
+      return NewAdjCompressedImpl(WeightCodecEnum::BFLOAT16,
+                                  WeightCodecEnum::BFLOAT16);
     default:
-      DXERROR("Need type: ADJ_LIST(0) || ADJ_MATRIX(1), got type: %d.",
-              (int)type);
-      break;
+      DXERROR(
+          "Need type: ADJ_LIST(0) || ADJ_MATRIX(1) || ADJ_CSR(2) || "
+          "ADJ_COMPRESSED(3) || ADJ_COMPRESSED_Q16(4) || ADJ_COMPRESSED_Q8(5) "
+          "|| ADJ_DEDUP(6) || ADJ_COMPRESSED_F16(7) || ADJ_COMPRESSED_BF16(8), "
+          "got type: %d.",
+          (int)type);
+      return nullptr;
+  }
+}
+
+}  // namespace
+
+std::unique_ptr<Adjacency> NewAdjacency(AdjacencyEnum type,
+                                        int partition_num) {
+  std::unique_ptr<Adjacency> adjacency;
+  if (partition_num <= 1) {
+    auto impl = NewAdjacencyImpl(type);
+    if (impl) {
+      adjacency.reset(new Adjacency(std::move(impl)));
+    }
+    return adjacency;
   }
 
+  std::vector<std::unique_ptr<AdjacencyImpl>> partitions;
+  for (int i = 0; i < partition_num; ++i) {
+    auto impl = NewAdjacencyImpl(type);
+    if (!impl) {
+      return adjacency;
+    }
+    partitions.emplace_back(std::move(impl));
+  }
+  adjacency.reset(new Adjacency(NewAdjPartitionImpl(std::move(partitions))));
   return adjacency;
 }
 
@@ -14,6 +14,8 @@
 #include <string>
 
 #include "src/common/data_types.h"
+#include "src/common/memory_usage.h"
+#include "src/io/snapshot.h"
 #include "src/io/value.h"
 
 namespace embedx {
@@ -33,6 +35,9 @@ class Adjacency {
   void Reserve(uint64_t estimated_size);
   bool AddContext(AdjValue* value);
   bool AddFeature(AdjValue* value);
+  void Freeze();
+  void BuildInDegree(int thread_num);
+  bool Attach(SnapshotReader* reader);
 
  public:
   size_t Size() const noexcept;
@@ -40,17 +45,39 @@ class Adjacency {
   const vec_int_t& Keys() const noexcept;
 
  public:
-  const vec_pair_t* FindNeighbor(int_t node) const;
+  pair_view_t FindNeighbor(int_t node) const;
+  bool LookupRow(int_t node, int* row) const;
+  pair_view_t FindNeighborAt(int row) const;
   std::string Print(int_t node) const;
   int GetInDegree(int_t dst_node) const;
   int GetOutDegree(int_t src_node) const;
+  void CollectMemory(MemoryUsage* usage) const;
+
+ public:
+  // Writes the store in csr layout, whatever the impl is.
+  bool Dump(SnapshotWriter* writer) const;
 };
 
 enum class AdjacencyEnum : int {
   ADJ_LIST = 0,
   ADJ_MATRIX = 1,
+  ADJ_CSR = 2,
+  // delta/varint encoded, with float, 16 bit or 8 bit context weights and
+  // float feature values
+  ADJ_COMPRESSED = 3,
+  ADJ_COMPRESSED_Q16 = 4,
+  ADJ_COMPRESSED_Q8 = 5,
+  // csr with identical rows stored once, meant for features
+  ADJ_DEDUP = 6,
+  // delta/varint encoded, with half float or bfloat16 context weights and
+  // feature values
+  ADJ_COMPRESSED_F16 = 7,
+  ADJ_COMPRESSED_BF16 = 8,
 };
 
-std::unique_ptr<Adjacency> NewAdjacency(AdjacencyEnum type);
+// With 'partition_num' > 1, nodes are hash partitioned and AddContext and
+// AddFeature become thread safe.
+std::unique_ptr<Adjacency> NewAdjacency(AdjacencyEnum type,
+                                        int partition_num = 1);
 
 }  // namespace embedx
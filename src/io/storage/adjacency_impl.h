@@ -10,12 +10,18 @@
 //
 
 #pragma once
-#include <algorithm>  // std::stable_sort
+#include <deepx_core/dx_log.h>
+
+#include <algorithm>  // std::lower_bound, std::stable_sort
 #include <memory>     // std::unique_ptr
 #include <string>
+#include <vector>
 
 #include "src/common/data_types.h"
+#include "src/common/memory_usage.h"
 #include "src/io/io_util.h"
+#include "src/io/snapshot.h"
+#include "src/io/storage/neighbor_codec.h"
 #include "src/io/value.h"
 
 namespace embedx {
@@ -30,6 +36,16 @@ class AdjacencyImpl {
   virtual void Reserve(uint64_t estimated_size) = 0;
   virtual bool AddContext(AdjValue* value) = 0;
   virtual bool AddFeature(AdjValue* value) = 0;
+  // Called once all values are added, stores may compact themselves here.
+  virtual void Freeze() {}
+  // Counts the in-degrees of the neighbors after Freeze, GetInDegree returns
+  // 0 until then.
+  virtual void BuildInDegree(int /*thread_num*/) {}
+  // Reads a store written by Adjacency::Dump, arrays may stay in the mapping.
+  virtual bool Attach(SnapshotReader* /*reader*/) {
+    DXERROR("Attach was not implemented in this adjacency.");
+    return false;
+  }
 
  public:
   virtual size_t Size() const noexcept = 0;
@@ -37,25 +53,40 @@ class AdjacencyImpl {
   virtual const vec_int_t& Keys() const noexcept = 0;
 
  public:
-  virtual const vec_pair_t* FindNeighbor(int_t node) const = 0;
+  virtual pair_view_t FindNeighbor(int_t node) const = 0;
+  // Rows are dense ids in [0, Size()), found once per node and then used to
+  // index arrays instead of hashing the node again.
+  virtual bool LookupRow(int_t node, int* row) const = 0;
+  virtual pair_view_t FindNeighborAt(int row) const = 0;
   virtual std::string Print(int_t node) const = 0;
   virtual int GetInDegree(int_t dst_node) const = 0;
   virtual int GetOutDegree(int_t src_node) const = 0;
+  // Adds the bytes of the store as "indexing" (keys and the index map),
+  // "neighbors" (the lists) and "in_degree".
+  virtual void CollectMemory(MemoryUsage* usage) const = 0;
 
  protected:
-  void SortByNode(vec_pair_t* context) const {
-    std::stable_sort(context->begin(), context->end(),
-                     [&](const pair_t& a, const pair_t& b) {
-                       uint16_t type_a = io_util::GetNodeType(a.first);
-                       uint16_t type_b = io_util::GetNodeType(b.first);
-                       if (type_a == type_b) {
-                         return a.first < b.first;
-                       } else {
-                         return type_a < type_b;
-                       }
-                     });
+  // In-degrees of the neighbors in all rows, sorted by node. Each thread
+  // counts its own rows, the counts are merged at the end.
+  void CountInDegree(int thread_num, vec_int_t* nodes,
+                     std::vector<int>* in_degrees) const;
+
+  // 'nodes' and 'in_degrees' as counted by CountInDegree
+  template <typename Nodes, typename InDegrees>
+  static int FindInDegree(const Nodes& nodes, const InDegrees& in_degrees,
+                          int_t node) {
+    auto it = std::lower_bound(nodes.begin(), nodes.end(), node);
+    if (it != nodes.end() && *it == node) {
+      return in_degrees[it - nodes.begin()];
+    }
+    return 0;
   }
 
+  // Stable sorts by (node type, node). Node types are the upper 16 bits of
+  // nodes, so that is the order of the nodes. Sorted input is only checked,
+  // large lists are sorted by many threads.
+  static void SortByNode(vec_pair_t* context);
+
   void SortByWeight(vec_pair_t* context) const {
     std::stable_sort(context->begin(), context->end(),
                      [&](const pair_t& a, const pair_t& b) {
@@ -72,5 +103,12 @@ class AdjacencyImpl {
 
 std::unique_ptr<AdjacencyImpl> NewAdjListImpl();
 std::unique_ptr<AdjacencyImpl> NewAdjMatrixImpl();
+std::unique_ptr<AdjacencyImpl> NewAdjCsrImpl();
+std::unique_ptr<AdjacencyImpl> NewAdjCompressedImpl(
+    WeightCodecEnum context_codec, WeightCodecEnum feature_codec);
+std::unique_ptr<AdjacencyImpl> NewAdjDedupImpl();
+// Spreads nodes over 'partitions', each one with its own lock.
+std::unique_ptr<AdjacencyImpl> NewAdjPartitionImpl(
+    std::vector<std::unique_ptr<AdjacencyImpl>>&& partitions);
 
 }  // namespace embedx
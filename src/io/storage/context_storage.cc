@@ -24,10 +24,13 @@ class ContextStorage : public Storage {
  private:
   std::unique_ptr<Adjacency> adj_;
   std::mutex mtx_;
+  // Partitions lock themselves, the store wide lock is skipped.
+  bool partitioned_ = false;
 
  public:
-  explicit ContextStorage(int store_type) {
-    adj_ = NewAdjacency((AdjacencyEnum)store_type);
+  ContextStorage(int store_type, int partition_num)
+      : partitioned_(partition_num > 1) {
+    adj_ = NewAdjacency((AdjacencyEnum)store_type, partition_num);
   }
   ~ContextStorage() override = default;
 
@@ -36,8 +39,20 @@ class ContextStorage : public Storage {
   void Reserve(uint64_t estimated_size) override {
     adj_->Reserve(estimated_size);
   }
-  void Lock() override { mtx_.lock(); }
-  void UnLock() override { mtx_.unlock(); }
+  void Lock() override {
+    if (!partitioned_) {
+      mtx_.lock();
+    }
+  }
+  void UnLock() override {
+    if (!partitioned_) {
+      mtx_.unlock();
+    }
+  }
+  void Freeze() override { adj_->Freeze(); }
+  void BuildInDegree(int thread_num) override {
+    adj_->BuildInDegree(thread_num);
+  }
   bool InsertContext(AdjValue* value) override {
     return adj_->AddContext(value);
   }
@@ -48,9 +63,15 @@ class ContextStorage : public Storage {
   const vec_int_t& Keys() const noexcept override { return adj_->Keys(); }
 
  public:
-  const vec_pair_t* FindNeighbor(int_t node) const override {
+  pair_view_t FindNeighbor(int_t node) const override {
     return adj_->FindNeighbor(node);
   }
+  bool LookupRow(int_t node, int* row) const override {
+    return adj_->LookupRow(node, row);
+  }
+  pair_view_t FindNeighborAt(int row) const override {
+    return adj_->FindNeighborAt(row);
+  }
   std::string Print(int_t node) const override { return adj_->Print(node); }
   int GetInDegree(int_t dst_node) const override {
     return adj_->GetInDegree(dst_node);
@@ -58,11 +79,20 @@ class ContextStorage : public Storage {
   int GetOutDegree(int_t src_node) const override {
     return adj_->GetOutDegree(src_node);
   }
+  void CollectMemory(MemoryUsage* usage) const override {
+    adj_->CollectMemory(usage);
+  }
+
+ public:
+  bool Dump(SnapshotWriter* writer) const override {
+    return adj_->Dump(writer);
+  }
+  bool Attach(SnapshotReader* reader) override { return adj_->Attach(reader); }
 };
 
-std::unique_ptr<Storage> NewContextStorage(int store_type) {
+std::unique_ptr<Storage> NewContextStorage(int store_type, int partition_num) {
   std::unique_ptr<Storage> context_store;
-  context_store.reset(new ContextStorage(store_type));
+  context_store.reset(new ContextStorage(store_type, partition_num));
   return context_store;
 }
 
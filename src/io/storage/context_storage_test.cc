@@ -15,6 +15,8 @@
 #include <memory>  // std::unique_ptr
 #include <vector>
 
+#include "src/common/data_types.h"
+#include "src/common/memory_usage.h"
 #include "src/io/storage/adjacency.h"
 #include "src/io/storage/storage.h"
 #include "src/io/value.h"
@@ -28,6 +30,7 @@ class ContextStorageTest : public ::testing::Test {
 
  protected:
   const uint64_t ESTIMATED_SIZE = 10;
+  const int THREAD_NUM = 2;
 
  protected:
   void SetUp() override {
@@ -49,13 +52,15 @@ TEST_F(ContextStorageTest, Insert_AdjList) {
   for (auto value : context_values_) {
     EXPECT_TRUE(context_store_->InsertContext(&value));
   }
+  context_store_->Freeze();
+  context_store_->BuildInDegree(THREAD_NUM);
 
   EXPECT_EQ(context_store_->Size(), 5u);
   EXPECT_TRUE(!context_store_->Empty());
 
   for (size_t i = 0; i < context_store_->Keys().size(); ++i) {
     auto node = context_store_->Keys()[i];
-    EXPECT_EQ(context_store_->FindNeighbor(node)->size(), i + 1);
+    EXPECT_EQ(context_store_->FindNeighbor(node).size(), i + 1);
     EXPECT_EQ(context_store_->GetInDegree(node), 5 - (int)i);
     EXPECT_EQ(context_store_->GetOutDegree(node), (int)i + 1);
   }
@@ -69,16 +74,221 @@ TEST_F(ContextStorageTest, Insert_AdjMatrix) {
   for (auto value : context_values_) {
     EXPECT_TRUE(context_store_->InsertContext(&value));
   }
+  context_store_->Freeze();
+  context_store_->BuildInDegree(THREAD_NUM);
 
   EXPECT_EQ(context_store_->Size(), 5u);
   EXPECT_TRUE(!context_store_->Empty());
 
   for (size_t i = 0; i < context_store_->Keys().size(); ++i) {
     auto node = context_store_->Keys()[i];
-    EXPECT_EQ(context_store_->FindNeighbor(node)->size(), i + 1);
+    EXPECT_EQ(context_store_->FindNeighbor(node).size(), i + 1);
     EXPECT_EQ(context_store_->GetInDegree(node), 5 - (int)i);
     EXPECT_EQ(context_store_->GetOutDegree(node), (int)i + 1);
   }
 }
 
+TEST_F(ContextStorageTest, Insert_AdjCsr) {
+  context_store_ = NewContextStorage((int)AdjacencyEnum::ADJ_CSR);
+  context_store_->Clear();
+  context_store_->Reserve(ESTIMATED_SIZE);
+
+  for (auto value : context_values_) {
+    EXPECT_TRUE(context_store_->InsertContext(&value));
+  }
+  context_store_->Freeze();
+  context_store_->BuildInDegree(THREAD_NUM);
+
+  EXPECT_EQ(context_store_->Size(), 5u);
+  EXPECT_TRUE(!context_store_->Empty());
+
+  for (size_t i = 0; i < context_store_->Keys().size(); ++i) {
+    auto node = context_store_->Keys()[i];
+    auto context = context_store_->FindNeighbor(node);
+    EXPECT_EQ(context.size(), i + 1);
+    EXPECT_EQ(context.back().first, node);
+    EXPECT_EQ(context_store_->GetInDegree(node), 5 - (int)i);
+    EXPECT_EQ(context_store_->GetOutDegree(node), (int)i + 1);
+  }
+
+  EXPECT_TRUE(context_store_->FindNeighbor(5).empty());
+  EXPECT_EQ(context_store_->GetOutDegree(5), 0);
+
+  // frozen
+  AdjValue value;
+  value.node = 5;
+  value.pairs.emplace_back(0, 1);
+  EXPECT_FALSE(context_store_->InsertContext(&value));
+}
+
+TEST_F(ContextStorageTest, Insert_AdjCompressed) {
+  for (auto type :
+       {AdjacencyEnum::ADJ_COMPRESSED, AdjacencyEnum::ADJ_COMPRESSED_Q16,
+        AdjacencyEnum::ADJ_COMPRESSED_Q8}) {
+    context_store_ = NewContextStorage((int)type);
+    context_store_->Clear();
+    context_store_->Reserve(ESTIMATED_SIZE);
+
+    for (auto value : context_values_) {
+      EXPECT_TRUE(context_store_->InsertContext(&value));
+    }
+    context_store_->Freeze();
+    context_store_->BuildInDegree(THREAD_NUM);
+
+    EXPECT_EQ(context_store_->Size(), 5u);
+    EXPECT_TRUE(!context_store_->Empty());
+
+    for (size_t i = 0; i < context_store_->Keys().size(); ++i) {
+      auto node = context_store_->Keys()[i];
+      auto context = context_store_->FindNeighbor(node);
+      ASSERT_EQ(context.size(), i + 1);
+      for (size_t j = 0; j < context.size(); ++j) {
+        EXPECT_EQ(context[j].first, j);
+        EXPECT_NEAR(context[j].second, j, 0.02);
+      }
+      EXPECT_EQ(context_store_->GetInDegree(node), 5 - (int)i);
+      EXPECT_EQ(context_store_->GetOutDegree(node), (int)i + 1);
+    }
+
+    EXPECT_TRUE(context_store_->FindNeighbor(5).empty());
+    EXPECT_EQ(context_store_->GetOutDegree(5), 0);
+  }
+}
+
+TEST_F(ContextStorageTest, AdjCompressed_Cache) {
+  // More stores than the decode caches of a thread, node 0 of store k has
+  // the neighbor k.
+  std::vector<std::unique_ptr<Storage>> stores;
+  for (int k = 0; k < 10; ++k) {
+    stores.emplace_back(NewContextStorage((int)AdjacencyEnum::ADJ_COMPRESSED));
+    AdjValue value;
+    value.node = 0;
+    value.pairs.emplace_back(k, 1);
+    ASSERT_TRUE(stores.back()->InsertContext(&value));
+    stores.back()->Freeze();
+  }
+
+  for (int round = 0; round < 2; ++round) {
+    for (int k = 0; k < 10; ++k) {
+      auto context = stores[k]->FindNeighbor(0);
+      ASSERT_EQ(context.size(), 1u);
+      EXPECT_EQ(context[0].first, (int_t)k);
+    }
+  }
+
+  // Rows of a cleared store aren't served from the cache.
+  stores[0]->Clear();
+  AdjValue value;
+  value.node = 0;
+  value.pairs.emplace_back(100, 1);
+  ASSERT_TRUE(stores[0]->InsertContext(&value));
+  auto context = stores[0]->FindNeighbor(0);
+  ASSERT_EQ(context.size(), 1u);
+  EXPECT_EQ(context[0].first, 100u);
+}
+
+TEST_F(ContextStorageTest, LookupRow) {
+  for (auto type :
+       {AdjacencyEnum::ADJ_LIST, AdjacencyEnum::ADJ_MATRIX,
+        AdjacencyEnum::ADJ_CSR, AdjacencyEnum::ADJ_COMPRESSED}) {
+    for (int partition_num : {1, 3}) {
+      context_store_ = NewContextStorage((int)type, partition_num);
+      for (auto value : context_values_) {
+        EXPECT_TRUE(context_store_->InsertContext(&value));
+      }
+      context_store_->Freeze();
+
+      std::vector<bool> seen(context_store_->Size(), false);
+      for (auto node : context_store_->Keys()) {
+        int row = -1;
+        ASSERT_TRUE(context_store_->LookupRow(node, &row));
+        ASSERT_TRUE(row >= 0 && row < (int)context_store_->Size());
+        EXPECT_FALSE(seen[row]);
+        seen[row] = true;
+
+        auto context = context_store_->FindNeighborAt(row);
+        ASSERT_EQ(context.size(), node + 1);
+        EXPECT_EQ(context.back().first, node);
+      }
+
+      int row = -1;
+      EXPECT_FALSE(context_store_->LookupRow(5, &row));
+    }
+  }
+}
+
+TEST_F(ContextStorageTest, SortByNode) {
+  context_store_ = NewContextStorage((int)AdjacencyEnum::ADJ_CSR);
+
+  // namespace 1 after namespace 0, equal nodes keep their order
+  AdjValue value;
+  value.node = 0;
+  value.pairs = {{((int_t)1 << 48) | 3, 1}, {5, 2}, {2, 3}, {5, 4}};
+  EXPECT_TRUE(context_store_->InsertContext(&value));
+
+  // large enough to be sorted by many threads
+  value.node = 1;
+  value.pairs.clear();
+  const int size = (1 << 19) + 7;
+  for (int i = 0; i < size; ++i) {
+    value.pairs.emplace_back((int_t)i * 7919 % size / 2, (float_t)i);
+  }
+  EXPECT_TRUE(context_store_->InsertContext(&value));
+  context_store_->Freeze();
+
+  auto context = context_store_->FindNeighbor(0);
+  ASSERT_EQ(context.size(), 4u);
+  EXPECT_EQ(context[0], pair_t(2, 3));
+  EXPECT_EQ(context[1], pair_t(5, 2));
+  EXPECT_EQ(context[2], pair_t(5, 4));
+  EXPECT_EQ(context[3], pair_t(((int_t)1 << 48) | 3, 1));
+
+  context = context_store_->FindNeighbor(1);
+  ASSERT_EQ(context.size(), (size_t)size);
+  for (int i = 1; i < size; ++i) {
+    const auto& prev = context[i - 1];
+    const auto& cur = context[i];
+    ASSERT_TRUE(prev.first < cur.first ||
+                (prev.first == cur.first && prev.second < cur.second));
+  }
+}
+
+TEST_F(ContextStorageTest, CollectMemory) {
+  auto collect = [this](AdjacencyEnum type, int partition_num,
+                        MemoryUsage* usage) {
+    context_store_ = NewContextStorage((int)type, partition_num);
+    for (auto value : context_values_) {
+      ASSERT_TRUE(context_store_->InsertContext(&value));
+    }
+    context_store_->Freeze();
+    context_store_->BuildInDegree(THREAD_NUM);
+    context_store_->CollectMemory(usage);
+  };
+
+  for (auto type : {AdjacencyEnum::ADJ_LIST, AdjacencyEnum::ADJ_MATRIX,
+                    AdjacencyEnum::ADJ_CSR, AdjacencyEnum::ADJ_COMPRESSED,
+                    AdjacencyEnum::ADJ_DEDUP}) {
+    for (int partition_num : {1, 2}) {
+      MemoryUsage usage;
+      collect(type, partition_num, &usage);
+      ASSERT_EQ(usage.entries().size(), 3u);
+      EXPECT_EQ(usage.Find("indexing")->elements, 5u);
+      EXPECT_EQ(usage.Find("neighbors")->elements, 15u);
+      // Partitions count the in-degrees of their own rows.
+      EXPECT_GE(usage.Find("in_degree")->elements, 5u);
+      EXPECT_GT(usage.Find("indexing")->bytes, 5 * sizeof(int_t));
+      EXPECT_GT(usage.Find("neighbors")->bytes, 0u);
+    }
+  }
+
+  // varint rows are smaller than pairs
+  MemoryUsage csr_usage;
+  collect(AdjacencyEnum::ADJ_CSR, 1, &csr_usage);
+  EXPECT_GE(csr_usage.Find("neighbors")->bytes, 15 * sizeof(pair_t));
+  MemoryUsage compressed_usage;
+  collect(AdjacencyEnum::ADJ_COMPRESSED, 1, &compressed_usage);
+  EXPECT_LT(compressed_usage.Find("neighbors")->bytes,
+            csr_usage.Find("neighbors")->bytes);
+}
+
 }  // namespace embedx
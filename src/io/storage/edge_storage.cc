@@ -11,9 +11,10 @@
 
 #include <deepx_core/dx_log.h>
 
-#include <memory>  // std::unique_ptr
+#include <memory>   // std::unique_ptr
 #include <mutex>
 #include <string>
+#include <utility>  // std::move
 
 #include "src/common/data_types.h"
 #include "src/io/storage/edge_vector.h"
@@ -27,9 +28,8 @@ class EdgeStorage : public Storage {
   std::unique_ptr<EdgeVector> edge_vector_;
 
  public:
-  explicit EdgeStorage(int store_type) {
-    edge_vector_ = NewEdgeVector(store_type);
-  }
+  explicit EdgeStorage(std::unique_ptr<EdgeVector> edge_vector)
+      : edge_vector_(std::move(edge_vector)) {}
   ~EdgeStorage() override = default;
 
  public:
@@ -39,22 +39,29 @@ class EdgeStorage : public Storage {
   }
   void Lock() override { mtx_.lock(); }
   void UnLock() override { mtx_.unlock(); }
-  bool InsertEdge(EdgeValue* value) override {
-    return edge_vector_->Add(value);
+  bool InsertEdge(EdgeValue* /*value*/) override {
+    DXERROR("Edges are built in two passes by the edge loader.");
+    return false;
   }
 
  public:
+  // The number of edges, whose ids are [0, Size()).
   size_t Size() const noexcept override { return edge_vector_->Size(); }
   bool Empty() const noexcept override { return edge_vector_->Empty(); }
+  // src nodes
   const vec_int_t& Keys() const noexcept override {
-    return edge_vector_->src_node_list();
+    return edge_vector_->src_nodes();
   }
 
  public:
-  // Not Implemented
-  const vec_pair_t* FindNeighbor(int_t /*node*/) const override {
-    DXERROR("FindNeighbor was not implemented in the edge storage.");
-    return nullptr;
+  pair_view_t FindNeighbor(int_t node) const override {
+    return edge_vector_->FindNeighbor(node);
+  }
+  bool LookupRow(int_t node, int* row) const override {
+    return edge_vector_->LookupRow(node, row);
+  }
+  pair_view_t FindNeighborAt(int row) const override {
+    return edge_vector_->FindNeighborAt(row);
   }
   std::string Print(int_t edge_id) const override {
     return edge_vector_->Print(edge_id);
@@ -65,11 +72,26 @@ class EdgeStorage : public Storage {
   int GetOutDegree(int_t src_node) const override {
     return edge_vector_->GetOutDegree(src_node);
   }
+  void CollectMemory(MemoryUsage* usage) const override {
+    edge_vector_->CollectMemory(usage);
+  }
+
+ public:
+  // Not Implemented
+  bool Dump(SnapshotWriter* /*writer*/) const override {
+    DXERROR("Dump was not implemented in the edge storage.");
+    return false;
+  }
+  bool Attach(SnapshotReader* /*reader*/) override {
+    DXERROR("Attach was not implemented in the edge storage.");
+    return false;
+  }
 };
 
-std::unique_ptr<Storage> NewEdgeStorage(int store_type) {
+std::unique_ptr<Storage> NewEdgeStorage(
+    std::unique_ptr<EdgeVector> edge_vector) {
   std::unique_ptr<Storage> edge_store;
-  edge_store.reset(new EdgeStorage(store_type));
+  edge_store.reset(new EdgeStorage(std::move(edge_vector)));
   return edge_store;
 }
 
@@ -13,132 +13,172 @@
 
 #include <deepx_core/dx_log.h>
 
+#include <algorithm>  // std::lower_bound, std::sort, std::unique, ...
 #include <cinttypes>  // PRIu64
+#include <numeric>    // std::partial_sum
+#include <sstream>    // std::stringstream
+#include <utility>    // std::pair
 
 namespace embedx {
 
-EdgeVector::EdgeVector() {
-  graph_statics_ = NewGraphStatics(&src_indexing_, &dst_indexing_);
-}
-
 void EdgeVector::Clear() noexcept {
-  src_node_list_.clear();
-  dst_node_list_.clear();
-  weight_list_.clear();
-
-  adj_node_list_.clear();
-  adj_edge_list_.clear();
-
+  src_nodes_.clear();
   src_indexing_.Clear();
-  dst_indexing_.Clear();
+  offsets_.clear();
+  edges_.clear();
+  in_degree_nodes_.clear();
+  in_degrees_.clear();
+
+  out_counters_.clear();
+  in_counters_.clear();
 }
 
 void EdgeVector::Reserve(uint64_t estimated_size) {
-  src_node_list_.reserve(estimated_size);
-  dst_node_list_.reserve(estimated_size);
-  weight_list_.reserve(estimated_size);
+  src_nodes_.reserve(estimated_size);
+  src_indexing_.Reserve(estimated_size);
+}
 
-  adj_node_list_.reserve(estimated_size);
-  adj_edge_list_.reserve(estimated_size);
+void EdgeVector::BeginCount(int thread_num) {
+  Clear();
+  out_counters_.resize(thread_num);
+  in_counters_.resize(thread_num);
+}
 
-  src_indexing_.Reserve(estimated_size);
-  dst_indexing_.Reserve(estimated_size);
+void EdgeVector::Count(int thread_id, const EdgeValue& value) {
+  ++out_counters_[thread_id][value.src_node];
+  ++in_counters_[thread_id][value.dst_node];
 }
 
-bool EdgeVector::Add(EdgeValue* value) {
-  auto edge_id = (int_t)src_node_list_.size();
-  src_node_list_.emplace_back(value->src_node);
-  dst_node_list_.emplace_back(value->dst_node);
-  weight_list_.emplace_back(value->weight);
+void EdgeVector::BeginScatter() {
+  for (const auto& counter : out_counters_) {
+    for (const auto& entry : counter) {
+      src_nodes_.emplace_back(entry.first);
+    }
+  }
+  std::sort(src_nodes_.begin(), src_nodes_.end());
+  src_nodes_.erase(std::unique(src_nodes_.begin(), src_nodes_.end()),
+                   src_nodes_.end());
+  src_nodes_.shrink_to_fit();
+  src_indexing_.Reserve(src_nodes_.size());
+  for (auto node : src_nodes_) {
+    src_indexing_.Add(node);
+  }
 
-  // graph stat
-  src_indexing_.Add(value->src_node);
-  dst_indexing_.Add(value->dst_node);
-  if (!graph_statics_->Add(value->src_node, value->dst_node)) {
-    return false;
+  offsets_.assign(src_nodes_.size() + 1, 0);
+  for (const auto& counter : out_counters_) {
+    for (const auto& entry : counter) {
+      offsets_[src_indexing_.Get(entry.first) + 1] += entry.second;
+    }
+  }
+  std::partial_sum(offsets_.begin(), offsets_.end(), offsets_.begin());
+  edges_.resize(offsets_.back());
+
+  // Each thread writes the edges of a row from where the previous threads
+  // stop.
+  std::vector<uint64_t> next_slots(offsets_.begin(), offsets_.end() - 1);
+  for (auto& counter : out_counters_) {
+    for (auto& entry : counter) {
+      auto& next_slot = next_slots[src_indexing_.Get(entry.first)];
+      uint64_t out_degree = entry.second;
+      entry.second = next_slot;
+      next_slot += out_degree;
+    }
   }
 
-  // fill adj_node and adj_edge
-  auto src_index = src_indexing_.Get(value->src_node);
-  if (src_index < (int)adj_edge_list_.size()) {
-    adj_node_list_[src_index].emplace_back(value->dst_node);
-    adj_edge_list_[src_index].emplace_back(edge_id);
-  } else {
-    vec_int_t dst_node_list(1, value->dst_node);
-    adj_node_list_.emplace_back(dst_node_list);
-
-    vec_int_t edge_id_list(1, edge_id);
-    adj_edge_list_.emplace_back(edge_id_list);
+  std::vector<std::pair<int_t, int>> in_degrees;
+  for (auto& counter : in_counters_) {
+    for (const auto& entry : counter) {
+      in_degrees.emplace_back(entry);
+    }
+    counter = FlatHashMap<int_t, int>();
+  }
+  std::sort(in_degrees.begin(), in_degrees.end());
+  for (const auto& entry : in_degrees) {
+    if (!in_degree_nodes_.empty() && in_degree_nodes_.back() == entry.first) {
+      in_degrees_.back() += entry.second;
+    } else {
+      in_degree_nodes_.emplace_back(entry.first);
+      in_degrees_.emplace_back(entry.second);
+    }
   }
+}
+
+bool EdgeVector::Scatter(int thread_id, const EdgeValue& value) {
+  auto& counter = out_counters_[thread_id];
+  auto it = counter.find(value.src_node);
+  if (it == counter.end()) {
+    DXERROR("Edge: %s was not counted by thread: %d.",
+            value.ToString().c_str(), thread_id);
+    return false;
+  }
+
+  edges_[it->second++] = pair_t(value.dst_node, value.weight);
+  return true;
+}
 
-  return false;
+void EdgeVector::EndScatter() {
+  std::vector<FlatHashMap<int_t, uint64_t>>().swap(out_counters_);
+  std::vector<FlatHashMap<int_t, int>>().swap(in_counters_);
+  DXINFO("Built edges, src nodes: %zu, edges: %zu.", src_nodes_.size(),
+         edges_.size());
 }
 
 bool EdgeVector::GetSrcNode(int_t edge_id, int_t* src_node) const {
-  auto src_list_size = (int_t)src_node_list_.size();
-  if (edge_id > src_list_size) {
-    DXERROR("Need edge_id < src_node_list.size(), got edge_id: %" PRIu64
-            " vs src_node_list.size(): %" PRIu64,
-            edge_id, src_list_size);
+  if (edge_id >= (int_t)edges_.size()) {
+    DXERROR("Need edge_id < edge size, got edge_id: %" PRIu64
+            " vs edge size: %zu",
+            edge_id, edges_.size());
     return false;
   }
 
-  *src_node = src_node_list_[edge_id];
+  auto it = std::upper_bound(offsets_.begin() + 1, offsets_.end(), edge_id);
+  *src_node = src_nodes_[it - (offsets_.begin() + 1)];
   return true;
 }
 
 bool EdgeVector::GetDstNode(int_t edge_id, int_t* dst_node) const {
-  auto dst_list_size = (int_t)dst_node_list_.size();
-  if (edge_id > dst_list_size) {
-    DXERROR("Need edge_id < dst_node_list.size(), got edge_id: %" PRIu64
-            " vs dst_node_list.size(): %" PRIu64,
-            edge_id, dst_list_size);
+  if (edge_id >= (int_t)edges_.size()) {
+    DXERROR("Need edge_id < edge size, got edge_id: %" PRIu64
+            " vs edge size: %zu",
+            edge_id, edges_.size());
     return false;
   }
 
-  *dst_node = dst_node_list_[edge_id];
+  *dst_node = edges_[edge_id].first;
   return true;
 }
 
 bool EdgeVector::GetWeight(int_t edge_id, float_t* weight) const {
-  auto weight_list_size = (int_t)weight_list_.size();
-  if (edge_id > weight_list_size) {
-    DXERROR("Need edge_id < weight_list.size(), got edge_id: %" PRIu64
-            " vs weight_list.size(): %" PRIu64,
-            edge_id, weight_list_size);
+  if (edge_id >= (int_t)edges_.size()) {
+    DXERROR("Need edge_id < edge size, got edge_id: %" PRIu64
+            " vs edge size: %zu",
+            edge_id, edges_.size());
     return false;
   }
 
-  *weight = weight_list_[edge_id];
+  *weight = edges_[edge_id].second;
   return true;
 }
 
-const vec_int_t* EdgeVector::FindNeighborNode(int_t node) const {
-  int src_index = src_indexing_.Get(node);
-  int adj_node_size = (int)adj_node_list_.size();
-  if (src_index < 0 || src_index > adj_node_size) {
-    DXERROR(
-        "Need 0 <= src_index < adj_node_list.size(), got src_index: %d vs "
-        "adj_node_list.size(): %d",
-        src_index, adj_node_size);
-    return nullptr;
+pair_view_t EdgeVector::FindNeighbor(int_t node, int_t* first_edge) const {
+  int row = 0;
+  if (!src_indexing_.Lookup(node, &row)) {
+    return pair_view_t();
   }
 
-  return &adj_node_list_[src_index];
+  if (first_edge != nullptr) {
+    *first_edge = offsets_[row];
+  }
+  return FindNeighborAt(row);
 }
 
-const vec_int_t* EdgeVector::FindNeighborEdge(int_t node) const {
-  int src_index = src_indexing_.Get(node);
-  int adj_edge_size = (int)adj_edge_list_.size();
-  if (src_index < 0 || src_index > adj_edge_size) {
-    DXERROR(
-        "Need 0 <= src_index < adj_edge_list.size(), got src_index: %d vs "
-        "adj_edge_list.size(): %d",
-        src_index, adj_edge_size);
-    return nullptr;
-  }
+bool EdgeVector::LookupRow(int_t node, int* row) const {
+  return src_indexing_.Lookup(node, row);
+}
 
-  return &adj_edge_list_[src_index];
+pair_view_t EdgeVector::FindNeighborAt(int row) const {
+  return pair_view_t(edges_.data() + offsets_[row],
+                     offsets_[row + 1] - offsets_[row]);
 }
 
 std::string EdgeVector::Print(int_t edge_id) const {
@@ -155,11 +195,26 @@ std::string EdgeVector::Print(int_t edge_id) const {
 }
 
 int EdgeVector::GetInDegree(int_t node) const {
-  return graph_statics_->GetInDegree(node);
+  auto it =
+      std::lower_bound(in_degree_nodes_.begin(), in_degree_nodes_.end(), node);
+  if (it == in_degree_nodes_.end() || *it != node) {
+    return 0;
+  }
+  return in_degrees_[it - in_degree_nodes_.begin()];
 }
 
 int EdgeVector::GetOutDegree(int_t node) const {
-  return graph_statics_->GetOutDegree(node);
+  return (int)FindNeighbor(node).size();
+}
+
+void EdgeVector::CollectMemory(MemoryUsage* usage) const {
+  usage->Add("indexing", VectorBytes(src_nodes_) + src_indexing_.MemoryBytes(),
+             src_nodes_.size());
+  usage->Add("neighbors", VectorBytes(offsets_) + VectorBytes(edges_),
+             edges_.size());
+  usage->Add("in_degree",
+             VectorBytes(in_degree_nodes_) + VectorBytes(in_degrees_),
+             in_degree_nodes_.size());
 }
 
 std::unique_ptr<EdgeVector> NewEdgeVector(int /* store_type */) {
@@ -15,62 +15,71 @@
 #include <vector>
 
 #include "src/common/data_types.h"
+#include "src/common/flat_hash_map.h"
+#include "src/common/memory_usage.h"
 #include "src/io/indexing.h"
-#include "src/io/storage/graph_statics.h"
 #include "src/io/value.h"
 
 namespace embedx {
 
+// Edges in csr layout, built in two passes over the same edges.
+//
+// The first pass counts the degrees of each node, the second one scatters
+// the edges into their slots, so no per edge buffer is kept besides the
+// final arrays. Both passes may run on many threads, as long as each thread
+// sees the same edges in the same order in both passes.
+//
+// The id of an edge is its slot: the edges of a src node are contiguous,
+// ordered by thread, then by the order they were read.
 class EdgeVector {
  private:
-  vec_int_t src_node_list_;
-  vec_int_t dst_node_list_;
-  vec_float_t weight_list_;
-
-  std::vector<vec_int_t> adj_node_list_;
-  std::vector<vec_int_t> adj_edge_list_;
-
+  // src nodes, sorted
+  vec_int_t src_nodes_;
   Indexing src_indexing_;
-  Indexing dst_indexing_;
-  std::unique_ptr<GraphStatics> graph_statics_;
+  // the edges of row i are [offsets_[i], offsets_[i + 1])
+  std::vector<uint64_t> offsets_;
+  // [dst_node, weight] of each edge
+  vec_pair_t edges_;
+  // sorted by node
+  vec_int_t in_degree_nodes_;
+  std::vector<int> in_degrees_;
 
- public:
-  EdgeVector();
-  ~EdgeVector() = default;
+  // per thread: src node -> out-degree, then -> next slot
+  std::vector<FlatHashMap<int_t, uint64_t>> out_counters_;
+  // per thread: dst node -> in-degree
+  std::vector<FlatHashMap<int_t, int>> in_counters_;
 
  public:
   void Clear() noexcept;
   void Reserve(uint64_t estimated_size);
-  bool Add(EdgeValue* value);
 
-  size_t Size() const noexcept { return src_node_list_.size(); }
-  bool Empty() const noexcept { return src_node_list_.empty(); }
+ public:
+  // first pass
+  void BeginCount(int thread_num);
+  void Count(int thread_id, const EdgeValue& value);
+  // second pass
+  void BeginScatter();
+  bool Scatter(int thread_id, const EdgeValue& value);
+  void EndScatter();
+
+ public:
+  size_t Size() const noexcept { return edges_.size(); }
+  bool Empty() const noexcept { return edges_.empty(); }
+  const vec_int_t& src_nodes() const noexcept { return src_nodes_; }
 
  public:
   bool GetSrcNode(int_t edge_id, int_t* src_node) const;
   bool GetDstNode(int_t edge_id, int_t* dst_node) const;
   bool GetWeight(int_t edge_id, float_t* weight) const;
-  const vec_int_t* FindNeighborNode(int_t node) const;
-  const vec_int_t* FindNeighborEdge(int_t node) const;
+  // [dst_node, weight] of the edges of 'node', the first one has id
+  // 'first_edge'.
+  pair_view_t FindNeighbor(int_t node, int_t* first_edge = nullptr) const;
+  bool LookupRow(int_t node, int* row) const;
+  pair_view_t FindNeighborAt(int row) const;
   std::string Print(int_t edge_id) const;
   int GetInDegree(int_t node) const;
   int GetOutDegree(int_t node) const;
-
- public:
-  // An EDGE is made up of [src_node, dst_node, weight].
-  const vec_int_t& src_node_list() const noexcept { return src_node_list_; }
-  const vec_int_t& dst_node_list() const noexcept { return dst_node_list_; }
-  const vec_float_t& weight_list() const noexcept { return weight_list_; }
-
-  const std::vector<vec_int_t>& adj_node_list() const noexcept {
-    return adj_node_list_;
-  }
-  const std::vector<vec_int_t>& adj_edge_list() const noexcept {
-    return adj_edge_list_;
-  }
-
-  const Indexing& src_indexing() const noexcept { return src_indexing_; }
-  const Indexing& dst_indexing() const noexcept { return dst_indexing_; }
+  void CollectMemory(MemoryUsage* usage) const;
 };
 
 std::unique_ptr<EdgeVector> NewEdgeVector(int store_type);
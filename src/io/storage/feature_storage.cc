@@ -25,10 +25,13 @@ class FeatureStorage : public Storage {
  private:
   std::unique_ptr<Adjacency> adj_;
   std::mutex mtx_;
+  // Partitions lock themselves, the store wide lock is skipped.
+  bool partitioned_ = false;
 
  public:
-  explicit FeatureStorage(int store_type) {
-    adj_ = NewAdjacency((AdjacencyEnum)store_type);
+  FeatureStorage(int store_type, int partition_num)
+      : partitioned_(partition_num > 1) {
+    adj_ = NewAdjacency((AdjacencyEnum)store_type, partition_num);
   }
   ~FeatureStorage() override = default;
 
@@ -37,8 +40,17 @@ class FeatureStorage : public Storage {
   void Reserve(uint64_t estimated_size) override {
     adj_->Reserve(estimated_size);
   }
-  void Lock() override { mtx_.lock(); }
-  void UnLock() override { mtx_.unlock(); }
+  void Lock() override {
+    if (!partitioned_) {
+      mtx_.lock();
+    }
+  }
+  void UnLock() override {
+    if (!partitioned_) {
+      mtx_.unlock();
+    }
+  }
+  void Freeze() override { adj_->Freeze(); }
   bool InsertFeature(AdjValue* value) override {
     return adj_->AddFeature(value);
   }
@@ -49,9 +61,15 @@ class FeatureStorage : public Storage {
   const vec_int_t& Keys() const noexcept override { return adj_->Keys(); }
 
  public:
-  const vec_pair_t* FindNeighbor(int_t node) const override {
+  pair_view_t FindNeighbor(int_t node) const override {
     return adj_->FindNeighbor(node);
   }
+  bool LookupRow(int_t node, int* row) const override {
+    return adj_->LookupRow(node, row);
+  }
+  pair_view_t FindNeighborAt(int row) const override {
+    return adj_->FindNeighborAt(row);
+  }
   std::string Print(int_t node) const override { return adj_->Print(node); }
   int GetInDegree(int_t /* dst_node */) const override {
     DXERROR("GetInDegree was not implemented in the feature storage.");
@@ -61,11 +79,20 @@ class FeatureStorage : public Storage {
     DXERROR("GetOutDegree was not implemented in the feature storage.");
     return 0;
   }
+  void CollectMemory(MemoryUsage* usage) const override {
+    adj_->CollectMemory(usage);
+  }
+
+ public:
+  bool Dump(SnapshotWriter* writer) const override {
+    return adj_->Dump(writer);
+  }
+  bool Attach(SnapshotReader* reader) override { return adj_->Attach(reader); }
 };
 
-std::unique_ptr<Storage> NewFeatureStorage(int store_type) {
+std::unique_ptr<Storage> NewFeatureStorage(int store_type, int partition_num) {
   std::unique_ptr<Storage> feature_store;
-  feature_store.reset(new FeatureStorage(store_type));
+  feature_store.reset(new FeatureStorage(store_type, partition_num));
   return feature_store;
 }
 
@@ -56,9 +56,9 @@ TEST_F(FeatureStorageTest, Insert_AdjList) {
 
   for (size_t i = 0; i < feature_store_->Keys().size(); ++i) {
     auto node = feature_store_->Keys()[i];
-    auto* feature = feature_store_->FindNeighbor(node);
-    EXPECT_EQ(feature->size(), 1u);
-    for (auto& pair : *feature) {
+    auto feature = feature_store_->FindNeighbor(node);
+    EXPECT_EQ(feature.size(), 1u);
+    for (auto& pair : feature) {
       EXPECT_EQ(pair.first, (int_t)i);
       EXPECT_EQ(pair.second, (float_t)i);
     }
@@ -85,9 +85,9 @@ TEST_F(FeatureStorageTest, Insert_AdjMatrix) {
 
   for (size_t i = 0; i < feature_store_->Keys().size(); ++i) {
     auto node = feature_store_->Keys()[i];
-    auto* feature = feature_store_->FindNeighbor(node);
-    EXPECT_EQ(feature->size(), 1u);
-    for (auto& pair : *feature) {
+    auto feature = feature_store_->FindNeighbor(node);
+    EXPECT_EQ(feature.size(), 1u);
+    for (auto& pair : feature) {
       EXPECT_EQ(pair.first, (int_t)i);
       EXPECT_EQ(pair.second, (float_t)i);
     }
@@ -100,4 +100,52 @@ TEST_F(FeatureStorageTest, Insert_AdjMatrix) {
   }
 }
 
+TEST_F(FeatureStorageTest, Insert_AdjDedup) {
+  feature_store_ = NewFeatureStorage((int)AdjacencyEnum::ADJ_DEDUP);
+  feature_store_->Clear();
+  feature_store_->Reserve(ESTIMATED_SIZE);
+
+  // node 7 of namespace 1 and nodes 0, 5 share the feature row of node 0
+  int_t node_of_ns1 = ((int_t)1 << 48) | 7;
+  feature_values_[0].node = node_of_ns1;
+  feature_values_[0].pairs.assign(1, pair_t(0, 0));
+  AdjValue value5;
+  value5.node = 5;
+  value5.pairs.emplace_back(0, 0);
+  feature_values_.emplace_back(value5);
+  AdjValue value0;
+  value0.node = 0;
+  value0.pairs.emplace_back(0, 0);
+  feature_values_.emplace_back(value0);
+
+  for (auto value : feature_values_) {
+    EXPECT_TRUE(feature_store_->InsertFeature(&value));
+  }
+  feature_store_->Freeze();
+
+  EXPECT_EQ(feature_store_->Size(), 7u);
+  EXPECT_TRUE(!feature_store_->Empty());
+
+  for (const auto& value : feature_values_) {
+    auto feature = feature_store_->FindNeighbor(value.node);
+    ASSERT_EQ(feature.size(), 1u);
+    EXPECT_EQ(feature[0].first, value.pairs[0].first);
+    EXPECT_EQ(feature[0].second, value.pairs[0].second);
+    EXPECT_EQ(feature_store_->GetInDegree(value.node), 0);
+    EXPECT_EQ(feature_store_->GetOutDegree(value.node), 0);
+  }
+
+  auto row0 = feature_store_->FindNeighbor(0);
+  EXPECT_EQ(feature_store_->FindNeighbor(5).data(), row0.data());
+  EXPECT_EQ(feature_store_->FindNeighbor(node_of_ns1).data(), row0.data());
+  // rows of namespace 0 come first, in the order they were added
+  EXPECT_EQ(feature_store_->FindNeighbor(1).data() + 1,
+            feature_store_->FindNeighbor(2).data());
+  EXPECT_EQ(feature_store_->FindNeighbor(4).data() + 1, row0.data());
+
+  value0.pairs.assign(1, pair_t(9, 9));
+  value0.node = 9;
+  EXPECT_FALSE(feature_store_->InsertFeature(&value0));
+}
+
 }  // namespace embedx
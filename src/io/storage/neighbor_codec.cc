@@ -0,0 +1,293 @@
+// Tencent is pleased to support the open source community by making embedx
+// available.
+//
+// Copyright (C) 2021 THL A29 Limited, a Tencent company.  All rights reserved.
+//
+// Licensed under the BSD 3-Clause License and other third-party components,
+// please refer to LICENSE for details.
+//
+
+#include "src/io/storage/neighbor_codec.h"
+
+#include <algorithm>  // std::minmax_element
+#include <cmath>      // std::fabs, std::ldexp, std::lrint, std::lround
+#include <cstring>    // std::memcpy
+
+namespace embedx {
+namespace {
+
+// weight mode
+constexpr uint8_t WEIGHT_CONSTANT = 0;
+constexpr uint8_t WEIGHT_FLOAT32 = 1;
+constexpr uint8_t WEIGHT_QUANT16 = 2;
+constexpr uint8_t WEIGHT_QUANT8 = 3;
+constexpr uint8_t WEIGHT_FLOAT16 = 4;
+constexpr uint8_t WEIGHT_BFLOAT16 = 5;
+
+void PutVarint(uint64_t value, std::vector<uint8_t>* bytes) {
+  while (value >= 0x80) {
+    bytes->emplace_back((uint8_t)(value | 0x80));
+    value >>= 7;
+  }
+  bytes->emplace_back((uint8_t)value);
+}
+
+uint64_t GetVarint(const uint8_t** p) {
+  uint64_t value = 0;
+  int shift = 0;
+  for (;;) {
+    uint8_t byte = *(*p)++;
+    value |= (uint64_t)(byte & 0x7f) << shift;
+    if (byte < 0x80) {
+      return value;
+    }
+    shift += 7;
+  }
+}
+
+template <typename T>
+void PutRaw(T value, std::vector<uint8_t>* bytes) {
+  size_t size = bytes->size();
+  bytes->resize(size + sizeof(T));
+  std::memcpy(bytes->data() + size, &value, sizeof(T));
+}
+
+template <typename T>
+T GetRaw(const uint8_t* p) {
+  T value;
+  std::memcpy(&value, p, sizeof(T));
+  return value;
+}
+
+uint64_t ZigZag(int_t prev, int_t cur) noexcept {
+  auto delta = (int64_t)(cur - prev);
+  return ((uint64_t)delta << 1) ^ (uint64_t)(delta >> 63);
+}
+
+int_t UnZigZag(int_t prev, uint64_t value) noexcept {
+  auto delta = (value >> 1) ^ (~(value & 1) + 1);
+  return prev + delta;
+}
+
+// Rounds to the nearest half, ties to even.
+uint16_t FloatToHalf(float value) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  auto sign = (uint16_t)((bits >> 16) & 0x8000);
+  uint32_t abs = bits & 0x7fffffff;
+  if (abs >= 0x7f800000) {
+    // inf or nan
+    return (uint16_t)(sign | 0x7c00 | (abs > 0x7f800000 ? 0x200 : 0));
+  }
+  if (abs >= 0x477ff000) {
+    // rounds above 65504
+    return (uint16_t)(sign | 0x7c00);
+  }
+  if (abs < 0x38800000) {
+    // subnormal half, in units of 2^-24
+    float magnitude = std::fabs(value);
+    return (uint16_t)(sign | std::lrint(magnitude * 16777216.0f));
+  }
+
+  // rebias the exponent from 127 to 15, keep 10 of 23 mantissa bits
+  uint32_t half = (abs - 0x38000000) >> 13;
+  uint32_t rest = abs & 0x1fff;
+  if (rest > 0x1000 || (rest == 0x1000 && (half & 1))) {
+    ++half;
+  }
+  return (uint16_t)(sign | half);
+}
+
+float HalfToFloat(uint16_t half) {
+  uint32_t sign = (uint32_t)(half & 0x8000) << 16;
+  uint32_t exponent = (half >> 10) & 0x1f;
+  uint32_t mantissa = half & 0x3ff;
+  if (exponent == 0) {
+    float magnitude = std::ldexp((float)mantissa, -24);
+    return sign ? -magnitude : magnitude;
+  }
+
+  uint32_t bits = exponent == 31 ? sign | 0x7f800000 | (mantissa << 13)
+                                 : sign | ((exponent + 112) << 23) |
+                                       (mantissa << 13);
+  float value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+// Keeps the upper 16 bits, rounded to nearest, ties to even.
+uint16_t FloatToBFloat16(float value) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  if ((bits & 0x7fffffff) > 0x7f800000) {
+    // quiet nan
+    return (uint16_t)((bits >> 16) | 0x40);
+  }
+  bits += 0x7fff + ((bits >> 16) & 1);
+  return (uint16_t)(bits >> 16);
+}
+
+float BFloat16ToFloat(uint16_t bfloat16) {
+  uint32_t bits = (uint32_t)bfloat16 << 16;
+  float value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+size_t WeightWidth(uint8_t mode) noexcept {
+  switch (mode) {
+    case WEIGHT_FLOAT32:
+      return sizeof(float);
+    case WEIGHT_QUANT16:
+    case WEIGHT_FLOAT16:
+    case WEIGHT_BFLOAT16:
+      return sizeof(uint16_t);
+    case WEIGHT_QUANT8:
+      return sizeof(uint8_t);
+    default:
+      return 0;
+  }
+}
+
+}  // namespace
+
+void EncodeNeighbor(pair_view_t neighbor, WeightCodecEnum codec,
+                    std::vector<uint8_t>* bytes) {
+  PutVarint(neighbor.size(), bytes);
+
+  float_t min_weight = 0;
+  float_t max_weight = 0;
+  if (!neighbor.empty()) {
+    auto minmax = std::minmax_element(
+        neighbor.begin(), neighbor.end(),
+        [](const pair_t& a, const pair_t& b) { return a.second < b.second; });
+    min_weight = minmax.first->second;
+    max_weight = minmax.second->second;
+  }
+
+  uint8_t mode = WEIGHT_FLOAT32;
+  if (min_weight == max_weight) {
+    mode = WEIGHT_CONSTANT;
+  } else if (codec == WeightCodecEnum::QUANT16) {
+    mode = WEIGHT_QUANT16;
+  } else if (codec == WeightCodecEnum::QUANT8) {
+    mode = WEIGHT_QUANT8;
+  } else if (codec == WeightCodecEnum::FLOAT16) {
+    mode = WEIGHT_FLOAT16;
+  } else if (codec == WeightCodecEnum::BFLOAT16) {
+    mode = WEIGHT_BFLOAT16;
+  }
+  bytes->emplace_back(mode);
+
+  switch (mode) {
+    case WEIGHT_CONSTANT:
+      PutRaw<float>(min_weight, bytes);
+      break;
+    case WEIGHT_FLOAT32:
+      for (const auto& pair : neighbor) {
+        PutRaw<float>(pair.second, bytes);
+      }
+      break;
+    case WEIGHT_FLOAT16:
+      for (const auto& pair : neighbor) {
+        PutRaw<uint16_t>(FloatToHalf(pair.second), bytes);
+      }
+      break;
+    case WEIGHT_BFLOAT16:
+      for (const auto& pair : neighbor) {
+        PutRaw<uint16_t>(FloatToBFloat16(pair.second), bytes);
+      }
+      break;
+    default: {
+      float_t levels = mode == WEIGHT_QUANT16 ? 65535 : 255;
+      float_t scale = (max_weight - min_weight) / levels;
+      PutRaw<float>(min_weight, bytes);
+      PutRaw<float>(scale, bytes);
+      for (const auto& pair : neighbor) {
+        auto code = (uint32_t)std::lround((pair.second - min_weight) / scale);
+        code = std::min(code, (uint32_t)levels);
+        if (mode == WEIGHT_QUANT16) {
+          PutRaw<uint16_t>((uint16_t)code, bytes);
+        } else {
+          PutRaw<uint8_t>((uint8_t)code, bytes);
+        }
+      }
+    } break;
+  }
+
+  int_t prev = 0;
+  for (const auto& pair : neighbor) {
+    PutVarint(ZigZag(prev, pair.first), bytes);
+    prev = pair.first;
+  }
+}
+
+NeighborDecoder::NeighborDecoder(const uint8_t* data) {
+  const uint8_t* p = data;
+  size_ = (size_t)GetVarint(&p);
+  weight_mode_ = *p++;
+  switch (weight_mode_) {
+    case WEIGHT_CONSTANT:
+      weight_min_ = GetRaw<float>(p);
+      p += sizeof(float);
+      break;
+    case WEIGHT_QUANT16:
+    case WEIGHT_QUANT8:
+      weight_min_ = GetRaw<float>(p);
+      weight_scale_ = GetRaw<float>(p + sizeof(float));
+      p += 2 * sizeof(float);
+      break;
+    default:
+      break;
+  }
+  weights_ = p;
+  ids_ = p + size_ * WeightWidth((uint8_t)weight_mode_);
+}
+
+bool NeighborDecoder::Next(pair_t* pair) {
+  if (pos_ == size_) {
+    return false;
+  }
+
+  prev_id_ = UnZigZag(prev_id_, GetVarint(&ids_));
+  pair->first = prev_id_;
+  switch (weight_mode_) {
+    case WEIGHT_CONSTANT:
+      pair->second = weight_min_;
+      break;
+    case WEIGHT_FLOAT32:
+      pair->second = GetRaw<float>(weights_ + pos_ * sizeof(float));
+      break;
+    case WEIGHT_QUANT16:
+      pair->second =
+          weight_min_ +
+          weight_scale_ * GetRaw<uint16_t>(weights_ + pos_ * sizeof(uint16_t));
+      break;
+    case WEIGHT_FLOAT16:
+      pair->second =
+          HalfToFloat(GetRaw<uint16_t>(weights_ + pos_ * sizeof(uint16_t)));
+      break;
+    case WEIGHT_BFLOAT16:
+      pair->second = BFloat16ToFloat(
+          GetRaw<uint16_t>(weights_ + pos_ * sizeof(uint16_t)));
+      break;
+    default:
+      pair->second = weight_min_ + weight_scale_ * weights_[pos_];
+      break;
+  }
+  ++pos_;
+  return true;
+}
+
+void NeighborDecoder::DecodeAll(vec_pair_t* pairs) {
+  pairs->resize(size_ - pos_);
+  for (auto& pair : *pairs) {
+    Next(&pair);
+  }
+}
+
+size_t DecodeNeighborSize(const uint8_t* data) {
+  return (size_t)GetVarint(&data);
+}
+
+}  // namespace embedx
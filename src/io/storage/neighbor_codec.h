@@ -0,0 +1,66 @@
+// Tencent is pleased to support the open source community by making embedx
+// available.
+//
+// Copyright (C) 2021 THL A29 Limited, a Tencent company.  All rights reserved.
+//
+// Licensed under the BSD 3-Clause License and other third-party components,
+// please refer to LICENSE for details.
+//
+
+#pragma once
+#include <cstddef>  // size_t
+#include <cstdint>
+#include <vector>
+
+#include "src/common/data_types.h"
+
+namespace embedx {
+
+// Compact encoding of one neighbor list.
+//
+// [varint size][uint8 weight mode][weights][varint ids]
+//
+// Ids are delta encoded with zigzag varints, which costs 1-3 bytes per id
+// when the list is sorted. Weights are either
+//   - one float shared by all neighbors (unweighted graphs),
+//   - raw floats,
+//   - 16 or 8 bit codes between the min and the max weight of the list,
+//   - IEEE half floats or bfloat16s.
+enum class WeightCodecEnum : int {
+  FLOAT32 = 0,
+  QUANT16 = 1,
+  QUANT8 = 2,
+  FLOAT16 = 3,
+  BFLOAT16 = 4,
+};
+
+// Appends the encoded 'neighbor' to 'bytes'.
+void EncodeNeighbor(pair_view_t neighbor, WeightCodecEnum codec,
+                    std::vector<uint8_t>* bytes);
+
+class NeighborDecoder {
+ private:
+  const uint8_t* ids_ = nullptr;
+  const uint8_t* weights_ = nullptr;
+  size_t size_ = 0;
+  size_t pos_ = 0;
+  int weight_mode_ = 0;
+  float_t weight_min_ = 0;
+  float_t weight_scale_ = 0;
+  int_t prev_id_ = 0;
+
+ public:
+  // 'data' points to a list written by EncodeNeighbor.
+  explicit NeighborDecoder(const uint8_t* data);
+
+ public:
+  size_t size() const noexcept { return size_; }
+  bool Next(pair_t* pair);
+  // Decodes the remaining neighbors into 'pairs'.
+  void DecodeAll(vec_pair_t* pairs);
+};
+
+// Reads only the size of an encoded list.
+size_t DecodeNeighborSize(const uint8_t* data);
+
+}  // namespace embedx
@@ -0,0 +1,101 @@
+// Tencent is pleased to support the open source community by making embedx
+// available.
+//
+// Copyright (C) 2021 THL A29 Limited, a Tencent company.  All rights reserved.
+//
+// Licensed under the BSD 3-Clause License and other third-party components,
+// please refer to LICENSE for details.
+//
+
+#include "src/io/storage/neighbor_codec.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>  // std::isinf, std::ldexp
+#include <cstdint>
+#include <vector>
+
+#include "src/common/data_types.h"
+
+namespace embedx {
+
+class NeighborCodecTest : public ::testing::Test {
+ protected:
+  // sorted, unsorted, large ids
+  const vec_pair_t NEIGHBOR = {{3, 0.5},       {4, 1.0},  {100, 2.5},
+                               {2, 0.25},      {7, 8.0},  {(int_t)-1, 3.0},
+                               {1ULL << 50, 1.5}};
+
+ protected:
+  void ExpectRoundTrip(const vec_pair_t& neighbor, WeightCodecEnum codec,
+                       float_t max_error) {
+    std::vector<uint8_t> bytes{0xff};  // lists may start anywhere
+    EncodeNeighbor(neighbor, codec, &bytes);
+    EXPECT_EQ(DecodeNeighborSize(bytes.data() + 1), neighbor.size());
+
+    NeighborDecoder decoder(bytes.data() + 1);
+    EXPECT_EQ(decoder.size(), neighbor.size());
+    vec_pair_t pairs;
+    decoder.DecodeAll(&pairs);
+    ASSERT_EQ(pairs.size(), neighbor.size());
+    for (size_t i = 0; i < pairs.size(); ++i) {
+      EXPECT_EQ(pairs[i].first, neighbor[i].first);
+      EXPECT_NEAR(pairs[i].second, neighbor[i].second, max_error);
+    }
+
+    pair_t pair;
+    EXPECT_FALSE(decoder.Next(&pair));
+  }
+};
+
+TEST_F(NeighborCodecTest, Float32) {
+  ExpectRoundTrip(NEIGHBOR, WeightCodecEnum::FLOAT32, 0);
+}
+
+TEST_F(NeighborCodecTest, Quant) {
+  // half a step of (8.0 - 0.25) / levels
+  ExpectRoundTrip(NEIGHBOR, WeightCodecEnum::QUANT16, 1e-4);
+  ExpectRoundTrip(NEIGHBOR, WeightCodecEnum::QUANT8, 0.016);
+}
+
+TEST_F(NeighborCodecTest, HalfFloat) {
+  // the weights of NEIGHBOR are exact in 16 bit floats
+  ExpectRoundTrip(NEIGHBOR, WeightCodecEnum::FLOAT16, 0);
+  ExpectRoundTrip(NEIGHBOR, WeightCodecEnum::BFLOAT16, 0);
+
+  // rounding, the largest half, overflow and subnormal halves
+  vec_pair_t neighbor = {{1, 0.1f}, {2, -65504}, {3, 1e5f}, {4, 1e-7f}};
+  std::vector<uint8_t> bytes;
+  EncodeNeighbor(neighbor, WeightCodecEnum::FLOAT16, &bytes);
+  vec_pair_t pairs;
+  NeighborDecoder(bytes.data()).DecodeAll(&pairs);
+  ASSERT_EQ(pairs.size(), 4u);
+  EXPECT_EQ(pairs[0].second, 0.0999755859375f);
+  EXPECT_EQ(pairs[1].second, -65504);
+  EXPECT_TRUE(std::isinf(pairs[2].second));
+  EXPECT_EQ(pairs[3].second, std::ldexp(2.0f, -24));
+
+  bytes.clear();
+  EncodeNeighbor(neighbor, WeightCodecEnum::BFLOAT16, &bytes);
+  NeighborDecoder(bytes.data()).DecodeAll(&pairs);
+  ASSERT_EQ(pairs.size(), 4u);
+  EXPECT_EQ(pairs[0].second, 0.10009765625f);
+  EXPECT_EQ(pairs[1].second, -65536);
+  EXPECT_EQ(pairs[2].second, 99840);
+  EXPECT_NEAR(pairs[3].second, 1e-7f, 1e-9f);
+}
+
+TEST_F(NeighborCodecTest, Constant) {
+  vec_pair_t neighbor = {{1, 1}, {2, 1}, {3, 1}};
+  std::vector<uint8_t> bytes;
+  EncodeNeighbor(neighbor, WeightCodecEnum::QUANT8, &bytes);
+  // size, mode, one weight and one byte per id
+  EXPECT_EQ(bytes.size(), 1u + 1u + 4u + 3u);
+  ExpectRoundTrip(neighbor, WeightCodecEnum::QUANT8, 0);
+}
+
+TEST_F(NeighborCodecTest, Empty) {
+  ExpectRoundTrip(vec_pair_t(), WeightCodecEnum::FLOAT32, 0);
+}
+
+}  // namespace embedx
@@ -14,10 +14,14 @@
 #include <string>
 
 #include "src/common/data_types.h"
+#include "src/common/memory_usage.h"
+#include "src/io/snapshot.h"
 #include "src/io/value.h"
 
 namespace embedx {
 
+class EdgeVector;
+
 class Storage {
  public:
   Storage() = default;
@@ -28,6 +32,9 @@ class Storage {
   virtual void Reserve(uint64_t estimated_size) = 0;
   virtual void Lock() = 0;
   virtual void UnLock() = 0;
+  virtual void Freeze() {}
+  // see AdjacencyImpl::BuildInDegree
+  virtual void BuildInDegree(int /*thread_num*/) {}
   virtual bool InsertContext(AdjValue*) { return true; }
   virtual bool InsertFeature(AdjValue*) { return true; }
   virtual bool InsertEdge(EdgeValue*) { return true; }
@@ -38,14 +45,29 @@ class Storage {
   virtual const vec_int_t& Keys() const noexcept = 0;
 
  public:
-  virtual const vec_pair_t* FindNeighbor(int_t node) const = 0;
+  virtual pair_view_t FindNeighbor(int_t node) const = 0;
+  // Dense ids of the nodes, see AdjacencyImpl::LookupRow.
+  virtual bool LookupRow(int_t node, int* row) const = 0;
+  virtual pair_view_t FindNeighborAt(int row) const = 0;
   virtual std::string Print(int_t node) const = 0;
   virtual int GetInDegree(int_t dst_node) const = 0;
   virtual int GetOutDegree(int_t src_node) const = 0;
+  // see AdjacencyImpl::CollectMemory
+  virtual void CollectMemory(MemoryUsage* usage) const = 0;
+
+ public:
+  virtual bool Dump(SnapshotWriter* writer) const = 0;
+  virtual bool Attach(SnapshotReader* reader) = 0;
 };
 
-std::unique_ptr<Storage> NewContextStorage(int store_type);
-std::unique_ptr<Storage> NewFeatureStorage(int store_type);
-std::unique_ptr<Storage> NewEdgeStorage(int store_type);
+// With 'partition_num' > 1, inserts from different threads no longer contend
+// on one lock, see NewAdjacency.
+std::unique_ptr<Storage> NewContextStorage(int store_type,
+                                           int partition_num = 1);
+std::unique_ptr<Storage> NewFeatureStorage(int store_type,
+                                           int partition_num = 1);
+// Serves the edges of 'edge_vector', which are built by the edge loader.
+std::unique_ptr<Storage> NewEdgeStorage(
+    std::unique_ptr<EdgeVector> edge_vector);
 
 }  // namespace embedx
@@ -13,8 +13,6 @@
 
 #include <deepx_core/dx_log.h>
 
-#include <random>  // std::random_device, std::default_random_engine
-
 #include "src/common/random.h"
 
 namespace embedx {
@@ -22,20 +20,30 @@ namespace {
 
 template <class Func>
 void FillLevelFeature(Func&& LookupFunc, const vec_set_t& level_nodes,
-                      float_t feat_mask_prob, csr_t* csr_feats) {
+                      float_t feat_mask_prob, uint64_t seed, csr_t* csr_feats) {
   csr_feats->clear();
 
+  // The masks of a node don't depend on the order of the nodes.
+  RandomStreamSeeder seeder(seed);
   vec_int_t tmp_nodes;
   std::vector<vec_pair_t> tmp_feats_list;
+  std::vector<float> randoms;
   for (const auto& level_node : level_nodes) {
     tmp_nodes.assign(level_node.begin(), level_node.end());
     LookupFunc(tmp_nodes, &tmp_feats_list);
 
     for (size_t j = 0; j < tmp_nodes.size(); ++j) {
-      for (const auto& entry : tmp_feats_list[j]) {
+      const auto& feats = tmp_feats_list[j];
+      // All features are kept without masking.
+      randoms.assign(feats.size(), 0);
+      if (feat_mask_prob > 0) {
+        RandomSeedScope scope(seeder.Next(tmp_nodes[j]));
+        FillUniform(randoms.data(), randoms.size());
+      }
+      for (size_t k = 0; k < feats.size(); ++k) {
         // Consistent with tf and pytorch mask operations
-        if (ThreadLocalRandom() <= 1.0 - feat_mask_prob) {
-          csr_feats->emplace(entry.first, entry.second);
+        if (randoms[k] <= 1.0 - feat_mask_prob) {
+          csr_feats->emplace(feats[k].first, feats[k].second);
         }
       }
       csr_feats->add_row();
@@ -92,9 +100,8 @@ void NeighborAggregationFlow::ShuffleNodesInBatch(
                            level_node.end());
   }
 
-  static thread_local std::random_device rd;
-  static thread_local std::default_random_engine rng(rd());
-  std::shuffle(shuffled_nodes->begin(), shuffled_nodes->end(), rng);
+  RandomSeedScope scope(graph_client_.NextSampleSeed());
+  ThreadLocalShuffle(shuffled_nodes->begin(), shuffled_nodes->end());
 }
 
 void NeighborAggregationFlow::ShuffleNodesInGlobal(
@@ -167,7 +174,8 @@ void NeighborAggregationFlow::FillLevelNodeFeature(
                   std::vector<vec_pair_t>* tmp_feats_list) {
     graph_client_.LookupNodeFeature(nodes, tmp_feats_list);
   };
-  FillLevelFeature(f, level_nodes, feat_mask_prob_, feat_ptr);
+  FillLevelFeature(f, level_nodes, feat_mask_prob_,
+                   graph_client_.NextSampleSeed(), feat_ptr);
 }
 
 void NeighborAggregationFlow::FillLevelNeighFeature(
@@ -178,7 +186,8 @@ void NeighborAggregationFlow::FillLevelNeighFeature(
                   std::vector<vec_pair_t>* tmp_feats_list) {
     graph_client_.LookupNeighborFeature(nodes, tmp_feats_list);
   };
-  FillLevelFeature(f, level_nodes, feat_mask_prob_, feat_ptr);
+  FillLevelFeature(f, level_nodes, feat_mask_prob_,
+                   graph_client_.NextSampleSeed(), feat_ptr);
 }
 
 void NeighborAggregationFlow::FillSelfAndNeighGraphBlock(
@@ -186,6 +195,8 @@ void NeighborAggregationFlow::FillSelfAndNeighGraphBlock(
     const vec_set_t& level_nodes, const vec_map_neigh_t& level_neighs,
     const std::vector<Indexing>& indexings, bool add_self) const {
   int graph_depth = level_neighs.size() - 1;
+  RandomStreamSeeder seeder(graph_client_.NextSampleSeed());
+  std::vector<float> randoms;
   for (int i = 0; i < graph_depth; ++i) {
     auto* self_block =
         &inst->get_or_insert<csr_t>(self_name + std::to_string(i));
@@ -203,10 +214,16 @@ void NeighborAggregationFlow::FillSelfAndNeighGraphBlock(
         self_block->add_row();
 
         // Fill neighbor node block
-        for (auto neigh_node : level_neighs[j].at(node)) {
+        const auto& neigh_nodes = level_neighs[j].at(node);
+        randoms.assign(neigh_nodes.size(), 0);
+        if (edge_drop_prob_ > 0) {
+          RandomSeedScope scope(seeder.Next(node));
+          FillUniform(randoms.data(), randoms.size());
+        }
+        for (size_t k = 0; k < neigh_nodes.size(); ++k) {
           // Consistent with tf and pytorch drop operations
-          if (ThreadLocalRandom() <= 1.0 - edge_drop_prob_) {
-            auto neigh_id = indexings[j + 1].Get(neigh_node);
+          if (randoms[k] <= 1.0 - edge_drop_prob_) {
+            auto neigh_id = indexings[j + 1].Get(neigh_nodes[k]);
             DXCHECK(neigh_id >= 0);
             neigh_block->emplace(neigh_id, 1);
           }
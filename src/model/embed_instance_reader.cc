@@ -13,6 +13,10 @@
 
 #include <deepx_core/dx_log.h>
 
+#include <functional>  // std::hash
+
+#include "src/common/random.h"
+
 namespace embedx {
 
 bool EmbedInstanceReader::InitGraphClient(const GraphClient* graph_client) {
@@ -24,6 +28,15 @@ bool EmbedInstanceReader::InitGraphClient(const GraphClient* graph_client) {
   return true;
 }
 
+void EmbedInstanceReader::ResetSampleBatch(const std::string& file) {
+  file_key_ = std::hash<std::string>()(file);
+  batch_index_ = 0;
+}
+
+void EmbedInstanceReader::NextSampleBatch() {
+  GraphClient::SetSampleBatch(Philox4x32(file_key_, 0, batch_index_++));
+}
+
 bool EmbedInstanceReader::InitDeepClient(const DeepClient* deep_client) {
   if (deep_client == nullptr) {
     DXERROR("Deep_client is nullptr.");
@@ -14,6 +14,7 @@
 #include <deepx_core/graph/instance_reader_impl.h>
 #include <deepx_core/graph/tensor_map.h>  // Instance
 
+#include <cstdint>
 #include <memory>  // std::unique_ptr
 #include <string>
 #include <vector>
@@ -30,6 +31,10 @@ using ::deepx_core::InstanceReader;
 using ::deepx_core::InstanceReaderImpl;
 
 class EmbedInstanceReader : public InstanceReaderImpl {
+ private:
+  uint64_t file_key_ = 0;
+  uint64_t batch_index_ = 0;
+
  protected:
   const GraphClient* graph_client_ = nullptr;
   const DeepClient* deep_client_ = nullptr;
@@ -42,6 +47,7 @@ class EmbedInstanceReader : public InstanceReaderImpl {
   virtual void PostInit(const std::string& /*node_config*/) {}
 
   bool Open(const std::string& file) override {
+    ResetSampleBatch(file);
     return line_parser_.Open(file);
   }
 
@@ -54,9 +60,16 @@ class EmbedInstanceReader : public InstanceReaderImpl {
       inst->clear_batch();
       return false;
     }
+    NextSampleBatch();
     return true;
   }
 
+  // Sampling batches are keyed by the file and their index in it, so that
+  // seeded sampling doesn't depend on which thread reads the file, see
+  // GraphClient::SeedSampling.
+  void ResetSampleBatch(const std::string& file);
+  void NextSampleBatch();
+
   // InstanceReaderImpl
   void InitX(Instance* /* inst */) override {}
   void InitXBatch(Instance* /*inst*/) override {}
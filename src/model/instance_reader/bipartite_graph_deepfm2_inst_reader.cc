@@ -131,6 +131,7 @@ class BipartiteDeepFM2InstReader : public EmbedInstanceReader {
   }
 
   bool Open(const std::string& file) override {
+    ResetSampleBatch(file);
     return InstanceReaderImpl::Open(file);
   }
 
@@ -146,6 +147,7 @@ class BipartiteDeepFM2InstReader : public EmbedInstanceReader {
       }
       ret_flag = false;
     }
+    NextSampleBatch();
 
     // Parse user and item nodes from instance
     vec_int_t user_nodes, item_nodes;
@@ -130,6 +130,7 @@ class GraphDeepFM2InstReader : public EmbedInstanceReader {
   }
 
   bool Open(const std::string& file) override {
+    ResetSampleBatch(file);
     return InstanceReaderImpl::Open(file);
   }
 
@@ -145,6 +146,7 @@ class GraphDeepFM2InstReader : public EmbedInstanceReader {
       }
       ret_flag = false;
     }
+    NextSampleBatch();
 
     // Parse user and item nodes from instance
     vec_int_t user_nodes, item_nodes;
@@ -15,6 +15,7 @@
 
 #include <vector>
 
+#include "src/common/random.h"
 #include "src/io/indexing_wrapper.h"
 #include "src/io/value.h"
 #include "src/model/data_flow/neighbor_aggregation_flow.h"
@@ -144,8 +145,11 @@ class NodeInfoGraphInstReader : public EmbedInstanceReader {
     int instance_sample_count =
         (int)(instance_sample_prob_ * src_nodes_.size());
     DXCHECK(instance_sample_count > 0);
-    DXCHECK(deep_client_->SampleInstance(instance_sample_count, &labeled_nodes_,
-                                         &vec_labels_list_));
+    {
+      RandomSeedScope scope(graph_client_->NextSampleSeed());
+      DXCHECK(deep_client_->SampleInstance(
+          instance_sample_count, &labeled_nodes_, &vec_labels_list_));
+    }
 
     // merge nodes
     merged_nodes_.clear();
@@ -12,10 +12,10 @@
 #include <deepx_core/common/str_util.h>
 #include <deepx_core/dx_log.h>
 
-#include <algorithm>  // std::shuffle, std::max, std::min
-#include <random>     // std::random_device, std::default_random_engine
+#include <algorithm>  // std::max, std::min
 #include <vector>
 
+#include "src/common/random.h"
 #include "src/io/indexing_wrapper.h"
 #include "src/io/value.h"
 #include "src/model/data_flow/neighbor_aggregation_flow.h"
@@ -27,13 +27,21 @@ namespace embedx {
 namespace {
 
 void DiscardNodeAndLabel(vec_int_t* nodes, std::vector<vecl_t>* labels_list,
-                         int num_remain) {
-  static thread_local std::random_device rd;
-  auto seed = (uint64_t)rd();
-  static thread_local std::default_random_engine rng(seed);
-  std::shuffle(nodes->begin(), nodes->end(), rng);
-  rng.seed(seed);
-  std::shuffle(labels_list->begin(), labels_list->end(), rng);
+                         int num_remain, uint64_t seed) {
+  uint64_t perm_seed = 0;
+  {
+    RandomSeedScope scope(seed);
+    perm_seed = ThreadLocalRandomEngine().Next() | 1;
+  }
+  // Both are shuffled by the same permutation.
+  {
+    RandomSeedScope scope(perm_seed);
+    ThreadLocalShuffle(nodes->begin(), nodes->end());
+  }
+  {
+    RandomSeedScope scope(perm_seed);
+    ThreadLocalShuffle(labels_list->begin(), labels_list->end());
+  }
   nodes->erase(nodes->begin() + num_remain, nodes->end());
   labels_list->erase(labels_list->begin() + num_remain, labels_list->end());
 }
@@ -172,7 +180,8 @@ class SemisupGraphsageInstReader : public EmbedInstanceReader {
     int num_remain =
         std::max(min_batch_, (int)((1.0 - discard_prob_) * nodes_.size()));
     num_remain = std::min(num_remain, (int)nodes_.size());
-    DiscardNodeAndLabel(&nodes_, &labels_list_, num_remain);
+    DiscardNodeAndLabel(&nodes_, &labels_list_, num_remain,
+                        graph_client_->NextSampleSeed());
 
     // merge nodes to avoid repeated construction of node computation graph.
     merged_nodes_.clear();
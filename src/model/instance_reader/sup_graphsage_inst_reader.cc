@@ -123,6 +123,7 @@ class SupGraphsageInstReader : public EmbedInstanceReader {
       inst->clear_batch();
       return false;
     }
+    NextSampleBatch();
     nodes_ =
         Collect<NodeAndLabelValue, int_t>(values, &NodeAndLabelValue::node);
     labels_list_ =
@@ -175,6 +176,7 @@ class SupGraphsageInstReader : public EmbedInstanceReader {
       inst->clear_batch();
       return false;
     }
+    NextSampleBatch();
     nodes_ = Collect<NodeValue, int_t>(values, &NodeValue::node);
 
     // Sample subgraph
@@ -82,6 +82,7 @@ bool UnsupBipartiteInstReader::GetTrainBatch(Instance* inst) {
     inst->clear_batch();
     return false;
   }
+  NextSampleBatch();
 
   src_nodes_ = Collect<EdgeValue, int_t>(values, &EdgeValue::src_node);
   dst_nodes_ = Collect<EdgeValue, int_t>(values, &EdgeValue::dst_node);
@@ -127,6 +128,7 @@ bool UnsupBipartiteInstReader::GetPredictBatch(Instance* inst) {
     inst->clear_batch();
     return false;
   }
+  NextSampleBatch();
 
   src_nodes_ = Collect<NodeValue, int_t>(values, &NodeValue::node);
 
@@ -10,10 +10,12 @@
 //
 
 #pragma once
+#include <cstdint>
 #include <memory>  // std::unique_ptr
 #include <vector>
 
 #include "src/common/data_types.h"
+#include "src/sampler/negative_sampler/excluded_node_set.h"
 #include "src/sampler/sampler_builder.h"
 
 namespace embedx {
@@ -28,13 +30,20 @@ class NegativeSampler {
   virtual ~NegativeSampler() = default;
 
  public:
+  bool Sample(int count, const vec_int_t& nodes,
+              const vec_int_t& excluded_nodes,
+              std::vector<vec_int_t>* sampled_nodes_list) const {
+    return Sample(count, nodes, excluded_nodes, 0, sampled_nodes_list);
+  }
+  // Like Sample, the negatives are drawn from streams keyed by 'seed', see
+  // RandomStreamSeeder.
   virtual bool Sample(int count, const vec_int_t& nodes,
-                      const vec_int_t& excluded_nodes,
+                      const vec_int_t& excluded_nodes, uint64_t seed,
                       std::vector<vec_int_t>* sampled_nodes_list) const = 0;
 
  protected:
   bool DoSampling(int count, const vec_int_t& candidates,
-                  const vec_int_t& excluded_nodes,
+                  const ExcludedNodeSet& excluded_nodes,
                   vec_int_t* sampled_nodes) const;
 };
 
@@ -0,0 +1,42 @@
+// Tencent is pleased to support the open source community by making embedx
+// available.
+//
+// Copyright (C) 2021 THL A29 Limited, a Tencent company.  All rights reserved.
+//
+// Licensed under the BSD 3-Clause License and other third-party components,
+// please refer to LICENSE for details.
+//
+
+#include "src/sampler/negative_sampler/excluded_node_set.h"
+
+#include <algorithm>  // std::sort, std::unique
+
+namespace embedx {
+
+constexpr size_t ExcludedNodeSet::FILTER_MIN_SIZE;
+
+void ExcludedNodeSet::Build(const vec_int_t& nodes) {
+  nodes_ = nodes;
+  std::sort(nodes_.begin(), nodes_.end());
+  nodes_.erase(std::unique(nodes_.begin(), nodes_.end()), nodes_.end());
+
+  filter_.clear();
+  filter_shift_ = 64;
+  if (nodes_.size() < FILTER_MIN_SIZE) {
+    return;
+  }
+
+  // 2^bits >= 8 * size
+  int bits = 9;
+  while (((size_t)1 << bits) < nodes_.size() * 8) {
+    ++bits;
+  }
+  filter_shift_ = 64 - bits;
+  filter_.assign(((size_t)1 << bits) / 64, 0);
+  for (auto node : nodes_) {
+    uint64_t bit = Hash(node);
+    filter_[bit >> 6] |= (uint64_t)1 << (bit & 63);
+  }
+}
+
+}  // namespace embedx
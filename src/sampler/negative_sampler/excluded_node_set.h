@@ -0,0 +1,71 @@
+// Tencent is pleased to support the open source community by making embedx
+// available.
+//
+// Copyright (C) 2021 THL A29 Limited, a Tencent company.  All rights reserved.
+//
+// Licensed under the BSD 3-Clause License and other third-party components,
+// please refer to LICENSE for details.
+//
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "src/common/data_types.h"
+
+namespace embedx {
+
+// Nodes excluded from negative sampling, built once per call.
+//
+// Nodes are kept sorted and searched without branches. Large sets also keep
+// a one-hash bloom filter of about 8 bits per node, most draws are not
+// excluded and are rejected by one load.
+class ExcludedNodeSet {
+ private:
+  static constexpr size_t FILTER_MIN_SIZE = 64;
+
+ private:
+  vec_int_t nodes_;
+  std::vector<uint64_t> filter_;
+  int filter_shift_ = 64;
+
+ public:
+  ExcludedNodeSet() = default;
+  explicit ExcludedNodeSet(const vec_int_t& nodes) { Build(nodes); }
+
+ public:
+  void Build(const vec_int_t& nodes);
+
+  bool empty() const noexcept { return nodes_.empty(); }
+  size_t size() const noexcept { return nodes_.size(); }
+
+  bool Contains(int_t node) const noexcept {
+    if (nodes_.empty()) {
+      return false;
+    }
+    if (!filter_.empty()) {
+      uint64_t bit = Hash(node);
+      if (!((filter_[bit >> 6] >> (bit & 63)) & 1)) {
+        return false;
+      }
+    }
+
+    // the last node not greater than 'node', or the first one
+    const int_t* base = nodes_.data();
+    size_t n = nodes_.size();
+    while (n > 1) {
+      size_t half = n / 2;
+      base = base[half] <= node ? base + half : base;
+      n -= half;
+    }
+    return *base == node;
+  }
+
+ private:
+  uint64_t Hash(int_t node) const noexcept {
+    return (node * 0x9e3779b97f4a7c15ULL) >> filter_shift_;
+  }
+};
+
+}  // namespace embedx
@@ -0,0 +1,65 @@
+// Tencent is pleased to support the open source community by making embedx
+// available.
+//
+// Copyright (C) 2021 THL A29 Limited, a Tencent company.  All rights reserved.
+//
+// Licensed under the BSD 3-Clause License and other third-party components,
+// please refer to LICENSE for details.
+//
+
+#include "src/sampler/negative_sampler/excluded_node_set.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>  // std::find
+#include <vector>
+
+#include "src/common/data_types.h"
+
+namespace embedx {
+
+class ExcludedNodeSetTest : public ::testing::Test {
+ protected:
+  static void ExpectSame(const vec_int_t& nodes, int_t max_node) {
+    ExcludedNodeSet excluded_set(nodes);
+    for (int_t node = 0; node <= max_node; ++node) {
+      bool expected =
+          std::find(nodes.begin(), nodes.end(), node) != nodes.end();
+      EXPECT_EQ(excluded_set.Contains(node), expected) << node;
+    }
+  }
+};
+
+TEST_F(ExcludedNodeSetTest, Empty) {
+  ExcludedNodeSet excluded_set;
+  EXPECT_TRUE(excluded_set.empty());
+  EXPECT_FALSE(excluded_set.Contains(0));
+
+  excluded_set.Build({});
+  EXPECT_FALSE(excluded_set.Contains(0));
+}
+
+TEST_F(ExcludedNodeSetTest, Small) {
+  // unsorted, with duplicates
+  vec_int_t nodes = {10, 1, 7, 10, 3};
+  ExpectSame(nodes, 12);
+  EXPECT_EQ(ExcludedNodeSet(nodes).size(), 4u);
+  ExpectSame({5}, 8);
+}
+
+TEST_F(ExcludedNodeSetTest, Large) {
+  // filtered, node types in the high bits
+  vec_int_t nodes;
+  for (int_t i = 0; i < 1000; ++i) {
+    nodes.emplace_back(i * 3);
+    nodes.emplace_back(((int_t)1 << 48) | (i * 5));
+  }
+  ExcludedNodeSet excluded_set(nodes);
+  for (int_t i = 0; i < 5000; ++i) {
+    EXPECT_EQ(excluded_set.Contains(i), i % 3 == 0 && i < 3000) << i;
+    int_t typed = ((int_t)1 << 48) | i;
+    EXPECT_EQ(excluded_set.Contains(typed), i % 5 == 0) << i;
+  }
+}
+
+}  // namespace embedx
@@ -13,6 +13,7 @@
 #include <memory>     // std::unique_ptr
 
 #include "src/common/data_types.h"
+#include "src/common/random.h"
 #include "src/io/io_util.h"
 #include "src/sampler/negative_sampler.h"
 
@@ -25,8 +26,9 @@ class IndepNegativeSampler : public NegativeSampler {
   ~IndepNegativeSampler() override = default;
 
  public:
+  using NegativeSampler::Sample;
   bool Sample(int count, const vec_int_t& nodes,
-              const vec_int_t& excluded_nodes,
+              const vec_int_t& excluded_nodes, uint64_t seed,
               std::vector<vec_int_t>* sampled_nodes_list) const override {
     sampled_nodes_list->clear();
     sampled_nodes_list->resize(nodes.size());
@@ -34,7 +36,10 @@ class IndepNegativeSampler : public NegativeSampler {
     const auto& sampler_source = sampler_builder_.sampler_source();
     const auto& id_name_map = sampler_source.id_name_map();
     // sample per node
+    ExcludedNodeSet excluded_set(excluded_nodes);
+    RandomStreamSeeder seeder(seed);
     for (size_t i = 0; i < nodes.size(); ++i) {
+      RandomSeedScope scope(seeder.Next(nodes[i]));
       auto ns_id = io_util::GetNodeType(nodes[i]);
       if (id_name_map.find(ns_id) == id_name_map.end()) {
         DXERROR("Couldn't find node: %" PRIu64
@@ -45,7 +50,7 @@ class IndepNegativeSampler : public NegativeSampler {
 
       auto& uniq_nodes = sampler_source.nodes_list()[ns_id];
       auto& sampled_nodes = (*sampled_nodes_list)[i];
-      if (!DoSampling(count, uniq_nodes, excluded_nodes, &sampled_nodes)) {
+      if (!DoSampling(count, uniq_nodes, excluded_set, &sampled_nodes)) {
         return false;
       }
     }
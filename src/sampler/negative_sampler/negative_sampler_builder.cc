@@ -16,6 +16,7 @@
 
 #include <cmath>
 #include <utility>  // std::move
+#include <vector>
 
 #include "src/common/random.h"
 #include "src/io/io_util.h"
@@ -39,24 +40,34 @@ void NormalizeProbs(const vec_float_t& probs, vec_float_t* norm_probs) {
 }  // namespace
 
 std::unique_ptr<SamplerBuilder> NegativeSamplerBuilder::Create(
-    const SamplerSource* sampler_source, int sampler_type, int thread_num) {
+    const SamplerSource* sampler_source, int sampler_type, int thread_num,
+    SnapshotReader* reader) {
   std::unique_ptr<SamplerBuilder> sampler_builder;
   sampler_builder.reset(
       new NegativeSamplerBuilder(sampler_source, sampler_type, thread_num));
-  if (!sampler_builder->Init()) {
+  bool ok = reader ? sampler_builder->Load(reader) : sampler_builder->Init();
+  if (!ok) {
     DXERROR("Failed to init negative sampler builder.");
     sampler_builder.reset();
   }
   return sampler_builder;
 }
 
+void NegativeSamplerBuilder::CollectMemory(MemoryUsage* usage) const {
+  for (const auto& sampling : samplings_) {
+    if (sampling) {
+      sampling->CollectMemory(usage);
+    }
+  }
+}
+
 bool NegativeSamplerBuilder::InitUniformFuncs() {
   DXINFO("Initing uniform negative sampler funcs...");
 
   next_func_ = [this](int_t cur_node, int_t* next_node) -> bool {
     auto ns_id = io_util::GetNodeType(cur_node);
     auto& candidate_nodes = sampler_source_.nodes_list()[ns_id];
-    int k = int(ThreadLocalRandom() * candidate_nodes.size());
+    int k = (int)ThreadLocalRandomRange(candidate_nodes.size());
     *next_node = candidate_nodes[k];
     return true;
   };
@@ -65,11 +76,23 @@ bool NegativeSamplerBuilder::InitUniformFuncs() {
                             int_t* next_node) -> bool {
     auto ns_id = io_util::GetNodeType(cur_node);
     auto& candidate_nodes = sampler_source_.nodes_list()[ns_id];
-    int k = begin + int(ThreadLocalRandom() * (end - begin));
+    int k = begin + (int)ThreadLocalRandomRange(end - begin);
     *next_node = candidate_nodes[k];
     return true;
   };
 
+  next_n_func_ = [this](int_t cur_node, int count,
+                        vec_int_t* next_nodes) -> bool {
+    auto ns_id = io_util::GetNodeType(cur_node);
+    auto& candidate_nodes = sampler_source_.nodes_list()[ns_id];
+    auto& engine = ThreadLocalRandomEngine();
+    next_nodes->resize(count);
+    for (auto& next_node : *next_nodes) {
+      next_node = candidate_nodes[engine.NextRange(candidate_nodes.size())];
+    }
+    return true;
+  };
+
   DXINFO("Done.");
   return true;
 }
@@ -126,14 +149,78 @@ bool NegativeSamplerBuilder::InitFrequencyFuncs() {
     return true;
   };
 
+  next_n_func_ = [this](int_t cur_node, int count,
+                        vec_int_t* next_nodes) -> bool {
+    auto ns_id = io_util::GetNodeType(cur_node);
+    auto& candidate_nodes = sampler_source_.nodes_list()[ns_id];
+    if (!samplings_[ns_id]) {
+      DXERROR("The sampler of namespace: %d is nullptr.", (int)ns_id);
+      return false;
+    }
+
+    samplings_[ns_id]->NextN(count, next_nodes);
+    for (auto& next_node : *next_nodes) {
+      next_node = candidate_nodes[next_node];
+    }
+    return true;
+  };
+
+  DXINFO("Done.");
+  return true;
+}
+
+bool NegativeSamplerBuilder::DumpFrequencySampler(
+    SnapshotWriter* writer) const {
+  std::vector<uint16_t> ns_ids;
+  for (size_t ns_id = 0; ns_id < samplings_.size(); ++ns_id) {
+    if (samplings_[ns_id]) {
+      ns_ids.emplace_back((uint16_t)ns_id);
+    }
+  }
+
+  if (!writer->WriteArray(ns_ids)) {
+    return false;
+  }
+  for (auto ns_id : ns_ids) {
+    if (!samplings_[ns_id]->Dump(writer)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool NegativeSamplerBuilder::LoadFrequencySampler(SnapshotReader* reader) {
+  DXINFO("Loading frequency negative sampler, with sampler_type: %d...",
+         sampling_type_);
+  std::vector<uint16_t> ns_ids;
+  if (!reader->ReadArray(&ns_ids)) {
+    return false;
+  }
+
+  samplings_.clear();
+  samplings_.resize(sampler_source_.ns_size());
+  for (auto ns_id : ns_ids) {
+    if (ns_id >= samplings_.size()) {
+      DXERROR("Need namespace id < %zu, got namespace id: %d in snapshot.",
+              samplings_.size(), (int)ns_id);
+      return false;
+    }
+    auto sampling = NewSampling(reader, (SamplingEnum)sampling_type_);
+    if (!sampling) {
+      return false;
+    }
+    samplings_[ns_id] = std::move(sampling);
+  }
+
   DXINFO("Done.");
   return true;
 }
 
 std::unique_ptr<SamplerBuilder> NewNegativeSamplerBuilder(
-    const SamplerSource* sampler_source, int sampler_type, int thread_num) {
+    const SamplerSource* sampler_source, int sampler_type, int thread_num,
+    SnapshotReader* reader) {
   return NegativeSamplerBuilder::Create(sampler_source, sampler_type,
-                                        thread_num);
+                                        thread_num, reader);
 }
 
 }  // namespace embedx
@@ -31,12 +31,18 @@ class NegativeSamplerBuilder : public SamplerBuilder {
 
  public:
   static std::unique_ptr<SamplerBuilder> Create(
-      const SamplerSource* sampler_source, int sampler_type, int thread_num);
+      const SamplerSource* sampler_source, int sampler_type, int thread_num,
+      SnapshotReader* reader = nullptr);
+
+ public:
+  void CollectMemory(MemoryUsage* usage) const override;
 
  private:
   bool InitUniformFuncs() override;
   bool InitFrequencySampler() override;
   bool InitFrequencyFuncs() override;
+  bool DumpFrequencySampler(SnapshotWriter* writer) const override;
+  bool LoadFrequencySampler(SnapshotReader* reader) override;
 
  private:
   NegativeSamplerBuilder(const SamplerSource* sampler_source, int sampler_type,
@@ -12,6 +12,7 @@
 #include <memory>  // std::unique_ptr
 
 #include "src/common/data_types.h"
+#include "src/common/random.h"
 #include "src/io/io_util.h"
 #include "src/sampler/negative_sampler.h"
 
@@ -24,8 +25,9 @@ class SharedNegativeSampler : public NegativeSampler {
   ~SharedNegativeSampler() override = default;
 
  public:
+  using NegativeSampler::Sample;
   bool Sample(int count, const vec_int_t& nodes,
-              const vec_int_t& excluded_nodes,
+              const vec_int_t& excluded_nodes, uint64_t seed,
               std::vector<vec_int_t>* sampled_nodes_list) const override {
     const auto& sampler_source = sampler_builder_.sampler_source();
     std::unordered_set<uint16_t> ns_id_set;
@@ -34,8 +36,11 @@ class SharedNegativeSampler : public NegativeSampler {
     sampled_nodes_list->resize(sampler_source.ns_size());
 
     const auto& id_name_map = sampler_source.id_name_map();
-    // sample per namespace
+    // sample per namespace, one stream each
+    ExcludedNodeSet excluded_set(excluded_nodes);
+    RandomStreamSeeder seeder(seed);
     for (auto ns_id : ns_id_set) {
+      RandomSeedScope scope(seeder.Next(ns_id));
       if (id_name_map.find(ns_id) == id_name_map.end()) {
         DXERROR("Invalid ns_id: %d !", (int)ns_id);
         return false;
@@ -43,7 +48,7 @@ class SharedNegativeSampler : public NegativeSampler {
 
       auto& uniq_nodes = sampler_source.nodes_list()[ns_id];
       auto& sampled_nodes = (*sampled_nodes_list)[ns_id];
-      if (!DoSampling(count, uniq_nodes, excluded_nodes, &sampled_nodes)) {
+      if (!DoSampling(count, uniq_nodes, excluded_set, &sampled_nodes)) {
         return false;
       }
     }
@@ -11,6 +11,7 @@
 //
 
 #pragma once
+#include <cstdint>
 #include <memory>  // std::unique_ptr
 #include <vector>
 
@@ -30,6 +31,10 @@ class NeighborSampler {
  public:
   bool Sample(int count, const vec_int_t& nodes,
               std::vector<vec_int_t>* neighbor_nodes_list) const;
+  // Like Sample, the neighbors of each node are drawn from a stream keyed by
+  // 'seed', the node and its occurrence, see RandomStreamSeeder.
+  bool Sample(int count, const vec_int_t& nodes, uint64_t seed,
+              std::vector<vec_int_t>* neighbor_nodes_list) const;
 
  private:
   void DoSampling(int_t node, int count, vec_int_t* neighbor_nodes) const;
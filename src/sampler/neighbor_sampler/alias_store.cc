@@ -0,0 +1,198 @@
+// Tencent is pleased to support the open source community by making embedx
+// available.
+//
+// Copyright (C) 2021 THL A29 Limited, a Tencent company.  All rights reserved.
+//
+// Licensed under the BSD 3-Clause License and other third-party components,
+// please refer to LICENSE for details.
+//
+
+#include "src/sampler/neighbor_sampler/alias_store.h"
+
+#include <deepx_core/dx_log.h>
+
+#include <algorithm>  // std::copy, std::lower_bound
+#include <cinttypes>  // PRIu64
+#include <utility>    // std::pair
+
+#include "src/io/io_util.h"
+
+namespace embedx {
+
+bool AliasStore::Build(const SamplerSource& sampler_source, int thread_num) {
+  int rows = (int)sampler_source.node_keys().size();
+  offsets_.assign(rows + 1, 0);
+  for (int row = 0; row < rows; ++row) {
+    offsets_[row + 1] =
+        offsets_[row] + sampler_source.FindContextAt(row).size();
+  }
+  probs_.assign(offsets_.back(), 0);
+  aliases_.assign(offsets_.back(), 0);
+
+  // Rows are split by the number of neighbors, so that the threads fill
+  // about the same number of entries. Ranges are disjoint, no lock is needed.
+  std::vector<std::pair<int, int>> ranges;
+  int begin = 0;
+  for (int i = 1; i <= thread_num; ++i) {
+    uint64_t bound = offsets_.back() * i / thread_num;
+    int end = i == thread_num
+                  ? rows
+                  : (int)(std::lower_bound(offsets_.begin() + begin,
+                                           offsets_.begin() + rows, bound) -
+                          offsets_.begin());
+    ranges.emplace_back(begin, end);
+    begin = end;
+  }
+
+  return io_util::ParallelProcess<std::pair<int, int>>(
+      ranges,
+      [this, &sampler_source](const std::vector<std::pair<int, int>>& ranges,
+                              int /*thread_id*/) {
+        for (const auto& range : ranges) {
+          if (!BuildRows(sampler_source, range.first, range.second)) {
+            return false;
+          }
+        }
+        return true;
+      },
+      thread_num);
+}
+
+bool AliasStore::BuildRows(const SamplerSource& sampler_source, int begin,
+                           int end) {
+  std::vector<int> smaller;
+  std::vector<int> larger;
+  for (int row = begin; row < end; ++row) {
+    auto context = sampler_source.FindContextAt(row);
+    if (context.empty()) {
+      DXERROR("Couldn't find row: %d context.", row);
+      return false;
+    }
+
+    float_t sum = 0;
+    for (const auto& entry : context) {
+      if (entry.second <= 0) {
+        DXERROR("Weight %f of row: %d and neighbor: %" PRIu64
+                " must be greater than 0.",
+                entry.second, row, entry.first);
+        return false;
+      }
+      sum += entry.second;
+    }
+
+    int size = (int)context.size();
+    float_t* probs = &probs_[offsets_[row]];
+    int* aliases = &aliases_[offsets_[row]];
+    smaller.clear();
+    larger.clear();
+    for (int i = 0; i < size; ++i) {
+      probs[i] = context[i].second * size / sum;
+      aliases[i] = i;
+      if (probs[i] < 1) {
+        smaller.emplace_back(i);
+      } else {
+        larger.emplace_back(i);
+      }
+    }
+
+    while (!smaller.empty() && !larger.empty()) {
+      int s = smaller.back();
+      smaller.pop_back();
+      int l = larger.back();
+      larger.pop_back();
+
+      aliases[s] = l;
+      probs[l] += probs[s] - (float_t)1.0;
+      if (probs[l] < 1) {
+        smaller.emplace_back(l);
+      } else {
+        larger.emplace_back(l);
+      }
+    }
+
+    // The rest are 1 up to rounding errors.
+    for (int i : smaller) {
+      probs[i] = 1;
+    }
+    for (int i : larger) {
+      probs[i] = 1;
+    }
+  }
+  return true;
+}
+
+bool AliasStore::Dump(const SamplerSource& sampler_source,
+                      SnapshotWriter* writer) const {
+  // Nodes are written in row order, rows may differ after loading.
+  vec_int_t nodes(row_size());
+  for (auto node : sampler_source.node_keys()) {
+    int row = 0;
+    if (sampler_source.LookupRow(node, &row)) {
+      nodes[row] = node;
+    }
+  }
+
+  return writer->WriteArray(nodes) && writer->WriteArray(offsets_) &&
+         writer->WriteArray(probs_) && writer->WriteArray(aliases_);
+}
+
+bool AliasStore::Load(const SamplerSource& sampler_source,
+                      SnapshotReader* reader) {
+  ArrayView<int_t> nodes;
+  ArrayView<uint64_t> offsets;
+  ArrayView<float_t> probs;
+  ArrayView<int> aliases;
+  if (!reader->ReadArray(&nodes) || !reader->ReadArray(&offsets) ||
+      !reader->ReadArray(&probs) || !reader->ReadArray(&aliases)) {
+    return false;
+  }
+
+  size_t rows = sampler_source.node_keys().size();
+  if (nodes.size() != rows || offsets.size() != rows + 1 ||
+      offsets.back() != probs.size() || probs.size() != aliases.size()) {
+    DXERROR("Invalid alias store of %zu nodes in snapshot.", nodes.size());
+    return false;
+  }
+
+  std::vector<int> node_rows(rows);
+  offsets_.assign(rows + 1, 0);
+  for (size_t i = 0; i < rows; ++i) {
+    int row = 0;
+    if (!sampler_source.LookupRow(nodes[i], &row)) {
+      DXERROR("Couldn't find node: %" PRIu64 " context.", nodes[i]);
+      return false;
+    }
+    if (offsets[i + 1] < offsets[i] ||
+        offsets[i + 1] - offsets[i] !=
+            sampler_source.FindContextAt(row).size()) {
+      DXERROR("Alias table of node: %" PRIu64 " doesn't match its context.",
+              nodes[i]);
+      return false;
+    }
+    node_rows[i] = row;
+    offsets_[row + 1] = offsets[i + 1] - offsets[i];
+  }
+  for (size_t row = 0; row < rows; ++row) {
+    offsets_[row + 1] += offsets_[row];
+  }
+
+  probs_.resize(probs.size());
+  aliases_.resize(aliases.size());
+  for (size_t i = 0; i < rows; ++i) {
+    auto offset = offsets_[node_rows[i]];
+    std::copy(probs.begin() + offsets[i], probs.begin() + offsets[i + 1],
+              probs_.begin() + offset);
+    std::copy(aliases.begin() + offsets[i], aliases.begin() + offsets[i + 1],
+              aliases_.begin() + offset);
+  }
+  return true;
+}
+
+void AliasStore::CollectMemory(MemoryUsage* usage) const {
+  usage->Add("alias_store",
+             VectorBytes(offsets_) + VectorBytes(probs_) +
+                 VectorBytes(aliases_),
+             probs_.size());
+}
+
+}  // namespace embedx
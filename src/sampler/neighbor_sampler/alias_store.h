@@ -0,0 +1,77 @@
+// Tencent is pleased to support the open source community by making embedx
+// available.
+//
+// Copyright (C) 2021 THL A29 Limited, a Tencent company.  All rights reserved.
+//
+// Licensed under the BSD 3-Clause License and other third-party components,
+// please refer to LICENSE for details.
+//
+
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "src/common/data_types.h"
+#include "src/common/memory_usage.h"
+#include "src/common/random.h"
+#include "src/io/snapshot.h"
+#include "src/sampler/sampler_source.h"
+
+namespace embedx {
+
+// Alias tables of the contexts of all nodes.
+//
+// The tables are packed like a csr adjacency, the table of row r (see
+// SamplerSource::LookupRow) is [offsets[r], offsets[r + 1]) of probs and
+// aliases, entry i being neighbor i of the context at row r.
+class AliasStore {
+ private:
+  std::vector<uint64_t> offsets_;
+  vec_float_t probs_;
+  // index of the alias neighbor in the context
+  std::vector<int> aliases_;
+
+ public:
+  // Builds the tables of all rows of 'sampler_source', each thread fills a
+  // range of rows.
+  bool Build(const SamplerSource& sampler_source, int thread_num);
+  bool Dump(const SamplerSource& sampler_source, SnapshotWriter* writer) const;
+  bool Load(const SamplerSource& sampler_source, SnapshotReader* reader);
+  void CollectMemory(MemoryUsage* usage) const;
+
+ public:
+  size_t row_size() const noexcept {
+    return offsets_.empty() ? 0 : offsets_.size() - 1;
+  }
+
+  // Returns the index of a neighbor in the context at 'row', which must not
+  // be empty.
+  int Next(int row) const noexcept {
+    uint64_t begin = offsets_[row];
+    auto size = uint32_t(offsets_[row + 1] - begin);
+    uint64_t k = begin + ThreadLocalRandomRange(size);
+    if (ThreadLocalRandom() < probs_[k]) {
+      return int(k - begin);
+    }
+    return aliases_[k];
+  }
+
+  // Like Next, fills 'indices' with 'count' samples.
+  void NextN(int row, int count, vec_int_t* indices) const {
+    uint64_t begin = offsets_[row];
+    auto size = uint32_t(offsets_[row + 1] - begin);
+    const float_t* probs = probs_.data() + begin;
+    const int* aliases = aliases_.data() + begin;
+    auto& engine = ThreadLocalRandomEngine();
+    indices->resize(count);
+    for (auto& index : *indices) {
+      uint32_t k = engine.NextRange(size);
+      index = engine.NextFloat() < probs[k] ? k : (uint32_t)aliases[k];
+    }
+  }
+
+ private:
+  bool BuildRows(const SamplerSource& sampler_source, int begin, int end);
+};
+
+}  // namespace embedx
@@ -0,0 +1,104 @@
+// Tencent is pleased to support the open source community by making embedx
+// available.
+//
+// Copyright (C) 2021 THL A29 Limited, a Tencent company.  All rights reserved.
+//
+// Licensed under the BSD 3-Clause License and other third-party components,
+// please refer to LICENSE for details.
+//
+
+#include "src/sampler/neighbor_sampler/alias_store.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>  // std::remove
+#include <fstream>
+#include <iterator>  // std::istreambuf_iterator
+#include <memory>    // std::unique_ptr
+#include <string>
+#include <vector>
+
+#include "src/common/data_types.h"
+#include "src/io/snapshot.h"
+#include "src/sampler/sampler_source.h"
+
+namespace embedx {
+
+class AliasStoreTest : public ::testing::Test {
+ protected:
+  std::unique_ptr<SamplerSource> sampler_source_;
+
+ protected:
+  const std::string CONTEXT = "testdata/context";
+  const std::string SNAPSHOT_FILE = "alias_store_test.snapshot";
+  const std::string OTHER_SNAPSHOT_FILE = "alias_store_test.other.snapshot";
+  const int THREAD_NUM = 3;
+
+ protected:
+  void SetUp() override {
+    sampler_source_ = NewMockSamplerSource(CONTEXT, "", THREAD_NUM);
+    ASSERT_TRUE(sampler_source_ != nullptr);
+  }
+
+  void TearDown() override {
+    std::remove(SNAPSHOT_FILE.c_str());
+    std::remove(OTHER_SNAPSHOT_FILE.c_str());
+  }
+
+  bool Dump(const AliasStore& store, const std::string& file) const {
+    SnapshotWriter writer;
+    return writer.Open(file) && store.Dump(*sampler_source_, &writer) &&
+           writer.Close();
+  }
+
+  static std::string ReadFile(const std::string& file) {
+    std::ifstream is(file, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(is),
+                       std::istreambuf_iterator<char>());
+  }
+};
+
+TEST_F(AliasStoreTest, Next) {
+  AliasStore store;
+  ASSERT_TRUE(store.Build(*sampler_source_, THREAD_NUM));
+  EXPECT_EQ(store.row_size(), sampler_source_->node_keys().size());
+
+  // 12:1.1 11:1.2 10:1.3
+  int row = 0;
+  ASSERT_TRUE(sampler_source_->LookupRow(0u, &row));
+  auto context = sampler_source_->FindContextAt(row);
+  ASSERT_EQ(context.size(), 3u);
+
+  const int COUNT = 36000;
+  std::vector<int> counts(context.size(), 0);
+  for (int i = 0; i < COUNT; ++i) {
+    int k = store.Next(row);
+    ASSERT_TRUE(k >= 0 && k < (int)context.size());
+    ++counts[k];
+  }
+  for (size_t i = 0; i < context.size(); ++i) {
+    EXPECT_NEAR(counts[i] / (double)COUNT, context[i].second / 3.6, 0.02);
+  }
+}
+
+TEST_F(AliasStoreTest, DumpLoad) {
+  AliasStore store;
+  ASSERT_TRUE(store.Build(*sampler_source_, THREAD_NUM));
+  ASSERT_TRUE(Dump(store, SNAPSHOT_FILE));
+
+  // the tables don't depend on the number of threads
+  AliasStore single_store;
+  ASSERT_TRUE(single_store.Build(*sampler_source_, 1));
+  ASSERT_TRUE(Dump(single_store, OTHER_SNAPSHOT_FILE));
+  EXPECT_EQ(ReadFile(SNAPSHOT_FILE), ReadFile(OTHER_SNAPSHOT_FILE));
+
+  AliasStore loaded_store;
+  SnapshotReader reader;
+  ASSERT_TRUE(reader.Open(SNAPSHOT_FILE));
+  ASSERT_TRUE(loaded_store.Load(*sampler_source_, &reader));
+  EXPECT_TRUE(reader.AtEnd());
+  ASSERT_TRUE(Dump(loaded_store, OTHER_SNAPSHOT_FILE));
+  EXPECT_EQ(ReadFile(SNAPSHOT_FILE), ReadFile(OTHER_SNAPSHOT_FILE));
+}
+
+}  // namespace embedx
@@ -14,19 +14,29 @@
 
 #include <deepx_core/dx_log.h>
 
-#include <algorithm>  // std::find_if
-#include <utility>    // std::move
+#include <utility>  // std::move
+
+#include "src/common/flat_hash_map.h"
+#include "src/common/random.h"
 
 namespace embedx {
 
 bool NeighborSampler::Sample(
     int count, const vec_int_t& nodes,
     std::vector<vec_int_t>* neighbor_nodes_list) const {
+  return Sample(count, nodes, 0, neighbor_nodes_list);
+}
+
+bool NeighborSampler::Sample(
+    int count, const vec_int_t& nodes, uint64_t seed,
+    std::vector<vec_int_t>* neighbor_nodes_list) const {
   neighbor_nodes_list->clear();
   neighbor_nodes_list->resize(nodes.size());
 
+  RandomStreamSeeder seeder(seed);
   int empty_node_num = 0;
   for (size_t i = 0; i < nodes.size(); ++i) {
+    RandomSeedScope scope(seeder.Next(nodes[i]));
     DoSampling(nodes[i], count, &(*neighbor_nodes_list)[i]);
     if ((*neighbor_nodes_list)[i].empty()) {
       empty_node_num += 1;
@@ -39,9 +49,13 @@ bool NeighborSampler::Sample(
 
 void NeighborSampler::DoSampling(int_t node, int count,
                                  vec_int_t* neighbor_nodes) const {
-  const auto* context = sampler_builder_.sampler_source().FindContext(node);
-  DXCHECK(context != nullptr);
-  int neighbor_size = (int)context->size();
+  auto context = sampler_builder_.sampler_source().FindContext(node);
+  // e.g. all edges were removed by a graph delta
+  if (context.empty()) {
+    neighbor_nodes->clear();
+    return;
+  }
+  int neighbor_size = (int)context.size();
 
   if (count < 0 || count == neighbor_size) {
     FullSampling(node, neighbor_nodes);
@@ -56,12 +70,12 @@ void NeighborSampler::FullSampling(int_t node,
                                    vec_int_t* neighbor_nodes) const {
   neighbor_nodes->clear();
 
-  const auto* context = sampler_builder_.sampler_source().FindContext(node);
-  if (context == nullptr) {
+  auto context = sampler_builder_.sampler_source().FindContext(node);
+  if (context.empty()) {
     return;
   }
 
-  for (const auto& pair : *context) {
+  for (const auto& pair : context) {
     neighbor_nodes->emplace_back(pair.first);
   }
 }
@@ -70,29 +84,24 @@ void NeighborSampler::NoReplacementSampling(int_t node, int count,
                                             vec_int_t* neighbor_nodes) const {
   neighbor_nodes->clear();
 
-  int_t next_node;
+  // Draws the missing nodes in batches, duplicates are dropped.
+  FlatHashMap<int_t, bool> drawn_nodes;
+  drawn_nodes.reserve(count);
+  vec_int_t next_nodes;
   while (neighbor_nodes->size() < (size_t)count) {
-    DXCHECK(sampler_builder_.Next(node, &next_node));
-    // o(n) !!!
-    auto it = std::find_if(neighbor_nodes->begin(), neighbor_nodes->end(),
-                           [next_node](int_t neighbor_node) {
-                             return neighbor_node == next_node;
-                           });
-    if (it == neighbor_nodes->end()) {
-      neighbor_nodes->emplace_back(next_node);
+    DXCHECK(sampler_builder_.NextN(
+        node, count - (int)neighbor_nodes->size(), &next_nodes));
+    for (auto next_node : next_nodes) {
+      if (drawn_nodes.emplace(next_node).second) {
+        neighbor_nodes->emplace_back(next_node);
+      }
     }
   }
 }
 
 void NeighborSampler::WithReplacementSampling(int_t node, int count,
                                               vec_int_t* neighbor_nodes) const {
-  neighbor_nodes->clear();
-
-  int_t next_node;
-  for (int i = 0; i < count; ++i) {
-    DXCHECK(sampler_builder_.Next(node, &next_node));
-    neighbor_nodes->emplace_back(next_node);
-  }
+  DXCHECK(sampler_builder_.NextN(node, count, neighbor_nodes));
 }
 
 std::unique_ptr<NeighborSampler> NewNeighborSampler(
@@ -15,6 +15,7 @@
 #include <deepx_core/dx_log.h>
 
 #include <cinttypes>  // PRIu64
+#include <utility>    // std::move
 
 #include "src/common/random.h"
 #include "src/io/io_util.h"
@@ -22,16 +23,14 @@
 namespace embedx {
 namespace {
 
-bool NormNeighborProb(const SamplerSource& sampler_source, int_t node,
-                      vec_float_t* probs) {
-  const auto* context = sampler_source.FindContext(node);
-  if (context == nullptr) {
+bool NormNeighborProb(pair_view_t context, int_t node, vec_float_t* probs) {
+  if (context.empty()) {
     DXERROR("Couldn't find node: %" PRIu64 " context.", node);
     return false;
   }
 
   float_t sum = 0;
-  for (const auto& entry : *context) {
+  for (const auto& entry : context) {
     if (entry.second <= 0) {
       DXERROR("Weight %f of node: %" PRIu64 " and neighbor: %" PRIu64
               " must be greater than 0.",
@@ -42,7 +41,7 @@ bool NormNeighborProb(const SamplerSource& sampler_source, int_t node,
   }
 
   probs->clear();
-  for (const auto& entry : *context) {
+  for (const auto& entry : context) {
     probs->emplace_back(entry.second / sum);
   }
 
@@ -52,12 +51,14 @@ bool NormNeighborProb(const SamplerSource& sampler_source, int_t node,
 }  // namespace
 
 std::unique_ptr<SamplerBuilder> NeighborSamplerBuilder::Create(
-    const SamplerSource* sampler_source, int sampler_type, int thread_num) {
+    const SamplerSource* sampler_source, int sampler_type, int thread_num,
+    SnapshotReader* reader) {
   std::unique_ptr<SamplerBuilder> sampler_builder;
   sampler_builder.reset(
       new NeighborSamplerBuilder(sampler_source, sampler_type, thread_num));
 
-  if (!sampler_builder->Init()) {
+  bool ok = reader ? sampler_builder->Load(reader) : sampler_builder->Init();
+  if (!ok) {
     DXERROR("Failed to init neighbor sampler builder.");
     sampler_builder.reset();
   }
@@ -65,27 +66,68 @@ std::unique_ptr<SamplerBuilder> NeighborSamplerBuilder::Create(
   return sampler_builder;
 }
 
+void NeighborSamplerBuilder::CollectMemory(MemoryUsage* usage) const {
+  alias_store_.CollectMemory(usage);
+  uint64_t sampling_num = 0;
+  for (const auto& sampling : samplings_) {
+    if (sampling) {
+      sampling->CollectMemory(usage);
+      ++sampling_num;
+    }
+  }
+  usage->Add("samplers", VectorBytes(samplings_), sampling_num);
+
+  // Tables of updated nodes keep a copy of the context they were built from.
+  const auto* delta_samplings = delta_samplings_.get();
+  if (delta_samplings) {
+    uint64_t bytes = MapBytes(*delta_samplings);
+    delta_samplings->ForEach(
+        [&bytes, usage](int_t /*node*/,
+                        const std::shared_ptr<const DeltaSampling>& entry) {
+          bytes += sizeof(DeltaSampling) + VectorBytes(entry->context);
+          if (entry->sampling) {
+            entry->sampling->CollectMemory(usage);
+          }
+        });
+    usage->Add("delta_samplers", bytes, delta_samplings->size());
+  }
+}
+
 bool NeighborSamplerBuilder::InitUniformFuncs() {
   DXINFO("Initing uniform neighbor sampler funcs...");
 
   next_func_ = [this](int_t cur_node, int_t* next_node) -> bool {
-    const auto* context = sampler_source_.FindContext(cur_node);
-    if (context == nullptr) {
+    auto context = sampler_source_.FindContext(cur_node);
+    if (context.empty()) {
       return false;
     }
-    int k = int(ThreadLocalRandom() * context->size());
-    *next_node = (*context)[k].first;
+    int k = (int)ThreadLocalRandomRange(context.size());
+    *next_node = context[k].first;
     return true;
   };
 
   range_next_func_ = [this](int_t cur_node, int begin, int end,
                             int_t* next_node) -> bool {
-    const auto* context = sampler_source_.FindContext(cur_node);
-    if (context == nullptr) {
+    auto context = sampler_source_.FindContext(cur_node);
+    if (context.empty()) {
+      return false;
+    }
+    int k = begin + (int)ThreadLocalRandomRange(end - begin);
+    *next_node = context[k].first;
+    return true;
+  };
+
+  next_n_func_ = [this](int_t cur_node, int count,
+                        vec_int_t* next_nodes) -> bool {
+    auto context = sampler_source_.FindContext(cur_node);
+    if (context.empty()) {
       return false;
     }
-    int k = begin + int(ThreadLocalRandom() * (end - begin));
-    *next_node = (*context)[k].first;
+    auto& engine = ThreadLocalRandomEngine();
+    next_nodes->resize(count);
+    for (auto& next_node : *next_nodes) {
+      next_node = context[engine.NextRange(context.size())].first;
+    }
     return true;
   };
 
@@ -95,8 +137,18 @@ bool NeighborSamplerBuilder::InitUniformFuncs() {
 
 bool NeighborSamplerBuilder::InitFrequencySampler() {
   DXINFO("Building transition probability...");
+  if (use_alias_store()) {
+    if (!alias_store_.Build(sampler_source_, thread_num_)) {
+      DXERROR("Failed to build Transition Probs.");
+      return false;
+    }
+    DXINFO("Done.");
+    return true;
+  }
+
   auto& nodes = sampler_source_.node_keys();
-  sampling_map_.clear();
+  samplings_.clear();
+  samplings_.resize(nodes.size());
   if (!io_util::ParallelProcess<int_t>(
           nodes,
           [this](const vec_int_t& nodes, int thread_id) {
@@ -116,39 +168,54 @@ bool NeighborSamplerBuilder::InitFrequencyFuncs() {
          sampling_type_);
 
   next_func_ = [this](int_t cur_node, int_t* next_node) -> bool {
-    const auto* context = sampler_source_.FindContext(cur_node);
-    if (context == nullptr) {
-      DXERROR("Couldn't find node: %" PRIu64 " context.", cur_node);
-      return false;
-    }
-
-    auto it = sampling_map_.find(cur_node);
-    if (it == sampling_map_.end()) {
-      DXERROR("Couldn't find node: %" PRIu64 " sampler.", cur_node);
+    pair_view_t context;
+    const Sampling* sampling = nullptr;
+    int row = 0;
+    if (!FindSampling(cur_node, &context, &sampling, &row)) {
       return false;
     }
 
-    int k = int(it->second->Next());
-    *next_node = (*context)[k].first;
+    int k = sampling ? int(sampling->Next()) : alias_store_.Next(row);
+    *next_node = context[k].first;
     return true;
   };
 
   range_next_func_ = [this](int_t cur_node, int begin, int end,
                             int_t* next_node) -> bool {
-    const auto* context = sampler_source_.FindContext(cur_node);
-    if (context == nullptr) {
-      DXERROR("Couldn't find node: %" PRIu64 " context.", cur_node);
+    pair_view_t context;
+    const Sampling* sampling = nullptr;
+    int row = 0;
+    if (!FindSampling(cur_node, &context, &sampling, &row)) {
+      return false;
+    }
+    if (sampling == nullptr) {
+      DXERROR("Next with range was not implemented in AliasStore.");
       return false;
     }
 
-    auto it = sampling_map_.find(cur_node);
-    if (it == sampling_map_.end()) {
-      DXERROR("Couldn't find node: %" PRIu64 " sampler.", cur_node);
+    int k = int(sampling->Next(begin, end));
+    *next_node = context[k].first;
+    return true;
+  };
+
+  next_n_func_ = [this](int_t cur_node, int count,
+                        vec_int_t* next_nodes) -> bool {
+    pair_view_t context;
+    const Sampling* sampling = nullptr;
+    int row = 0;
+    if (!FindSampling(cur_node, &context, &sampling, &row)) {
       return false;
     }
 
-    int k = int(it->second->Next(begin, end));
-    *next_node = (*context)[k].first;
+    // indices first, then the neighbors at them
+    if (sampling) {
+      sampling->NextN(count, next_nodes);
+    } else {
+      alias_store_.NextN(row, count, next_nodes);
+    }
+    for (auto& next_node : *next_nodes) {
+      next_node = context[next_node].first;
+    }
     return true;
   };
 
@@ -156,22 +223,179 @@ bool NeighborSamplerBuilder::InitFrequencyFuncs() {
   return true;
 }
 
+bool NeighborSamplerBuilder::FindSampling(int_t node, pair_view_t* context,
+                                          const Sampling** sampling,
+                                          int* row) const {
+  const auto* delta_samplings = delta_samplings_.get();
+  const auto* delta_sampling =
+      delta_samplings ? delta_samplings->Find(node) : nullptr;
+  if (delta_sampling) {
+    *context = (*delta_sampling)->context;
+    *sampling = (*delta_sampling)->sampling.get();
+    if (*sampling == nullptr) {
+      DXERROR("Couldn't find node: %" PRIu64 " context.", node);
+      return false;
+    }
+    return true;
+  }
+
+  if (!sampler_source_.LookupRow(node, row)) {
+    DXERROR("Couldn't find node: %" PRIu64 " context.", node);
+    return false;
+  }
+  *context = sampler_source_.FindContextAt(*row);
+  if (context->empty()) {
+    DXERROR("Couldn't find node: %" PRIu64 " context.", node);
+    return false;
+  }
+
+  if (use_alias_store()) {
+    *sampling = nullptr;
+    return true;
+  }
+  *sampling = samplings_[*row].get();
+  if (*sampling == nullptr) {
+    DXERROR("Couldn't find node: %" PRIu64 " sampler.", node);
+    return false;
+  }
+  return true;
+}
+
 bool NeighborSamplerBuilder::InitEntry(const vec_int_t& nodes, int thread_id) {
   DXINFO("Thread: %d is processing...", thread_id);
 
   vec_float_t norm_probs;
   // more namespace
   for (const auto& node : nodes) {
-    if (!NormNeighborProb(sampler_source_, node, &norm_probs)) {
+    if (!NormNeighborProb(sampler_source_.FindContext(node), node,
+                          &norm_probs)) {
+      return false;
+    }
+
+    int row = 0;
+    if (!sampler_source_.LookupRow(node, &row)) {
+      DXERROR("Couldn't find node: %" PRIu64 " context.", node);
+      return false;
+    }
+
+    // Rows are distinct, no lock is needed.
+    samplings_[row] = NewSampling(&norm_probs, (SamplingEnum)sampling_type_);
+    if (!samplings_[row]) {
+      return false;
+    }
+  }
+
+  DXINFO("Done.");
+  return true;
+}
+
+bool NeighborSamplerBuilder::PrepareUpdate(
+    const vec_int_t& nodes, const std::vector<pair_view_t>& contexts) {
+  next_delta_samplings_.reset();
+  // Uniform sampling reads the contexts directly.
+  if (sampling_type_ == (int)SamplingEnum::UNIFORM) {
+    return true;
+  }
+
+  DXINFO("Updating transition probability of %zu nodes...", nodes.size());
+  // The old table of a node keeps being used with the old context until the
+  // new ones are published together.
+  auto delta_samplings = delta_samplings_.load();
+  std::shared_ptr<delta_sampling_map_t> next_delta_samplings(
+      delta_samplings ? new delta_sampling_map_t(*delta_samplings)
+                      : new delta_sampling_map_t);
+
+  vec_float_t norm_probs;
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    int_t node = nodes[i];
+    auto delta_sampling = std::make_shared<DeltaSampling>();
+    auto context = contexts[i];
+    delta_sampling->context.assign(context.begin(), context.end());
+    // A node without neighbors has no sampler.
+    if (!context.empty()) {
+      if (!NormNeighborProb(delta_sampling->context, node, &norm_probs)) {
+        return false;
+      }
+      delta_sampling->sampling =
+          NewSampling(&norm_probs, (SamplingEnum)sampling_type_);
+      if (!delta_sampling->sampling) {
+        return false;
+      }
+    }
+    (*next_delta_samplings)[node] = std::move(delta_sampling);
+  }
+  next_delta_samplings->Compact(nodes.size());
+  next_delta_samplings_ = std::move(next_delta_samplings);
+
+  DXINFO("Done.");
+  return true;
+}
+
+void NeighborSamplerBuilder::PublishUpdate() {
+  if (next_delta_samplings_) {
+    delta_samplings_.Publish(std::move(next_delta_samplings_));
+  }
+}
+
+bool NeighborSamplerBuilder::DumpFrequencySampler(
+    SnapshotWriter* writer) const {
+  if (use_alias_store()) {
+    return alias_store_.Dump(sampler_source_, writer);
+  }
+
+  // Nodes are written with their samplings, rows may differ after loading.
+  const auto& keys = sampler_source_.node_keys();
+  vec_int_t nodes;
+  std::vector<const Sampling*> samplings;
+  for (auto node : keys) {
+    int row = 0;
+    if (sampler_source_.LookupRow(node, &row) && samplings_[row]) {
+      nodes.emplace_back(node);
+      samplings.emplace_back(samplings_[row].get());
+    }
+  }
+
+  if (!writer->WriteArray(nodes)) {
+    return false;
+  }
+  for (const auto* sampling : samplings) {
+    if (!sampling->Dump(writer)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool NeighborSamplerBuilder::LoadFrequencySampler(SnapshotReader* reader) {
+  DXINFO("Loading transition probability...");
+  if (use_alias_store()) {
+    if (!alias_store_.Load(sampler_source_, reader)) {
+      DXERROR("Failed to load alias store.");
+      return false;
+    }
+    DXINFO("Done.");
+    return true;
+  }
+
+  ArrayView<int_t> nodes;
+  if (!reader->ReadArray(&nodes)) {
+    return false;
+  }
+
+  samplings_.clear();
+  samplings_.resize(sampler_source_.node_keys().size());
+  for (auto node : nodes) {
+    int row = 0;
+    if (!sampler_source_.LookupRow(node, &row)) {
+      DXERROR("Couldn't find node: %" PRIu64 " context.", node);
       return false;
     }
 
-    auto sampling = NewSampling(&norm_probs, (SamplingEnum)sampling_type_);
-    if (!sampling) {
+    samplings_[row] = NewSampling(reader, (SamplingEnum)sampling_type_);
+    if (!samplings_[row]) {
+      DXERROR("Failed to load node: %" PRIu64 " sampler.", node);
       return false;
     }
-    std::lock_guard<std::mutex> guard(mtx_);
-    sampling_map_.emplace(node, std::move(sampling));
   }
 
   DXINFO("Done.");
@@ -179,9 +403,10 @@ bool NeighborSamplerBuilder::InitEntry(const vec_int_t& nodes, int thread_id) {
 }
 
 std::unique_ptr<SamplerBuilder> NewNeighborSamplerBuilder(
-    const SamplerSource* sampler_source, int sampler_type, int thread_num) {
+    const SamplerSource* sampler_source, int sampler_type, int thread_num,
+    SnapshotReader* reader) {
   return NeighborSamplerBuilder::Create(sampler_source, sampler_type,
-                                        thread_num);
+                                        thread_num, reader);
 }
 
 }  // namespace embedx
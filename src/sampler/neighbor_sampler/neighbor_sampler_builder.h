@@ -11,11 +11,13 @@
 //
 
 #pragma once
-#include <memory>  // std::unique_ptr
-#include <mutex>
-#include <unordered_map>
+#include <memory>  // std::shared_ptr, std::unique_ptr
+#include <vector>
 
 #include "src/common/data_types.h"
+#include "src/common/layered_map.h"
+#include "src/common/published_ptr.h"
+#include "src/sampler/neighbor_sampler/alias_store.h"
 #include "src/sampler/sampler_builder.h"
 #include "src/sampler/sampler_source.h"
 #include "src/sampler/sampling.h"
@@ -24,22 +26,56 @@ namespace embedx {
 
 class NeighborSamplerBuilder : public SamplerBuilder {
  private:
-  std::mutex mtx_;
-  std::unordered_map<int_t, std::unique_ptr<Sampling>> sampling_map_;
+  // sampler of a node changed by Update, with the context it was built from
+  struct DeltaSampling {
+    vec_pair_t context;
+    std::unique_ptr<Sampling> sampling;  // nullptr if context is empty
+  };
+  using delta_sampling_map_t =
+      LayeredMap<int_t, std::shared_ptr<const DeltaSampling>>;
+
+ private:
+  // indexed by the dense id of the node, see SamplerSource::LookupRow
+  std::vector<std::unique_ptr<Sampling>> samplings_;
+  // replaces samplings_ for alias sampling
+  AliasStore alias_store_;
+  // copied on write, looked up before samplings_
+  PublishedPtr<delta_sampling_map_t> delta_samplings_;
+  // built by PrepareUpdate, published by PublishUpdate
+  std::shared_ptr<const delta_sampling_map_t> next_delta_samplings_;
 
  public:
   ~NeighborSamplerBuilder() override = default;
 
  public:
   static std::unique_ptr<SamplerBuilder> Create(
-      const SamplerSource* sampler_source, int sampler_type, int thread_num);
+      const SamplerSource* sampler_source, int sampler_type, int thread_num,
+      SnapshotReader* reader = nullptr);
+
+ public:
+  bool PrepareUpdate(const vec_int_t& nodes,
+                     const std::vector<pair_view_t>& contexts) override;
+  void PublishUpdate() override;
+  void PinUpdate(PublishedPins* pins) const override {
+    pins->Add(delta_samplings_);
+  }
+  void CollectMemory(MemoryUsage* usage) const override;
 
  private:
   bool InitUniformFuncs() override;
   bool InitFrequencySampler() override;
   bool InitFrequencyFuncs() override;
+  bool DumpFrequencySampler(SnapshotWriter* writer) const override;
+  bool LoadFrequencySampler(SnapshotReader* reader) override;
 
   bool InitEntry(const vec_int_t& nodes, int thread_id);
+  // Finds the sampler of 'node', which is either '*sampling' or the row
+  // 'row' of alias_store_ if '*sampling' is nullptr.
+  bool FindSampling(int_t node, pair_view_t* context, const Sampling** sampling,
+                    int* row) const;
+  bool use_alias_store() const noexcept {
+    return sampling_type_ == (int)SamplingEnum::ALIAS;
+  }
 
  private:
   NeighborSamplerBuilder(const SamplerSource* sampler_source, int sampler_type,
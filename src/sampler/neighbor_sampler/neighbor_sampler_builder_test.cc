@@ -17,6 +17,10 @@
 #include <unordered_set>
 
 #include "src/common/data_types.h"
+#include "src/graph/graph_config.h"
+#include "src/graph/graph_delta.h"
+#include "src/graph/in_memory_graph.h"
+#include "src/io/storage/adjacency.h"
 #include "src/sampler/sampler_builder.h"
 #include "src/sampler/sampler_source.h"
 #include "src/sampler/sampling.h"
@@ -30,6 +34,7 @@ class NeighborSamplerBuilderTest : public ::testing::Test {
 
  protected:
   const std::string CONTEXT = "testdata/context";
+  const std::string DELTA = "testdata/delta";
   const int THREAD_NUM = 3;
 
  protected:
@@ -55,12 +60,31 @@ TEST_F(NeighborSamplerBuilderTest, Next) {
   int_t next;
   EXPECT_TRUE(sampler_builder_->Next(9u, &next));
   std::unordered_set<int_t> expected = {6u, 7u, 8u};
-  auto* context = sampler_source_->FindContext(9u);
-  EXPECT_TRUE(context != nullptr);
+  auto context = sampler_source_->FindContext(9u);
+  EXPECT_FALSE(context.empty());
   auto it =
-      std::find_if(context->begin(), context->end(),
+      std::find_if(context.begin(), context.end(),
                    [next](const pair_t& entry) { return entry.first == next; });
-  EXPECT_TRUE(it != context->end());
+  EXPECT_TRUE(it != context.end());
+}
+
+TEST_F(NeighborSamplerBuilderTest, NextN) {
+  std::unordered_set<int_t> expected = {6u, 7u, 8u};
+  vec_int_t next_nodes;
+  for (auto type : {SamplingEnum::UNIFORM, SamplingEnum::ALIAS,
+                    SamplingEnum::PARTIAL_SUM}) {
+    sampler_builder_ = NewSamplerBuilder(sampler_source_.get(),
+                                         SamplerBuilderEnum::NEIGHBOR_SAMPLER,
+                                         (int)type, THREAD_NUM);
+    ASSERT_TRUE(sampler_builder_ != nullptr);
+
+    EXPECT_TRUE(sampler_builder_->NextN(9u, 100, &next_nodes));
+    EXPECT_EQ(next_nodes.size(), 100u);
+    for (auto next_node : next_nodes) {
+      EXPECT_TRUE(expected.count(next_node) > 0);
+    }
+    EXPECT_FALSE(sampler_builder_->NextN(100u, 100, &next_nodes));
+  }
 }
 
 TEST_F(NeighborSamplerBuilderTest, RangeNext) {
@@ -73,4 +97,76 @@ TEST_F(NeighborSamplerBuilderTest, RangeNext) {
   EXPECT_TRUE(sampler_builder_->Next(0u, 2, 3, &next));
   EXPECT_EQ(next, 12u);
 }
+
+TEST_F(NeighborSamplerBuilderTest, Update) {
+  GraphConfig config;
+  config.set_node_graph(CONTEXT);
+  config.set_thread_num(THREAD_NUM);
+  auto graph = InMemoryGraph::Create(config);
+  ASSERT_TRUE(graph != nullptr);
+  sampler_source_ = NewGraphSamplerSource(graph.get());
+  ASSERT_TRUE(sampler_source_ != nullptr);
+  sampler_builder_ = NewSamplerBuilder(sampler_source_.get(),
+                                       SamplerBuilderEnum::NEIGHBOR_SAMPLER,
+                                       (int)SamplingEnum::ALIAS, THREAD_NUM);
+  ASSERT_TRUE(sampler_builder_ != nullptr);
+
+  auto delta = GraphDelta::Create(DELTA, config, graph->partitioner());
+  ASSERT_TRUE(delta != nullptr);
+  vec_int_t nodes;
+  EXPECT_TRUE(graph->ApplyDelta(*delta, &nodes));
+  EXPECT_TRUE(sampler_builder_->Update(nodes));
+
+  int_t next;
+  std::unordered_set<int_t> expected = {10u, 11u, 13u};
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_TRUE(sampler_builder_->Next(0u, &next));
+    EXPECT_TRUE(expected.count(next) > 0);
+  }
+  EXPECT_TRUE(sampler_builder_->Next(100u, &next));
+  EXPECT_TRUE(next == 0u || next == 3u);
+  EXPECT_FALSE(sampler_builder_->Next(3u, &next));
+
+  // unchanged
+  expected = {6u, 7u, 8u};
+  EXPECT_TRUE(sampler_builder_->Next(9u, &next));
+  EXPECT_TRUE(expected.count(next) > 0);
+
+  // A failed update publishes nothing.
+  vec_pair_t zero_weight = {{12u, 0.0f}};
+  EXPECT_FALSE(sampler_builder_->PrepareUpdate({0u}, {zero_weight}));
+  sampler_builder_->PublishUpdate();
+  expected = {10u, 11u, 13u};
+  EXPECT_TRUE(sampler_builder_->Next(0u, &next));
+  EXPECT_TRUE(expected.count(next) > 0);
+}
+
+TEST_F(NeighborSamplerBuilderTest, Update_AdjCompressed) {
+  GraphConfig config;
+  config.set_node_graph(CONTEXT);
+  config.set_thread_num(THREAD_NUM);
+  config.set_store_type((int)AdjacencyEnum::ADJ_COMPRESSED);
+  auto graph = InMemoryGraph::Create(config);
+  ASSERT_TRUE(graph != nullptr);
+  sampler_source_ = NewGraphSamplerSource(graph.get());
+  ASSERT_TRUE(sampler_source_ != nullptr);
+  sampler_builder_ = NewSamplerBuilder(sampler_source_.get(),
+                                       SamplerBuilderEnum::NEIGHBOR_SAMPLER,
+                                       (int)SamplingEnum::ALIAS, THREAD_NUM);
+  ASSERT_TRUE(sampler_builder_ != nullptr);
+
+  // Each node is rebuilt from its own context, not from the last one decoded.
+  EXPECT_TRUE(sampler_builder_->Update({9u, 6u}));
+  int_t next;
+  std::unordered_set<int_t> expected = {6u, 7u, 8u};
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_TRUE(sampler_builder_->Next(9u, &next));
+    EXPECT_TRUE(expected.count(next) > 0);
+  }
+  expected = {3u, 4u, 5u};
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_TRUE(sampler_builder_->Next(6u, &next));
+    EXPECT_TRUE(expected.count(next) > 0);
+  }
+}
 }  // namespace embedx
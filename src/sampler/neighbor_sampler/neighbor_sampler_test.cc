@@ -19,6 +19,9 @@
 #include <vector>
 
 #include "src/common/data_types.h"
+#include "src/graph/graph_config.h"
+#include "src/graph/graph_delta.h"
+#include "src/graph/in_memory_graph.h"
 #include "src/sampler/sampler_builder.h"
 #include "src/sampler/sampler_source.h"
 #include "src/sampler/sampling.h"
@@ -33,6 +36,7 @@ class NeighborSamplerTest : public ::testing::Test {
 
  protected:
   const std::string CONTEXT = "testdata/context";
+  const std::string DELTA = "testdata/delta";
   const int THREAD_NUM = 3;
 
  protected:
@@ -77,13 +81,13 @@ TEST_F(NeighborSamplerTest, Uniform_Sample) {
   EXPECT_EQ(neighbor_nodes_list.size(), nodes.size());
 
   for (size_t i = 0; i < nodes.size(); ++i) {
-    auto* context = sampler_source_->FindContext(nodes[i]);
+    auto context = sampler_source_->FindContext(nodes[i]);
     // in context
     for (auto node : neighbor_nodes_list[i]) {
       auto it = std::find_if(
-          context->begin(), context->end(),
+          context.begin(), context.end(),
           [node](const pair_t& entry) { return entry.first == node; });
-      EXPECT_TRUE(it != context->end());
+      EXPECT_TRUE(it != context.end());
     }
   }
 }
@@ -102,15 +106,75 @@ TEST_F(NeighborSamplerTest, Frequency_Sample) {
   EXPECT_EQ(neighbor_nodes_list.size(), nodes.size());
 
   for (size_t i = 0; i < nodes.size(); ++i) {
-    auto* context = sampler_source_->FindContext(nodes[i]);
+    auto context = sampler_source_->FindContext(nodes[i]);
     // in context
     for (auto node : neighbor_nodes_list[i]) {
       auto it = std::find_if(
-          context->begin(), context->end(),
+          context.begin(), context.end(),
           [node](const pair_t& entry) { return entry.first == node; });
-      EXPECT_TRUE(it != context->end());
+      EXPECT_TRUE(it != context.end());
     }
   }
 }
 
+TEST_F(NeighborSamplerTest, Seeded_Sample) {
+  int count = 10;
+  uint64_t seed = 7;
+  sampler_builder_ = NewSamplerBuilder(sampler_source_.get(),
+                                       SamplerBuilderEnum::NEIGHBOR_SAMPLER,
+                                       (int)SamplingEnum::ALIAS, THREAD_NUM);
+  neighbor_sampler_.reset(new NeighborSampler(sampler_builder_.get()));
+
+  std::vector<vec_int_t> neighbor_nodes_list;
+  EXPECT_TRUE(
+      neighbor_sampler_->Sample(count, {0, 9, 0}, seed, &neighbor_nodes_list));
+  EXPECT_NE(neighbor_nodes_list[0], neighbor_nodes_list[2]);
+
+  // nodes split as by shards
+  std::vector<vec_int_t> split_nodes_list;
+  EXPECT_TRUE(
+      neighbor_sampler_->Sample(count, {9}, seed, &split_nodes_list));
+  EXPECT_EQ(split_nodes_list[0], neighbor_nodes_list[1]);
+  EXPECT_TRUE(
+      neighbor_sampler_->Sample(count, {0, 0}, seed, &split_nodes_list));
+  EXPECT_EQ(split_nodes_list[0], neighbor_nodes_list[0]);
+  EXPECT_EQ(split_nodes_list[1], neighbor_nodes_list[2]);
+
+  EXPECT_TRUE(
+      neighbor_sampler_->Sample(count, {0}, seed + 1, &split_nodes_list));
+  EXPECT_NE(split_nodes_list[0], neighbor_nodes_list[0]);
+}
+
+TEST_F(NeighborSamplerTest, Delta_Sample) {
+  GraphConfig config;
+  config.set_node_graph(CONTEXT);
+  config.set_thread_num(THREAD_NUM);
+  auto graph = InMemoryGraph::Create(config);
+  ASSERT_TRUE(graph != nullptr);
+  sampler_source_ = NewGraphSamplerSource(graph.get());
+  ASSERT_TRUE(sampler_source_ != nullptr);
+  sampler_builder_ = NewSamplerBuilder(sampler_source_.get(),
+                                       SamplerBuilderEnum::NEIGHBOR_SAMPLER,
+                                       (int)SamplingEnum::ALIAS, THREAD_NUM);
+  ASSERT_TRUE(sampler_builder_ != nullptr);
+  neighbor_sampler_.reset(new NeighborSampler(sampler_builder_.get()));
+
+  // The delta removes all edges of node 3.
+  auto delta = GraphDelta::Create(DELTA, config, graph->partitioner());
+  ASSERT_TRUE(delta != nullptr);
+  vec_int_t nodes;
+  EXPECT_TRUE(graph->ApplyDelta(*delta, &nodes));
+  EXPECT_TRUE(sampler_builder_->Update(nodes));
+
+  std::vector<vec_int_t> neighbor_nodes_list;
+  for (int count : {-1, 1, 5}) {
+    EXPECT_TRUE(
+        neighbor_sampler_->Sample(count, {3, 0}, &neighbor_nodes_list));
+    ASSERT_EQ(neighbor_nodes_list.size(), 2u);
+    EXPECT_TRUE(neighbor_nodes_list[0].empty());
+    EXPECT_FALSE(neighbor_nodes_list[1].empty());
+  }
+  EXPECT_FALSE(neighbor_sampler_->Sample(2, {3}, &neighbor_nodes_list));
+}
+
 }  // namespace embedx
@@ -10,6 +10,7 @@
 //
 
 #pragma once
+#include <cstdint>
 #include <memory>  // std::unique_ptr
 #include <vector>
 
@@ -33,6 +34,13 @@ class RandomWalker {
   void Traverse(const vec_int_t& cur_nodes, const std::vector<int>& walk_lens,
                 const WalkerInfo& walker_info, std::vector<vec_int_t>* seqs,
                 PrevInfo* prev_info) const;
+  // Like Traverse, walker i steps with streams keyed by 'seeds'[i] and the
+  // remaining length of its walk, so that a walk split across calls (e.g. by
+  // shard) steps the same. Empty 'seeds' leave the walkers unseeded.
+  void Traverse(const vec_int_t& cur_nodes, const std::vector<int>& walk_lens,
+                const WalkerInfo& walker_info,
+                const std::vector<uint64_t>& seeds,
+                std::vector<vec_int_t>* seqs, PrevInfo* prev_info) const;
 };
 
 enum class RandomWalkerEnum : int { STATIC = 0 };
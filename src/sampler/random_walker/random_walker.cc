@@ -28,7 +28,16 @@ void RandomWalker::Traverse(const vec_int_t& cur_nodes,
                             const WalkerInfo& walker_info,
                             std::vector<vec_int_t>* seqs,
                             PrevInfo* prev_info) const {
-  impl_->Traverse(cur_nodes, walk_lens, walker_info, seqs, prev_info);
+  impl_->Traverse(cur_nodes, walk_lens, walker_info, {}, seqs, prev_info);
+}
+
+void RandomWalker::Traverse(const vec_int_t& cur_nodes,
+                            const std::vector<int>& walk_lens,
+                            const WalkerInfo& walker_info,
+                            const std::vector<uint64_t>& seeds,
+                            std::vector<vec_int_t>* seqs,
+                            PrevInfo* prev_info) const {
+  impl_->Traverse(cur_nodes, walk_lens, walker_info, seeds, seqs, prev_info);
 }
 
 std::unique_ptr<RandomWalker> NewRandomWalker(
@@ -10,6 +10,7 @@
 //
 
 #pragma once
+#include <cstdint>
 #include <memory>  // std::unique_ptr
 #include <vector>
 
@@ -28,6 +29,7 @@ class RandomWalkerImpl {
   virtual void Traverse(const vec_int_t& cur_nodes,
                         const std::vector<int>& walk_lens,
                         const WalkerInfo& walker_info,
+                        const std::vector<uint64_t>& seeds,
                         std::vector<vec_int_t>* seqs,
                         PrevInfo* prev_info) const = 0;
 };
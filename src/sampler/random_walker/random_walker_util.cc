@@ -19,7 +19,7 @@
 namespace embedx {
 namespace random_walker_util {
 
-bool FindBound(const vec_pair_t& context, uint16_t node_type,
+bool FindBound(pair_view_t context, uint16_t node_type,
                std::pair<int, int>* bound) {
   auto l = std::lower_bound(context.begin(), context.end(), node_type,
                             [](const pair_t& p, uint16_t node_type) {
@@ -38,7 +38,7 @@ bool FindBound(const vec_pair_t& context, uint16_t node_type,
   }
 }
 
-bool ContainsNode(const vec_pair_t& context, int_t node) {
+bool ContainsNode(pair_view_t context, int_t node) {
   uint16_t node_type = io_util::GetNodeType(node);
   std::pair<int, int> bound;
   if (!FindBound(context, node_type, &bound)) {
@@ -17,10 +17,10 @@
 namespace embedx {
 namespace random_walker_util {
 
-bool FindBound(const vec_pair_t& context, uint16_t node_type,
+bool FindBound(pair_view_t context, uint16_t node_type,
                std::pair<int, int>* bound);
 
-bool ContainsNode(const vec_pair_t& context, int_t node);
+bool ContainsNode(pair_view_t context, int_t node);
 
 }  // namespace random_walker_util
 }  // namespace embedx
@@ -14,8 +14,10 @@
 
 #include <deepx_core/dx_log.h>
 
-#include <utility>  // std::pair
+#include <algorithm>  // std::sort
+#include <utility>    // std::pair
 
+#include "src/common/random.h"
 #include "src/io/io_util.h"
 #include "src/sampler/random_walker/random_walker_util.h"
 #include "src/sampler/sampler_source.h"
@@ -32,9 +34,12 @@ std::unique_ptr<RandomWalkerImpl> StaticRandomWalkerImpl::Create(
 void StaticRandomWalkerImpl::Traverse(const vec_int_t& cur_nodes,
                                       const std::vector<int>& walk_lens,
                                       const WalkerInfo& walker_info,
+                                      const std::vector<uint64_t>& seeds,
                                       std::vector<vec_int_t>* seqs,
                                       PrevInfo* /*prev_info*/) const {
-  if (walker_info.meta_path.empty()) {
+  if (!seeds.empty()) {
+    SeededTraverse(cur_nodes, walk_lens, walker_info, seeds, seqs);
+  } else if (walker_info.meta_path.empty()) {
     Traverse(cur_nodes, walk_lens, seqs);
   } else {
     MetaPathTraverse(cur_nodes, walk_lens, walker_info, seqs);
@@ -46,16 +51,74 @@ void StaticRandomWalkerImpl::Traverse(const vec_int_t& cur_nodes,
                                       std::vector<vec_int_t>* seqs) const {
   seqs->clear();
   seqs->resize(cur_nodes.size());
+
+  // Walkers step together, walkers at the same node sample their next nodes
+  // in one call.
+  std::vector<std::pair<int_t, int>> walkers;  // (cur_node, walker)
+  for (size_t i = 0; i < cur_nodes.size(); ++i) {
+    if (walk_lens[i] > 0) {
+      walkers.emplace_back(cur_nodes[i], (int)i);
+    }
+  }
+
+  std::vector<std::pair<int_t, int>> next_walkers;
+  vec_int_t next_nodes;
+  while (!walkers.empty()) {
+    std::sort(walkers.begin(), walkers.end());
+    next_walkers.clear();
+    size_t begin = 0;
+    while (begin < walkers.size()) {
+      auto cur_node = walkers[begin].first;
+      size_t end = begin + 1;
+      while (end < walkers.size() && walkers[end].first == cur_node) {
+        ++end;
+      }
+
+      // A walker stops at a node without neighbors.
+      if (neighbor_sampler_builder_.NextN(cur_node, int(end - begin),
+                                          &next_nodes)) {
+        for (size_t j = begin; j < end; ++j) {
+          auto next_node = next_nodes[j - begin];
+          int walker = walkers[j].second;
+          auto& seq = (*seqs)[walker];
+          seq.emplace_back(next_node);
+          if ((int)seq.size() < walk_lens[walker]) {
+            next_walkers.emplace_back(next_node, walker);
+          }
+        }
+      }
+      begin = end;
+    }
+    walkers.swap(next_walkers);
+  }
+}
+
+void StaticRandomWalkerImpl::SeededTraverse(
+    const vec_int_t& cur_nodes, const std::vector<int>& walk_lens,
+    const WalkerInfo& walker_info, const std::vector<uint64_t>& seeds,
+    std::vector<vec_int_t>* seqs) const {
+  DXCHECK(seeds.size() == cur_nodes.size());
+  seqs->clear();
+  seqs->resize(cur_nodes.size());
+  const auto& meta_path = walker_info.meta_path;
   int_t next_node;
   for (size_t i = 0; i < cur_nodes.size(); ++i) {
     auto cur_node = cur_nodes[i];
+    auto cur_index = walker_info.walker_length - walk_lens[i];
+    auto& seq = (*seqs)[i];
+
+    // Walkers step one by one, each step has its own stream.
     for (int j = 0; j < walk_lens[i]; ++j) {
-      if (neighbor_sampler_builder_.Next(cur_node, &next_node)) {
-        (*seqs)[i].emplace_back(next_node);
-        cur_node = next_node;
-      } else {
+      RandomSeedScope scope(Philox4x32(seeds[i], 0, walk_lens[i] - j) | 1);
+      bool found =
+          meta_path.empty()
+              ? neighbor_sampler_builder_.Next(cur_node, &next_node)
+              : MetaPathNext(meta_path, cur_node, cur_index + j, &next_node);
+      if (!found) {
         break;
       }
+      seq.emplace_back(next_node);
+      cur_node = next_node;
     }
   }
 }
@@ -86,16 +149,16 @@ bool StaticRandomWalkerImpl::MetaPathNext(const meta_path_t& meta_path,
                                           int_t* next_node) const {
   DXASSERT(cur_index >= 0);
 
-  auto* context =
+  auto context =
       neighbor_sampler_builder_.sampler_source().FindContext(cur_node);
-  if (context == nullptr) {
+  if (context.empty()) {
     return false;
   }
 
   uint16_t expected_next_type = meta_path[(cur_index + 1) % meta_path.size()];
 
   std::pair<int, int> bound;
-  if (!random_walker_util::FindBound(*context, expected_next_type, &bound)) {
+  if (!random_walker_util::FindBound(context, expected_next_type, &bound)) {
     return false;
   }
 
@@ -11,6 +11,7 @@
 //
 
 #pragma once
+#include <cstdint>
 #include <memory>  // std::unique_ptr
 #include <vector>
 
@@ -34,12 +35,19 @@ class StaticRandomWalkerImpl : public RandomWalkerImpl {
 
  public:
   void Traverse(const vec_int_t& cur_nodes, const std::vector<int>& walk_lens,
-                const WalkerInfo& walker_info, std::vector<vec_int_t>* seqs,
+                const WalkerInfo& walker_info,
+                const std::vector<uint64_t>& seeds,
+                std::vector<vec_int_t>* seqs,
                 PrevInfo* prev_info) const override;
 
  private:
   void Traverse(const vec_int_t& cur_nodes, const std::vector<int>& walk_lens,
                 std::vector<vec_int_t>* seqs) const;
+  void SeededTraverse(const vec_int_t& cur_nodes,
+                      const std::vector<int>& walk_lens,
+                      const WalkerInfo& walker_info,
+                      const std::vector<uint64_t>& seeds,
+                      std::vector<vec_int_t>* seqs) const;
   void MetaPathTraverse(const vec_int_t& cur_nodes,
                         const std::vector<int>& walk_lens,
                         const WalkerInfo& walker_info,
@@ -62,13 +62,13 @@ TEST_F(StaticRandomWalkerImplTest, Traverse_UniformNeighborSampler) {
   vec_int_t pre_nodes = {0, 9};
   for (size_t i = 0; i < seqs.size(); ++i) {
     for (size_t j = 0; j < seqs[i].size(); ++j) {
-      auto* context = sampler_source_->FindContext(pre_nodes[i]);
+      auto context = sampler_source_->FindContext(pre_nodes[i]);
       auto seq_node = seqs[i][j];
       // in context
       auto it = std::find_if(
-          context->begin(), context->end(),
+          context.begin(), context.end(),
           [seq_node](const pair_t& entry) { return entry.first == seq_node; });
-      EXPECT_TRUE(it != context->end());
+      EXPECT_TRUE(it != context.end());
       pre_nodes[i] = seqs[i][j];
     }
   }
@@ -93,13 +93,13 @@ TEST_F(StaticRandomWalkerImplTest, Traverse_FrequencyNeighborSampler) {
   vec_int_t pre_nodes = {0, 9};
   for (size_t i = 0; i < seqs.size(); ++i) {
     for (size_t j = 0; j < seqs[i].size(); ++j) {
-      auto* context = sampler_source_->FindContext(pre_nodes[i]);
+      auto context = sampler_source_->FindContext(pre_nodes[i]);
       auto seq_node = seqs[i][j];
       // in context
       auto it = std::find_if(
-          context->begin(), context->end(),
+          context.begin(), context.end(),
           [seq_node](const pair_t& entry) { return entry.first == seq_node; });
-      EXPECT_TRUE(it != context->end());
+      EXPECT_TRUE(it != context.end());
       pre_nodes[i] = seqs[i][j];
     }
   }
@@ -138,4 +138,30 @@ TEST_F(StaticRandomWalkerImplTest, MetaPathTraverse) {
   }
 }
 
+TEST_F(StaticRandomWalkerImplTest, SeededTraverse) {
+  sampler_builder_ = NewSamplerBuilder(sampler_source_.get(),
+                                       SamplerBuilderEnum::NEIGHBOR_SAMPLER,
+                                       (int)SamplingEnum::UNIFORM, THREAD_NUM);
+  random_walker_ =
+      NewRandomWalker(sampler_builder_.get(), RandomWalkerEnum::STATIC);
+  EXPECT_TRUE(random_walker_);
+
+  vec_int_t cur_nodes = {0, 0};
+  std::vector<int> walk_lens = {6, 6};
+  std::vector<uint64_t> seeds = {7, 8};
+  WalkerInfo walker_info;
+  std::vector<vec_int_t> seqs;
+  random_walker_->Traverse(cur_nodes, walk_lens, walker_info, seeds, &seqs,
+                           nullptr);
+  ASSERT_EQ(seqs.size(), cur_nodes.size());
+  EXPECT_EQ(seqs[0].size(), 6u);
+  EXPECT_NE(seqs[0], seqs[1]);
+
+  // a walk continued by another call, e.g. on another shard, steps the same
+  std::vector<vec_int_t> tail_seqs;
+  random_walker_->Traverse({seqs[0][1]}, {4}, walker_info, {7}, &tail_seqs,
+                           nullptr);
+  EXPECT_EQ(tail_seqs[0], vec_int_t(seqs[0].begin() + 2, seqs[0].end()));
+}
+
 }  // namespace embedx
@@ -11,7 +11,10 @@
 
 #include "src/sampler/sampler_builder.h"
 
+#include <deepx_core/dx_log.h>
+
 #include <utility>  // std::move
+#include <vector>
 
 #include "src/sampler/sampling.h"
 
@@ -25,23 +28,74 @@ bool SamplerBuilder::Init() {
   }
 }
 
+bool SamplerBuilder::Load(SnapshotReader* reader) {
+  int sampling_type = 0;
+  if (!reader->ReadValue(&sampling_type)) {
+    return false;
+  }
+  if (sampling_type != sampling_type_) {
+    DXERROR("Need sampler type: %d, got sampler type: %d in snapshot.",
+            sampling_type_, sampling_type);
+    return false;
+  }
+
+  if (sampling_type_ == (int)SamplingEnum::UNIFORM) {
+    return InitUniformFuncs();
+  } else {
+    return LoadFrequencySampler(reader) && InitFrequencyFuncs();
+  }
+}
+
+bool SamplerBuilder::Dump(SnapshotWriter* writer) const {
+  if (!writer->WriteValue(sampling_type_)) {
+    return false;
+  }
+
+  if (sampling_type_ == (int)SamplingEnum::UNIFORM) {
+    return true;
+  } else {
+    return DumpFrequencySampler(writer);
+  }
+}
+
+bool SamplerBuilder::Update(const vec_int_t& nodes) {
+  // Copied, a view into a compressed store is overwritten by the next lookup.
+  std::vector<vec_pair_t> owned_contexts;
+  owned_contexts.reserve(nodes.size());
+  for (auto node : nodes) {
+    auto context = sampler_source_.FindContext(node);
+    owned_contexts.emplace_back(context.begin(), context.end());
+  }
+  std::vector<pair_view_t> contexts;
+  for (const auto& context : owned_contexts) {
+    contexts.emplace_back(context);
+  }
+  if (!PrepareUpdate(nodes, contexts)) {
+    return false;
+  }
+  PublishUpdate();
+  return true;
+}
+
 std::unique_ptr<SamplerBuilder> NewNeighborSamplerBuilder(
-    const SamplerSource* sampler_source, int sampler_type, int thread_num);
+    const SamplerSource* sampler_source, int sampler_type, int thread_num,
+    SnapshotReader* reader);
 std::unique_ptr<SamplerBuilder> NewNegativeSamplerBuilder(
-    const SamplerSource* sampler_source, int sampler_type, int thread_num);
+    const SamplerSource* sampler_source, int sampler_type, int thread_num,
+    SnapshotReader* reader);
 
 std::unique_ptr<SamplerBuilder> NewSamplerBuilder(
     const SamplerSource* sampler_source, SamplerBuilderEnum type,
-    int sampler_type, int thread_num) {
+    int sampler_type, int thread_num, SnapshotReader* reader) {
   std::unique_ptr<SamplerBuilder> sampler_builder;
   switch (type) {
     case SamplerBuilderEnum::NEIGHBOR_SAMPLER:
-      sampler_builder =
-          NewNeighborSamplerBuilder(sampler_source, sampler_type, thread_num);
+      sampler_builder = NewNeighborSamplerBuilder(sampler_source, sampler_type,
+                                                  thread_num, reader);
       break;
     case SamplerBuilderEnum::NEGATIVE_SAMPLER:
-      sampler_builder =
-          NewNegativeSamplerBuilder(sampler_source, sampler_type, thread_num);
+      sampler_builder = NewNegativeSamplerBuilder(sampler_source, sampler_type,
+                                                  thread_num, reader);
       break;
     default:
       DXERROR(
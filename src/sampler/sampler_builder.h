@@ -13,8 +13,12 @@
 #pragma once
 #include <functional>
 #include <memory>  // std::unique_ptr
+#include <vector>
 
 #include "src/common/data_types.h"
+#include "src/common/memory_usage.h"
+#include "src/common/published_ptr.h"
+#include "src/io/snapshot.h"
 #include "src/sampler/sampler_source.h"
 
 namespace embedx {
@@ -29,6 +33,8 @@ class SamplerBuilder {
   std::function<bool(int_t cur_node, int_t* next_node)> next_func_;
   std::function<bool(int_t cur_node, int begin, int end, int_t* next_node)>
       range_next_func_;
+  std::function<bool(int_t cur_node, int count, vec_int_t* next_nodes)>
+      next_n_func_;
 
  public:
   SamplerBuilder(const SamplerSource* sampler_source, int sampling_type,
@@ -40,6 +46,25 @@ class SamplerBuilder {
 
  public:
   virtual bool Init();
+  // Reads the sampler tables written by Dump instead of building them.
+  virtual bool Load(SnapshotReader* reader);
+  bool Dump(SnapshotWriter* writer) const;
+  // Adds the bytes of the sampler tables.
+  virtual void CollectMemory(MemoryUsage* /*usage*/) const {}
+  // Refreshes the tables of 'nodes' after their contexts were changed, see
+  // InMemoryGraph::ApplyDelta. Sampling keeps using the old tables until it
+  // is done.
+  bool Update(const vec_int_t& nodes);
+  // Update in two steps, see InMemoryGraph::PrepareDelta. PrepareUpdate builds
+  // the tables of 'nodes' from their new 'contexts', PublishUpdate replaces
+  // the old tables with them.
+  virtual bool PrepareUpdate(const vec_int_t& /*nodes*/,
+                             const std::vector<pair_view_t>& /*contexts*/) {
+    return true;
+  }
+  virtual void PublishUpdate() {}
+  // Keeps the tables of Update for the reads of the calling thread.
+  virtual void PinUpdate(PublishedPins* /*pins*/) const {}
 
  public:
   const SamplerSource& sampler_source() const noexcept {
@@ -56,10 +81,18 @@ class SamplerBuilder {
     return range_next_func_(cur_node, begin, end, next_node);
   }
 
+  // Fills 'next_nodes' with 'count' samples of 'cur_node', the sampler is
+  // looked up once.
+  bool NextN(int_t cur_node, int count, vec_int_t* next_nodes) const {
+    return next_n_func_(cur_node, count, next_nodes);
+  }
+
  protected:
   virtual bool InitUniformFuncs() = 0;
   virtual bool InitFrequencySampler() = 0;
   virtual bool InitFrequencyFuncs() = 0;
+  virtual bool DumpFrequencySampler(SnapshotWriter* writer) const = 0;
+  virtual bool LoadFrequencySampler(SnapshotReader* reader) = 0;
 };
 
 enum class SamplerBuilderEnum : int {
@@ -67,8 +100,9 @@ enum class SamplerBuilderEnum : int {
   NEGATIVE_SAMPLER = 1,
 };
 
+// Sampler tables are read from 'reader' if it is not nullptr.
 std::unique_ptr<SamplerBuilder> NewSamplerBuilder(
     const SamplerSource* sampler_source, SamplerBuilderEnum type,
-    int sampler_type, int thread_num);
+    int sampler_type, int thread_num, SnapshotReader* reader = nullptr);
 
 }  // namespace embedx
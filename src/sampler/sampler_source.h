@@ -30,7 +30,11 @@ class SamplerSource {
   virtual const std::vector<vec_int_t>& nodes_list() const noexcept = 0;
   virtual const std::vector<vec_float_t>& freqs_list() const noexcept = 0;
   virtual const vec_int_t& node_keys() const noexcept = 0;
-  virtual const vec_pair_t* FindContext(int_t node) const = 0;
+  virtual pair_view_t FindContext(int_t node) const = 0;
+  // Dense ids in [0, node_keys().size()) of the graph as built, see
+  // InMemoryGraph::LookupBaseRow. FindContext also sees graph deltas.
+  virtual bool LookupRow(int_t node, int* row) const = 0;
+  virtual pair_view_t FindContextAt(int row) const = 0;
 };
 
 std::unique_ptr<SamplerSource> NewGraphSamplerSource(
@@ -50,9 +50,17 @@ class DeepSamplerSource : public SamplerSource {
     DXERROR("Node_keys was not implemented in DeepSamplerSource.");
     return EMPTY_NODE_KEYS;
   }
-  const vec_pair_t* FindContext(int_t /*node*/) const override {
+  pair_view_t FindContext(int_t /*node*/) const override {
     DXERROR("Find_context was not implemented in DeepSamplerSource.");
-    return nullptr;
+    return pair_view_t();
+  }
+  bool LookupRow(int_t /*node*/, int* /*row*/) const override {
+    DXERROR("Lookup_row was not implemented in DeepSamplerSource.");
+    return false;
+  }
+  pair_view_t FindContextAt(int /*row*/) const override {
+    DXERROR("Find_context_at was not implemented in DeepSamplerSource.");
+    return pair_view_t();
   }
 };
 
@@ -39,9 +39,15 @@ class GraphSamplerSource : public SamplerSource {
   const vec_int_t& node_keys() const noexcept override {
     return graph_.node_keys();
   }
-  const vec_pair_t* FindContext(int_t node) const override {
+  pair_view_t FindContext(int_t node) const override {
     return graph_.FindContext(node);
   }
+  bool LookupRow(int_t node, int* row) const override {
+    return graph_.LookupBaseRow(node, row);
+  }
+  pair_view_t FindContextAt(int row) const override {
+    return graph_.FindContextAt(row);
+  }
 };
 
 std::unique_ptr<SamplerSource> NewGraphSamplerSource(
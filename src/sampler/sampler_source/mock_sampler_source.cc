@@ -58,9 +58,15 @@ class MockSamplerSource : public SamplerSource {
   const vec_int_t& node_keys() const noexcept override {
     return context_loader_->storage()->Keys();
   }
-  const vec_pair_t* FindContext(int_t node) const override {
+  pair_view_t FindContext(int_t node) const override {
     return context_loader_->storage()->FindNeighbor(node);
   }
+  bool LookupRow(int_t node, int* row) const override {
+    return context_loader_->storage()->LookupRow(node, row);
+  }
+  pair_view_t FindContextAt(int row) const override {
+    return context_loader_->storage()->FindNeighborAt(row);
+  }
 
  private:
   void Clear();
@@ -156,12 +162,12 @@ bool MockSamplerSource::Init(const std::string& node_graph,
     if (!Insert(node)) {
       return false;
     }
-    const auto* context = context_loader_->storage()->FindNeighbor(node);
-    if (context == nullptr) {
+    auto context = context_loader_->storage()->FindNeighbor(node);
+    if (context.empty()) {
       DXERROR("Couldn't find node: %" PRIu64 " context.", node);
       return false;
     }
-    for (auto& entry : *context) {
+    for (auto& entry : context) {
       if (!Insert(entry.first)) {
         return false;
       }
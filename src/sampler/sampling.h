@@ -13,6 +13,8 @@
 #include <memory>  // std::unique_ptr
 
 #include "src/common/data_types.h"
+#include "src/common/memory_usage.h"
+#include "src/io/snapshot.h"
 
 namespace embedx {
 
@@ -23,6 +25,13 @@ class Sampling {
  public:
   virtual int_t Next() const noexcept = 0;
   virtual int_t Next(int begin, int end) const noexcept = 0;
+  // Fills 'indices' with 'count' samples in one call.
+  virtual void NextN(int count, vec_int_t* indices) const = 0;
+
+ public:
+  virtual bool Dump(SnapshotWriter* writer) const = 0;
+  // Adds the bytes of the sampling table, named by the sampling type.
+  virtual void CollectMemory(MemoryUsage* /*usage*/) const {}
 };
 
 enum class SamplingEnum : int {
@@ -34,5 +43,7 @@ enum class SamplingEnum : int {
 
 std::unique_ptr<Sampling> NewSampling(const vec_float_t* probs,
                                       SamplingEnum type);
+std::unique_ptr<Sampling> NewSampling(SnapshotReader* reader,
+                                      SamplingEnum type);
 
 }  // namespace embedx
@@ -19,21 +19,34 @@
 
 namespace embedx {
 
-class AliasSampling : public Sampling {
+class AliasSampling final : public Sampling {
  private:
   vec_float_t alias_probs_;
   vec_int_t alias_tables_;
 
  public:
   static std::unique_ptr<Sampling> Create(const vec_float_t& probs);
+  static std::unique_ptr<Sampling> Create(SnapshotReader* reader);
 
  public:
   int_t Next() const noexcept override;
   int_t Next(int begin, int end) const noexcept override;
+  void NextN(int count, vec_int_t* indices) const override;
+
+ public:
+  bool Dump(SnapshotWriter* writer) const override {
+    return writer->WriteArray(alias_probs_) &&
+           writer->WriteArray(alias_tables_);
+  }
+  void CollectMemory(MemoryUsage* usage) const override {
+    usage->Add("alias", VectorBytes(alias_probs_) + VectorBytes(alias_tables_),
+               alias_probs_.size());
+  }
 
  private:
   // Always return true.
   bool Init(const vec_float_t& probs);
+  bool Load(SnapshotReader* reader);
 
   void Clear() noexcept {
     alias_probs_.clear();
@@ -55,9 +68,18 @@ std::unique_ptr<Sampling> AliasSampling::Create(const vec_float_t& probs) {
   return sampling;
 }
 
+std::unique_ptr<Sampling> AliasSampling::Create(SnapshotReader* reader) {
+  std::unique_ptr<Sampling> sampling(new AliasSampling);
+  if (!dynamic_cast<AliasSampling*>(sampling.get())->Load(reader)) {
+    DXERROR("Failed to load alias sampling.");
+    sampling.reset();
+  }
+  return sampling;
+}
+
 int_t AliasSampling::Next() const noexcept {
   size_t table_size = alias_probs_.size();
-  auto k = int_t(ThreadLocalRandom() * table_size);
+  int_t k = ThreadLocalRandomRange((uint32_t)table_size);
   if (ThreadLocalRandom() < alias_probs_[k]) {
     return k;
   } else {
@@ -70,6 +92,14 @@ int_t AliasSampling::Next(int /*begin*/, int /*end*/) const noexcept {
   return 0;
 }
 
+// The class is final, so that Next is not dispatched per sample.
+void AliasSampling::NextN(int count, vec_int_t* indices) const {
+  indices->resize(count);
+  for (auto& index : *indices) {
+    index = Next();
+  }
+}
+
 bool AliasSampling::Init(const vec_float_t& probs) {
   size_t table_size = probs.size();
 
@@ -104,8 +134,19 @@ bool AliasSampling::Init(const vec_float_t& probs) {
   return true;
 }
 
+bool AliasSampling::Load(SnapshotReader* reader) {
+  Clear();
+  return reader->ReadArray(&alias_probs_) &&
+         reader->ReadArray(&alias_tables_) &&
+         alias_probs_.size() == alias_tables_.size();
+}
+
 std::unique_ptr<Sampling> NewAliasSampling(const vec_float_t* probs) {
   return AliasSampling::Create(*probs);
 }
 
+std::unique_ptr<Sampling> NewAliasSampling(SnapshotReader* reader) {
+  return AliasSampling::Create(reader);
+}
+
 }  // namespace embedx
@@ -20,19 +20,31 @@
 
 namespace embedx {
 
-class PartialSumSampling : public Sampling {
+class PartialSumSampling final : public Sampling {
  private:
   vec_float_t partial_sum_table_;
 
  public:
   static std::unique_ptr<Sampling> Create(const vec_float_t& probs);
+  static std::unique_ptr<Sampling> Create(SnapshotReader* reader);
 
  public:
   int_t Next() const noexcept override;
   int_t Next(int begin, int end) const noexcept override;
+  void NextN(int count, vec_int_t* indices) const override;
+
+ public:
+  bool Dump(SnapshotWriter* writer) const override {
+    return writer->WriteArray(partial_sum_table_);
+  }
+  void CollectMemory(MemoryUsage* usage) const override {
+    usage->Add("partial_sum", VectorBytes(partial_sum_table_),
+               partial_sum_table_.size());
+  }
 
  private:
   bool Init(const vec_float_t& probs);
+  bool Load(SnapshotReader* reader);
 };
 
 std::unique_ptr<Sampling> PartialSumSampling::Create(const vec_float_t& probs) {
@@ -44,6 +56,15 @@ std::unique_ptr<Sampling> PartialSumSampling::Create(const vec_float_t& probs) {
   return sampling;
 }
 
+std::unique_ptr<Sampling> PartialSumSampling::Create(SnapshotReader* reader) {
+  std::unique_ptr<Sampling> sampling(new PartialSumSampling);
+  if (!dynamic_cast<PartialSumSampling*>(sampling.get())->Load(reader)) {
+    DXERROR("Failed to load partial sum sampling.");
+    sampling.reset();
+  }
+  return sampling;
+}
+
 int_t PartialSumSampling::Next() const noexcept {
   return Next(0, (int)partial_sum_table_.size());
 }
@@ -58,6 +79,17 @@ int_t PartialSumSampling::Next(int begin, int end) const noexcept {
   return (int_t)index;
 }
 
+void PartialSumSampling::NextN(int count, vec_int_t* indices) const {
+  float_t sum = partial_sum_table_.back();
+  indices->resize(count);
+  for (auto& index : *indices) {
+    float_t random = ThreadLocalRandom() * sum;
+    index = std::lower_bound(partial_sum_table_.begin(),
+                             partial_sum_table_.end(), random) -
+            partial_sum_table_.begin();
+  }
+}
+
 bool PartialSumSampling::Init(const vec_float_t& probs) {
   partial_sum_table_.clear();
   partial_sum_table_.resize(probs.size());
@@ -69,8 +101,17 @@ bool PartialSumSampling::Init(const vec_float_t& probs) {
   return sum != 0;
 }
 
+bool PartialSumSampling::Load(SnapshotReader* reader) {
+  return reader->ReadArray(&partial_sum_table_) &&
+         !partial_sum_table_.empty();
+}
+
 std::unique_ptr<Sampling> NewPartialSumSampling(const vec_float_t* probs) {
   return PartialSumSampling::Create(*probs);
 }
 
+std::unique_ptr<Sampling> NewPartialSumSampling(SnapshotReader* reader) {
+  return PartialSumSampling::Create(reader);
+}
+
 }  // namespace embedx
@@ -17,6 +17,10 @@ std::unique_ptr<Sampling> NewUniformSampling(const vec_float_t* probs);
 std::unique_ptr<Sampling> NewAliasSampling(const vec_float_t* probs);
 std::unique_ptr<Sampling> NewWord2vecSampling(const vec_float_t* probs);
 std::unique_ptr<Sampling> NewPartialSumSampling(const vec_float_t* probs);
+std::unique_ptr<Sampling> NewUniformSampling(SnapshotReader* reader);
+std::unique_ptr<Sampling> NewAliasSampling(SnapshotReader* reader);
+std::unique_ptr<Sampling> NewWord2vecSampling(SnapshotReader* reader);
+std::unique_ptr<Sampling> NewPartialSumSampling(SnapshotReader* reader);
 
 std::unique_ptr<Sampling> NewSampling(const vec_float_t* probs,
                                       SamplingEnum type) {
@@ -44,4 +48,30 @@ std::unique_ptr<Sampling> NewSampling(const vec_float_t* probs,
   return sampling;
 }
 
+std::unique_ptr<Sampling> NewSampling(SnapshotReader* reader,
+                                      SamplingEnum type) {
+  std::unique_ptr<Sampling> sampling;
+  switch (type) {
+    case SamplingEnum::UNIFORM:
+      sampling = NewUniformSampling(reader);
+      break;
+    case SamplingEnum::ALIAS:
+      sampling = NewAliasSampling(reader);
+      break;
+    case SamplingEnum::WORD2VEC:
+      sampling = NewWord2vecSampling(reader);
+      break;
+    case SamplingEnum::PARTIAL_SUM:
+      sampling = NewPartialSumSampling(reader);
+      break;
+    default:
+      DXERROR(
+          "Need type: UNIFORM(0) || ALIAS(1) || WORD2VEC(2) || PARTIAL_SUM(3), "
+          "got type: %d.",
+          (int)type);
+      break;
+  }
+  return sampling;
+}
+
 }  // namespace embedx
@@ -14,6 +14,7 @@
 #include <deepx_core/dx_log.h>
 #include <gtest/gtest.h>
 
+#include <cstdio>   // std::remove
 #include <memory>   // std::unique_ptr
 #include <numeric>  // std::accumulate
 #include <string>
@@ -21,6 +22,7 @@
 #include "src/common/data_types.h"
 #include "src/io/io_util.h"
 #include "src/io/line_parser.h"
+#include "src/io/snapshot.h"
 #include "src/io/value.h"
 #include "src/sampler/sampling/sampling_validator.h"
 
@@ -103,4 +105,49 @@ TEST_F(SamplingTest, PartialSumSampling) {
   EXPECT_TRUE(SamplingValidator::Test(normed_distribution_, sampled_nodes_));
 }
 
+TEST_F(SamplingTest, NextN) {
+  vec_int_t indices;
+  for (auto type : {SamplingEnum::ALIAS, SamplingEnum::PARTIAL_SUM}) {
+    sampler_ = NewSampling(&normed_probs_, type);
+    ASSERT_TRUE(sampler_ != nullptr);
+    sampler_->NextN(count_, &indices);
+    EXPECT_EQ(indices.size(), (size_t)count_);
+
+    sampled_nodes_.clear();
+    for (auto index : indices) {
+      sampled_nodes_.emplace_back(nodes_[index]);
+    }
+    EXPECT_TRUE(SamplingValidator::Test(normed_distribution_, sampled_nodes_));
+  }
+}
+
+TEST_F(SamplingTest, Snapshot) {
+  const std::string SNAPSHOT_FILE = "sampling_test.snapshot";
+  SamplingEnum types[] = {SamplingEnum::UNIFORM, SamplingEnum::ALIAS,
+                          SamplingEnum::WORD2VEC, SamplingEnum::PARTIAL_SUM};
+
+  SnapshotWriter writer;
+  EXPECT_TRUE(writer.Open(SNAPSHOT_FILE));
+  for (auto type : types) {
+    sampler_ = NewSampling(&normed_probs_, type);
+    EXPECT_TRUE(sampler_ != nullptr);
+    EXPECT_TRUE(sampler_->Dump(&writer));
+  }
+  EXPECT_TRUE(writer.Close());
+
+  SnapshotReader reader;
+  EXPECT_TRUE(reader.Open(SNAPSHOT_FILE));
+  for (auto type : types) {
+    sampler_ = NewSampling(&reader, type);
+    EXPECT_TRUE(sampler_ != nullptr);
+    if (type == SamplingEnum::ALIAS) {
+      DoSampling(&sampled_nodes_);
+      EXPECT_TRUE(
+          SamplingValidator::Test(normed_distribution_, sampled_nodes_));
+    }
+  }
+  EXPECT_TRUE(reader.AtEnd());
+  std::remove(SNAPSHOT_FILE.c_str());
+}
+
 }  // namespace embedx
@@ -19,19 +19,27 @@
 
 namespace embedx {
 
-class UniformSampling : public Sampling {
+class UniformSampling final : public Sampling {
  private:
   int table_size_ = 0;
 
  public:
   static std::unique_ptr<Sampling> Create(const vec_float_t* probs);
+  static std::unique_ptr<Sampling> Create(SnapshotReader* reader);
 
  public:
   int_t Next() const noexcept override;
   int_t Next(int begin, int end) const noexcept override;
+  void NextN(int count, vec_int_t* indices) const override;
+
+ public:
+  bool Dump(SnapshotWriter* writer) const override {
+    return writer->WriteValue(table_size_);
+  }
 
  private:
   bool Init(const vec_float_t& probs);
+  bool Load(SnapshotReader* reader);
 };
 
 std::unique_ptr<Sampling> UniformSampling::Create(const vec_float_t* probs) {
@@ -43,10 +51,26 @@ std::unique_ptr<Sampling> UniformSampling::Create(const vec_float_t* probs) {
   return sampling;
 }
 
+std::unique_ptr<Sampling> UniformSampling::Create(SnapshotReader* reader) {
+  std::unique_ptr<Sampling> sampling(new UniformSampling);
+  if (!dynamic_cast<UniformSampling*>(sampling.get())->Load(reader)) {
+    DXERROR("Failed to load uniform sampling.");
+    sampling.reset();
+  }
+  return sampling;
+}
+
 int_t UniformSampling::Next() const noexcept { return Next(0, table_size_); }
 
 int_t UniformSampling::Next(int begin, int end) const noexcept {
-  return (int_t)(ThreadLocalRandom() * (end - begin)) + begin;
+  return (int_t)ThreadLocalRandomRange(end - begin) + begin;
+}
+
+void UniformSampling::NextN(int count, vec_int_t* indices) const {
+  indices->resize(count);
+  for (auto& index : *indices) {
+    index = ThreadLocalRandomRange(table_size_);
+  }
 }
 
 bool UniformSampling::Init(const vec_float_t& probs) {
@@ -54,8 +78,16 @@ bool UniformSampling::Init(const vec_float_t& probs) {
   return table_size_ != 0;
 }
 
+bool UniformSampling::Load(SnapshotReader* reader) {
+  return reader->ReadValue(&table_size_) && table_size_ != 0;
+}
+
 std::unique_ptr<Sampling> NewUniformSampling(const vec_float_t* probs) {
   return UniformSampling::Create(probs);
 }
 
+std::unique_ptr<Sampling> NewUniformSampling(SnapshotReader* reader) {
+  return UniformSampling::Create(reader);
+}
+
 }  // namespace embedx
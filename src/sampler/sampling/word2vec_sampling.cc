@@ -22,7 +22,7 @@
 
 namespace embedx {
 
-class Word2vecSampling : public Sampling {
+class Word2vecSampling final : public Sampling {
   class Table {
    private:
     static constexpr size_t MAX_TABLE_SIZE = 1000000000;
@@ -85,13 +85,30 @@ class Word2vecSampling : public Sampling {
       return true;
     }
 
+    bool Dump(SnapshotWriter* writer) const {
+      return writer->WriteArray(sample_tables_);
+    }
+
+    bool Load(SnapshotReader* reader) {
+      if (!reader->ReadArray(&sample_tables_)) {
+        return false;
+      }
+      table_size_ = sample_tables_.size();
+      return table_size_ > 1u;
+    }
+
+    void CollectMemory(MemoryUsage* usage) const {
+      usage->Add("word2vec", VectorBytes(sample_tables_),
+                 sample_tables_.size());
+    }
+
     void clear() noexcept {
       table_size_ = 0;
       sample_tables_.clear();
     }
 
     int_t Next() const noexcept {
-      auto k = (int_t)(ThreadLocalRandom() * table_size_);
+      auto k = ThreadLocalRandomRange((uint32_t)table_size_);
       return sample_tables_[k];
     }
   };
@@ -100,15 +117,26 @@ class Word2vecSampling : public Sampling {
 
  public:
   static std::unique_ptr<Sampling> Create(const vec_float_t& probs);
+  static std::unique_ptr<Sampling> Create(SnapshotReader* reader);
 
  public:
   int_t Next() const noexcept override;
   int_t Next(int begin, int end) const noexcept override;
+  void NextN(int count, vec_int_t* indices) const override;
+
+ public:
+  bool Dump(SnapshotWriter* writer) const override {
+    return table_.Dump(writer);
+  }
+  void CollectMemory(MemoryUsage* usage) const override {
+    table_.CollectMemory(usage);
+  }
 
  private:
   void Clear() noexcept { table_.clear(); }
 
   bool Init(const vec_float_t& freqs);
+  bool Load(SnapshotReader* reader);
 };
 
 std::unique_ptr<Sampling> Word2vecSampling::Create(const vec_float_t& probs) {
@@ -120,6 +148,15 @@ std::unique_ptr<Sampling> Word2vecSampling::Create(const vec_float_t& probs) {
   return sampling;
 }
 
+std::unique_ptr<Sampling> Word2vecSampling::Create(SnapshotReader* reader) {
+  std::unique_ptr<Sampling> sampling(new Word2vecSampling);
+  if (!dynamic_cast<Word2vecSampling*>(sampling.get())->Load(reader)) {
+    DXERROR("Failed to load word2vec sampling.");
+    sampling.reset();
+  }
+  return sampling;
+}
+
 int_t Word2vecSampling::Next() const noexcept { return table_.Next(); }
 
 int_t Word2vecSampling::Next(int /*begin*/, int /*end*/) const noexcept {
@@ -127,6 +164,13 @@ int_t Word2vecSampling::Next(int /*begin*/, int /*end*/) const noexcept {
   return 0;
 }
 
+void Word2vecSampling::NextN(int count, vec_int_t* indices) const {
+  indices->resize(count);
+  for (auto& index : *indices) {
+    index = table_.Next();
+  }
+}
+
 bool Word2vecSampling::Init(const vec_float_t& freqs) {
   if (freqs.empty()) {
     DXERROR("Frequency tables are empty!");
@@ -136,8 +180,17 @@ bool Word2vecSampling::Init(const vec_float_t& freqs) {
   return table_.Init(freqs);
 }
 
+bool Word2vecSampling::Load(SnapshotReader* reader) {
+  Clear();
+  return table_.Load(reader);
+}
+
 std::unique_ptr<Sampling> NewWord2vecSampling(const vec_float_t* probs) {
   return Word2vecSampling::Create(*probs);
 }
 
+std::unique_ptr<Sampling> NewWord2vecSampling(SnapshotReader* reader) {
+  return Word2vecSampling::Create(reader);
+}
+
 }  // namespace embedx
@@ -45,6 +45,10 @@ DEFINE_string(in, "", "Input dir/file of training/testing data(role is ps).");
 DEFINE_string(pretrain_path, "", "Input dir/file of pretrain param.");
 DEFINE_string(item_feature, "", "Input dir/file of item feature.");
 DEFINE_string(inst_file, "", "Input dir/file of instance file.");
+DEFINE_string(inst_binary_file, "",
+              "Binary instance file to map instead of inst_file.");
+DEFINE_string(dump_inst_binary_file, "",
+              "Output binary instance file of inst_file.");
 DEFINE_string(freq_file, "", "Input dir/file of item frequency.");
 DEFINE_bool(
     shuffle, true,
@@ -54,7 +58,9 @@ DEFINE_uint64(ts_now, 0, "Timestamp of now.");
 DEFINE_uint64(ts_expire_threshold, 0, "Timestamp expiration threshold.");
 DEFINE_uint64(freq_filter_threshold, 0, "Frequency filter threshold.");
 DEFINE_int32(verbose, 1, "Verbose level: 0-10(role is wk).");
-DEFINE_int32(seed, 9527, "Seed of random engine(role is ps).");
+DEFINE_int32(seed, 9527,
+             "Seed of random engine(role is ps) and graph sampling(role is "
+             "wk).");
 DEFINE_int32(target_type, 2, "0 for loss, 1 for prob, 2 for emb.");
 DEFINE_bool(out_model_remove_zeros, false, "Remove zeros from output model.");
 DEFINE_string(out_model, "",
@@ -40,6 +40,8 @@ DECLARE_string(in);
 DECLARE_string(pretrain_path);
 DECLARE_string(item_feature);
 DECLARE_string(inst_file);
+DECLARE_string(inst_binary_file);
+DECLARE_string(dump_inst_binary_file);
 DECLARE_string(freq_file);
 DECLARE_bool(shuffle);
 DECLARE_bool(ts_enable);
@@ -250,6 +250,8 @@ bool TrainerDist::Init() {
   if (FLAGS_gnn_model) {
     GraphConfig graph_config;
     graph_config.set_ip_ports(FLAGS_gs_addrs);
+    graph_config.set_partitioner_type(FLAGS_gs_partitioner_type);
+    graph_config.set_partition_file(FLAGS_gs_partition_file);
 
     graph_client_ = NewGraphClient(graph_config, GraphClientEnum::DIST);
     if (!graph_client_) {
@@ -260,7 +262,7 @@ bool TrainerDist::Init() {
   if (FLAGS_deep_model) {
     if (FLAGS_is_train &&
         (!FLAGS_item_feature.empty() || !FLAGS_inst_file.empty() ||
-         !FLAGS_freq_file.empty())) {
+         !FLAGS_inst_binary_file.empty() || !FLAGS_freq_file.empty())) {
       DeepConfig deep_config;
 
       if (!FLAGS_item_feature.empty()) {
@@ -268,6 +270,10 @@ bool TrainerDist::Init() {
       }
       if (!FLAGS_inst_file.empty()) {
         deep_config.set_inst_file(FLAGS_inst_file);
+        deep_config.set_dump_inst_binary_file(FLAGS_dump_inst_binary_file);
+      }
+      if (!FLAGS_inst_binary_file.empty()) {
+        deep_config.set_inst_binary_file(FLAGS_inst_binary_file);
       }
       if (!FLAGS_freq_file.empty()) {
         deep_config.set_freq_file(FLAGS_freq_file);
@@ -342,6 +348,13 @@ void TrainerDist::Train() {
           continue;
         } else {
           DXINFO("Worker has got file: %s.", file.c_str());
+          if (graph_client_) {
+            // Servers may have reloaded their graphs or applied deltas.
+            if (!graph_client_->RefreshCache()) {
+              DXERROR("Failed to refresh graph client cache.");
+            }
+            graph_client_->SeedSampling((uint64_t)FLAGS_seed, epoch);
+          }
           context_.TrainFile(0, file);
           auto* file_finished_notify =
               cs_conn_.mutable_out_message()->mutable_file_finish_notify();
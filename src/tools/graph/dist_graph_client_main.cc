@@ -184,6 +184,8 @@ class GraphClientTest {
  public:
   bool Init(const std::string& ip_ports) {
     graph_config_.set_ip_ports(ip_ports);
+    graph_config_.set_partitioner_type(FLAGS_gs_partitioner_type);
+    graph_config_.set_partition_file(FLAGS_gs_partition_file);
     graph_client_ = NewGraphClient(graph_config_, GraphClientEnum::DIST);
     return graph_client_ != nullptr;
   }
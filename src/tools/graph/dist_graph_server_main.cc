@@ -13,8 +13,11 @@
 #include <deepx_core/common/stream.h>
 #include <gflags/gflags.h>
 
+#include <string>  // std::stoi
+
 #include "src/graph/graph_config.h"
 #include "src/graph/server/dist_graph_server.h"
+#include "src/io/storage/adjacency.h"
 #include "src/tools/graph/graph_flags.h"
 
 namespace embedx {
@@ -23,13 +26,20 @@ namespace {
 void SetGraphConfig(GraphConfig* graph_config) {
   graph_config->set_ip_ports(FLAGS_gs_addrs);
   graph_config->set_shard_num(FLAGS_gs_shard_num);
+  graph_config->set_partitioner_type(FLAGS_gs_partitioner_type);
+  graph_config->set_partition_file(FLAGS_gs_partition_file);
   graph_config->set_shard_id(FLAGS_gs_shard_id);
   graph_config->set_thread_num(FLAGS_gs_thread_num);
+  graph_config->set_store_partition_num(FLAGS_store_partition_num);
 
   graph_config->set_node_graph(FLAGS_node_graph);
   graph_config->set_node_config(FLAGS_node_config);
   graph_config->set_node_feature(FLAGS_node_feature);
   graph_config->set_neighbor_feature(FLAGS_neighbor_feature);
+  graph_config->set_store_type(FLAGS_store_type);
+  graph_config->set_feature_store_type(FLAGS_feature_store_type);
+  graph_config->set_neighbor_feature_store_type(
+      FLAGS_neighbor_feature_store_type);
 
   graph_config->set_negative_sampler_type(FLAGS_negative_sampler_type);
   graph_config->set_neighbor_sampler_type(FLAGS_neighbor_sampler_type);
@@ -38,20 +48,56 @@ void SetGraphConfig(GraphConfig* graph_config) {
   graph_config->set_cache_thld(FLAGS_cache_thld);
   graph_config->set_cache_type(FLAGS_cache_type);
   graph_config->set_max_node_per_rpc(FLAGS_max_node_per_rpc);
+  // Only the importance cache reads in-degrees, snapshots keep them for the
+  // servers loading them.
+  graph_config->set_build_in_degree(
+      (FLAGS_cache_type == 2 && FLAGS_cache_thld > 0) ||
+      !FLAGS_dump_snapshot.empty());
 
   graph_config->set_success_out(FLAGS_success_out);
+  graph_config->set_print_memory(FLAGS_print_memory);
+
+  graph_config->set_dump_snapshot(FLAGS_dump_snapshot);
+  graph_config->set_load_snapshot(FLAGS_load_snapshot);
+
+  graph_config->set_delta_dir(FLAGS_delta_dir);
+  graph_config->set_reload_dir(FLAGS_reload_dir);
+  graph_config->set_watch_interval(FLAGS_watch_interval);
 }
 
 /************************************************************************/
 /* main */
 /************************************************************************/
 void CheckFlags() {
-  DXCHECK(!FLAGS_gs_addrs.empty());
+  DXCHECK(FLAGS_dump_snapshot.empty() || FLAGS_load_snapshot.empty());
+  if (FLAGS_dump_snapshot.empty()) {
+    DXCHECK(!FLAGS_gs_addrs.empty());
+  }
   DXCHECK(FLAGS_gs_shard_num > 0);
   DXCHECK(FLAGS_gs_shard_id >= 0);
+  DXCHECK(FLAGS_gs_partitioner_type >= 0 && FLAGS_gs_partitioner_type <= 2);
+  if (FLAGS_gs_partitioner_type != 0) {
+    DXCHECK(!FLAGS_gs_partition_file.empty());
+  }
   DXCHECK(FLAGS_gs_thread_num > 0);
-
-  DXCHECK(!FLAGS_node_graph.empty());
+  DXCHECK(FLAGS_store_partition_num > 0);
+
+  if (FLAGS_load_snapshot.empty()) {
+    DXCHECK(!FLAGS_node_graph.empty());
+  } else {
+    // A snapshot is always loaded into csr storages.
+    for (const char* flag : {"store_type", "feature_store_type",
+                             "neighbor_feature_store_type"}) {
+      google::CommandLineFlagInfo info;
+      DXCHECK(google::GetCommandLineFlagInfo(flag, &info));
+      DXCHECK(info.is_default ||
+              std::stoi(info.current_value) == (int)AdjacencyEnum::ADJ_CSR);
+    }
+  }
+  DXCHECK(FLAGS_store_type >= 0 && FLAGS_store_type <= 8);
+  DXCHECK(FLAGS_feature_store_type >= -1 && FLAGS_feature_store_type <= 8);
+  DXCHECK(FLAGS_neighbor_feature_store_type >= -1 &&
+          FLAGS_neighbor_feature_store_type <= 8);
 
   DXCHECK(FLAGS_negative_sampler_type == 0 ||
           FLAGS_negative_sampler_type == 1 ||
@@ -65,6 +111,7 @@ void CheckFlags() {
   DXCHECK(FLAGS_cache_type == 0 || FLAGS_cache_type == 1 ||
           FLAGS_cache_type == 2);
   DXCHECK(FLAGS_max_node_per_rpc > 0);
+  DXCHECK(FLAGS_watch_interval > 0);
 
   if (!FLAGS_success_out.empty()) {
     deepx_core::AutoFileSystem fs;
@@ -86,6 +133,10 @@ int main(int argc, char* argv[]) {
   SetGraphConfig(&graph_config);
 
   DistGraphServer server;
+  if (!FLAGS_dump_snapshot.empty()) {
+    DXCHECK(server.DumpSnapshot(graph_config));
+    return 0;
+  }
   DXCHECK(server.Start(graph_config));
 
   return 0;
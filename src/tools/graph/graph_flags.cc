@@ -17,6 +17,13 @@ DEFINE_string(
     "Graph server ip/port, format like:127.0.0.1:8000;127.0.0.1:8001.");
 DEFINE_int32(gs_shard_num, 1, "Graph data shard number.");
 DEFINE_int32(gs_shard_id, 0, "Current shard id.");
+DEFINE_int32(gs_partitioner_type, 0,
+             "How nodes are assigned to shards, the same for servers and "
+             "clients: 0 node % shard number | 1 ranges of nodes | 2 node to "
+             "shard map.");
+DEFINE_string(gs_partition_file, "",
+              "Range bounds or node to shard map for 'gs_partitioner_type' 1 "
+              "or 2.");
 DEFINE_int32(gs_worker_num, -1, "How many worker used to process graph data.");
 DEFINE_int32(gs_worker_id, -1, "Worker id of distributed graph server.");
 
@@ -27,6 +34,19 @@ DEFINE_string(node_config, "",
 DEFINE_string(node_feature, "", "Node feature folder.");
 DEFINE_string(neighbor_feature, "",
               "Neighbor feature folder, this can be empty.");
+DEFINE_int32(store_type, 0,
+             "Graph storage, for now support: 0 adjacency list | 1 adjacency "
+             "matrix | 2 csr | 3 compressed | 4 compressed with 16 bit "
+             "weights | 5 compressed with 8 bit weights | 6 deduplicated | 7 "
+             "compressed with half float weights and features | 8 "
+             "compressed with bfloat16 weights and features. With "
+             "'load_snapshot' storages are always csr, the store types must "
+             "be left unset or set to 2.");
+DEFINE_int32(feature_store_type, -1,
+             "Storage of node and neighbor features, -1 for 'store_type'. 6 "
+             "stores identical feature rows once, contiguous per namespace.");
+DEFINE_int32(neighbor_feature_store_type, -1,
+             "Storage of neighbor features, -1 for 'feature_store_type'.");
 
 // sampler type
 DEFINE_int32(
@@ -53,9 +73,39 @@ DEFINE_int32(max_node_per_rpc, 2000,
 // perf
 DEFINE_int32(batch_node, 128, "Batch nodes.");
 DEFINE_int32(gs_thread_num, 1, "How many thread used to parse graph data.");
+DEFINE_int32(store_partition_num, 1,
+             "How many locked partitions the graph storages are split into, "
+             "more than 1 lets parsing threads insert concurrently.");
 
 // out
 DEFINE_string(out, "", "Output folder or file.");
 DEFINE_string(success_out, "",
               "The hdfs dir for saving success files, each graph server will "
               "generate a success file when server is ready.");
+DEFINE_bool(print_memory, false,
+            "Print the memory usage of the graph and the samplers once they "
+            "are built.");
+
+// snapshot
+DEFINE_string(dump_snapshot, "",
+              "Local file to write the built graph and sampler tables to, the "
+              "server exits once it is written.");
+DEFINE_string(load_snapshot, "",
+              "Local file written by 'dump_snapshot', the graph and sampler "
+              "tables are mapped from it instead of being built.");
+
+// delta and reload
+DEFINE_string(delta_dir, "",
+              "Directory of graph deltas applied while the server is running. "
+              "Delta 'n' is read from 'delta_dir/n' once "
+              "'delta_dir/n/_SUCCESS' exists, starting from 1.");
+DEFINE_string(reload_dir, "",
+              "Directory of complete graphs swapped in while the server is "
+              "running. Version 'v' is built from 'reload_dir/v' once "
+              "'reload_dir/v/_SUCCESS' exists, starting from 1, with "
+              "'node_graph' and the optional 'node_feature', "
+              "'neighbor_feature' or a 'snapshot' file. Its deltas are read "
+              "from 'reload_dir/v/delta' instead of 'delta_dir'.");
+DEFINE_int32(watch_interval, 60,
+             "Seconds between checks for the next delta in 'delta_dir' and "
+             "the next version in 'reload_dir'.");
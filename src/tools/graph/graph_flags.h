@@ -17,6 +17,8 @@ DECLARE_int32(dist);
 DECLARE_string(gs_addrs);
 DECLARE_int32(gs_shard_num);
 DECLARE_int32(gs_shard_id);
+DECLARE_int32(gs_partitioner_type);
+DECLARE_string(gs_partition_file);
 DECLARE_int32(gs_worker_num);
 DECLARE_int32(gs_worker_id);
 
@@ -25,6 +27,9 @@ DECLARE_string(node_graph);
 DECLARE_string(node_config);
 DECLARE_string(node_feature);
 DECLARE_string(neighbor_feature);
+DECLARE_int32(store_type);
+DECLARE_int32(feature_store_type);
+DECLARE_int32(neighbor_feature_store_type);
 
 // sampler type
 DECLARE_int32(negative_sampler_type);
@@ -34,6 +39,7 @@ DECLARE_int32(random_walker_type);
 // perf
 DECLARE_int32(batch_node);
 DECLARE_int32(gs_thread_num);
+DECLARE_int32(store_partition_num);
 
 // cache
 DECLARE_double(cache_thld);
@@ -43,3 +49,13 @@ DECLARE_int32(max_node_per_rpc);
 // output
 DECLARE_string(out);
 DECLARE_string(success_out);
+DECLARE_bool(print_memory);
+
+// snapshot
+DECLARE_string(dump_snapshot);
+DECLARE_string(load_snapshot);
+
+// delta and reload
+DECLARE_string(delta_dir);
+DECLARE_string(reload_dir);
+DECLARE_int32(watch_interval);
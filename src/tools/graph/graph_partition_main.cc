@@ -0,0 +1,149 @@
+// Tencent is pleased to support the open source community by making embedx
+// available.
+//
+// Copyright (C) 2021 THL A29 Limited, a Tencent company.  All rights reserved.
+//
+// Licensed under the BSD 3-Clause License and other third-party components,
+// please refer to LICENSE for details.
+//
+
+#include <deepx_core/common/stream.h>
+#include <deepx_core/dx_log.h>
+#include <gflags/gflags.h>
+
+#include <cinttypes>  // PRIu64
+#include <string>
+#include <vector>
+
+#include "src/common/data_types.h"
+#include "src/io/io_util.h"
+#include "src/io/line_parser.h"
+#include "src/io/shard_partitioner.h"
+#include "src/io/value.h"
+#include "src/tools/graph/graph_flags.h"
+#include "src/tools/graph/partition/stream_partition.h"
+
+// graph_partition_main
+DEFINE_int32(partition_method, 0, "0 for LDG, 1 for FENNEL.");
+DEFINE_double(partition_slack, 0.1,
+              "Shards hold at most (1 + partition_slack) times the average "
+              "load, the load of a node is 1 plus its degree.");
+DEFINE_double(fennel_gamma, 1.5, "Exponent of the FENNEL load penalty.");
+
+namespace embedx {
+namespace {
+
+constexpr int BATCH = 128;
+
+// Calls 'func(value)' for every context in 'files', in file order.
+template <typename Func>
+bool ForEachContext(const vec_str_t& files, Func&& func) {
+  std::vector<AdjValue> values;
+  LineParser line_parser;
+  for (const auto& file : files) {
+    if (!line_parser.Open(file)) {
+      return false;
+    }
+    while (line_parser.NextBatch<AdjValue>(BATCH, &values)) {
+      for (const auto& value : values) {
+        func(value);
+      }
+    }
+  }
+  return true;
+}
+
+int main(int argc, char** argv) {
+  google::SetUsageMessage("Usage: [Options]");
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  DXCHECK(!FLAGS_node_graph.empty());
+  DXCHECK(FLAGS_gs_shard_num > 0);
+  DXCHECK(FLAGS_partition_method == (int)StreamPartitionEnum::LDG ||
+          FLAGS_partition_method == (int)StreamPartitionEnum::FENNEL);
+  DXCHECK(FLAGS_partition_slack >= 0);
+  DXCHECK(!FLAGS_out.empty());
+
+  vec_str_t files;
+  if (!io_util::ListFile(FLAGS_node_graph, &files)) {
+    return -1;
+  }
+
+  // The first pass sizes the shards.
+  uint64_t total_node = 0;
+  uint64_t total_edge = 0;
+  if (!ForEachContext(files, [&total_node, &total_edge](const AdjValue& value) {
+        ++total_node;
+        total_edge += value.pairs.size();
+      })) {
+    return -1;
+  }
+  DXINFO("Got %" PRIu64 " nodes and %" PRIu64 " edges.", total_node,
+         total_edge);
+
+  // The second pass assigns the nodes in stream order.
+  StreamPartitionConfig config;
+  config.shard_num = FLAGS_gs_shard_num;
+  config.method = FLAGS_partition_method;
+  config.slack = FLAGS_partition_slack;
+  config.gamma = FLAGS_fennel_gamma;
+  StreamPartition partition(config, total_node, total_edge);
+  if (!ForEachContext(files, [&partition](const AdjValue& value) {
+        partition.Assign(value.node, value.pairs);
+      })) {
+    return -1;
+  }
+
+  deepx_core::AutoOutputFileStream ofs;
+  if (!ofs.Open(FLAGS_out)) {
+    DXERROR("Failed to open file: %s.", FLAGS_out.c_str());
+    return -1;
+  }
+  std::string line;
+  for (const auto& entry : partition.shards()) {
+    line = std::to_string(entry.first) + " " + std::to_string(entry.second) +
+           "\n";
+    ofs.Write(line.data(), line.size());
+  }
+  if (!ofs) {
+    DXERROR("Failed to write file: %s.", FLAGS_out.c_str());
+    return -1;
+  }
+
+  // The last pass compares cross-shard edges with hash-mod partitioning.
+  auto hash_mod = NewShardPartitioner((int)PartitionerEnum::HASH_MOD,
+                                      FLAGS_gs_shard_num);
+  uint64_t cut_edge = 0;
+  uint64_t hash_mod_cut_edge = 0;
+  if (!ForEachContext(files, [&](const AdjValue& value) {
+        int shard = partition.GetShard(value.node);
+        int hash_mod_shard = hash_mod->GetShard(value.node);
+        for (const auto& entry : value.pairs) {
+          int neighbor_shard = partition.GetShard(entry.first);
+          if (neighbor_shard < 0) {
+            neighbor_shard = hash_mod->GetShard(entry.first);
+          }
+          cut_edge += neighbor_shard != shard;
+          hash_mod_cut_edge +=
+              hash_mod->GetShard(entry.first) != hash_mod_shard;
+        }
+      })) {
+    return -1;
+  }
+
+  for (int i = 0; i < FLAGS_gs_shard_num; ++i) {
+    DXINFO("Shard: %d, load: %" PRIu64 ".", i, partition.loads()[i]);
+  }
+  DXINFO("Cross-shard edges: %" PRIu64 ", hash-mod: %" PRIu64 ".", cut_edge,
+         hash_mod_cut_edge);
+  DXINFO("Wrote the shards of %zu nodes to: %s.", partition.shards().size(),
+         FLAGS_out.c_str());
+
+  google::ShutDownCommandLineFlags();
+  return 0;
+}
+
+}  // namespace
+}  // namespace embedx
+
+int main(int argc, char** argv) { return embedx::main(argc, argv); }
@@ -0,0 +1,141 @@
+// Tencent is pleased to support the open source community by making embedx
+// available.
+//
+// Copyright (C) 2021 THL A29 Limited, a Tencent company.  All rights reserved.
+//
+// Licensed under the BSD 3-Clause License and other third-party components,
+// please refer to LICENSE for details.
+//
+
+#include <deepx_core/dx_log.h>
+#include <gflags/gflags.h>
+
+#include <algorithm>  // std::shuffle
+#include <chrono>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "src/common/data_types.h"
+#include "src/common/flat_hash_map.h"
+
+DEFINE_int32(benchmark_node_num, 1000000, "Nodes in the maps.");
+DEFINE_int32(benchmark_degree, 8, "Neighbors per node in the context maps.");
+DEFINE_int32(benchmark_lookup_num, 10000000, "Lookups per map.");
+
+namespace embedx {
+namespace {
+
+class Timer {
+ private:
+  std::chrono::steady_clock::time_point begin_ =
+      std::chrono::steady_clock::now();
+
+ public:
+  double seconds() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                         begin_)
+        .count();
+  }
+};
+
+// Node ids with a node type in the high bits, like the ones in graph files.
+vec_int_t MakeNodes(int node_num, std::default_random_engine* engine) {
+  vec_int_t nodes(node_num);
+  for (int i = 0; i < node_num; ++i) {
+    nodes[i] = ((int_t)(i % 4) << 48) | (int_t)i * 7;
+  }
+  std::shuffle(nodes.begin(), nodes.end(), *engine);
+  return nodes;
+}
+
+// The node lookups of Indexing and IndexingWrapper::GlobalGet.
+template <typename Map>
+void BenchmarkIndexing(const char* name, const vec_int_t& nodes,
+                       const vec_int_t& queries) {
+  Timer build_timer;
+  Map map;
+  map.reserve(nodes.size());
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    map.emplace(nodes[i], (int)i);
+  }
+  double build_seconds = build_timer.seconds();
+
+  Timer lookup_timer;
+  int64_t sum = 0;
+  for (auto node : queries) {
+    auto it = map.find(node);
+    if (it != map.end()) {
+      sum += it->second;
+    }
+  }
+  double lookup_seconds = lookup_timer.seconds();
+
+  DXINFO("%s indexing, build: %.3f s, lookup: %.1f ns/op, checksum: %lld.",
+         name, build_seconds, lookup_seconds * 1e9 / queries.size(),
+         (long long)sum);
+}
+
+// The context lookups of the neighbor sampler: find the node, then read one
+// of its neighbors.
+template <typename Map>
+void BenchmarkContext(const char* name, const vec_int_t& nodes,
+                      const vec_int_t& queries, int degree) {
+  Map map;
+  map.reserve(nodes.size());
+  vec_pair_t context(degree);
+  for (auto node : nodes) {
+    for (int i = 0; i < degree; ++i) {
+      context[i] = pair_t(node + i, 1);
+    }
+    map.emplace(node, context);
+  }
+
+  Timer lookup_timer;
+  int_t sum = 0;
+  for (size_t i = 0; i < queries.size(); ++i) {
+    auto it = map.find(queries[i]);
+    if (it != map.end()) {
+      sum += it->second[i % degree].first;
+    }
+  }
+  double lookup_seconds = lookup_timer.seconds();
+
+  DXINFO("%s context, lookup: %.1f ns/op, checksum: %llu.", name,
+         lookup_seconds * 1e9 / queries.size(), (unsigned long long)sum);
+}
+
+int main(int argc, char** argv) {
+  google::SetUsageMessage("Usage: [Options]");
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  DXCHECK_THROW(FLAGS_benchmark_node_num > 0);
+  DXCHECK_THROW(FLAGS_benchmark_degree > 0);
+  DXCHECK_THROW(FLAGS_benchmark_lookup_num > 0);
+
+  std::default_random_engine engine;
+  auto nodes = MakeNodes(FLAGS_benchmark_node_num, &engine);
+  // 90% hits
+  vec_int_t queries(FLAGS_benchmark_lookup_num);
+  std::uniform_int_distribution<size_t> dist(0, nodes.size() * 10 / 9);
+  for (auto& query : queries) {
+    size_t i = dist(engine);
+    query = i < nodes.size() ? nodes[i] : (int_t)i * 7 + 1;
+  }
+
+  BenchmarkIndexing<std::unordered_map<int_t, int>>("std::unordered_map", nodes,
+                                                    queries);
+  BenchmarkIndexing<FlatHashMap<int_t, int>>("FlatHashMap", nodes, queries);
+  BenchmarkContext<std::unordered_map<int_t, vec_pair_t>>(
+      "std::unordered_map", nodes, queries, FLAGS_benchmark_degree);
+  BenchmarkContext<FlatHashMap<int_t, vec_pair_t>>("FlatHashMap", nodes, queries,
+                                                   FLAGS_benchmark_degree);
+
+  google::ShutDownCommandLineFlags();
+  return 0;
+}
+
+}  // namespace
+}  // namespace embedx
+
+int main(int argc, char** argv) { return embedx::main(argc, argv); }
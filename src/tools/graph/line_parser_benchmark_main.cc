@@ -0,0 +1,94 @@
+// Tencent is pleased to support the open source community by making embedx
+// available.
+//
+// Copyright (C) 2021 THL A29 Limited, a Tencent company.  All rights reserved.
+//
+// Licensed under the BSD 3-Clause License and other third-party components,
+// please refer to LICENSE for details.
+//
+
+#include <deepx_core/dx_log.h>
+#include <gflags/gflags.h>
+
+#include <chrono>
+#include <cinttypes>  // PRIu64
+#include <string>
+#include <vector>
+
+#include "src/common/data_types.h"
+#include "src/io/io_util.h"
+#include "src/io/line_parser.h"
+#include "src/io/value.h"
+
+DEFINE_string(benchmark_file, "testdata/context",
+              "File or directory of 'node id:weight id:weight ...' lines.");
+DEFINE_int32(benchmark_repeat, 10, "Times to parse the files.");
+DEFINE_int32(benchmark_batch, 1024, "Batch size of NextBatch.");
+
+namespace embedx {
+namespace {
+
+bool Parse(const vec_str_t& files, bool fast_path, uint64_t* lines,
+           uint64_t* pairs) {
+  LineParser parser;
+  parser.set_fast_path(fast_path);
+  std::vector<AdjValue> values;
+  *lines = 0;
+  *pairs = 0;
+  for (int i = 0; i < FLAGS_benchmark_repeat; ++i) {
+    for (const auto& file : files) {
+      if (!parser.Open(file)) {
+        return false;
+      }
+      while (parser.NextBatch(FLAGS_benchmark_batch, &values)) {
+        *lines += values.size();
+        for (const auto& value : values) {
+          *pairs += value.pairs.size();
+        }
+      }
+    }
+  }
+  return true;
+}
+
+bool Benchmark(const vec_str_t& files, bool fast_path) {
+  uint64_t lines = 0;
+  uint64_t pairs = 0;
+  auto begin = std::chrono::steady_clock::now();
+  if (!Parse(files, fast_path, &lines, &pairs)) {
+    return false;
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  double seconds = std::chrono::duration<double>(end - begin).count();
+  DXINFO("%s parser: %" PRIu64 " lines, %" PRIu64
+         " pairs in %.3f s, %.0f lines/s, %.0f pairs/s.",
+         fast_path ? "Fast" : "Stream", lines, pairs, seconds,
+         lines / seconds, pairs / seconds);
+  return true;
+}
+
+int main(int argc, char** argv) {
+  google::SetUsageMessage("Usage: [Options]");
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  DXCHECK_THROW(FLAGS_benchmark_repeat > 0);
+  DXCHECK_THROW(FLAGS_benchmark_batch > 0);
+
+  vec_str_t files;
+  DXCHECK_THROW(io_util::ListFile(FLAGS_benchmark_file, &files));
+  DXCHECK_THROW(!files.empty());
+
+  // The first run also warms up the page cache.
+  DXCHECK_THROW(Benchmark(files, false));
+  DXCHECK_THROW(Benchmark(files, true));
+  DXCHECK_THROW(Benchmark(files, false));
+
+  google::ShutDownCommandLineFlags();
+  return 0;
+}
+
+}  // namespace
+}  // namespace embedx
+
+int main(int argc, char** argv) { return embedx::main(argc, argv); }
@@ -0,0 +1,156 @@
+// Tencent is pleased to support the open source community by making embedx
+// available.
+//
+// Copyright (C) 2021 THL A29 Limited, a Tencent company.  All rights reserved.
+//
+// Licensed under the BSD 3-Clause License and other third-party components,
+// please refer to LICENSE for details.
+//
+
+#include <deepx_core/common/stream.h>
+#include <deepx_core/dx_log.h>
+#include <gflags/gflags.h>
+
+#include <algorithm>  // std::find
+#include <chrono>
+#include <cstdio>  // std::remove
+#include <fstream>
+#include <memory>  // std::unique_ptr
+#include <random>
+#include <string>
+#include <vector>
+
+#include "src/common/data_types.h"
+#include "src/sampler/negative_sampler.h"
+#include "src/sampler/sampler_builder.h"
+#include "src/sampler/sampler_source.h"
+#include "src/sampler/sampling.h"
+
+DEFINE_int32(benchmark_node_num, 100000, "Nodes in the graph.");
+DEFINE_int32(benchmark_count, 5, "Negatives per node.");
+DEFINE_int32(benchmark_max_batch, 4096, "Largest batch, batches double.");
+DEFINE_int32(benchmark_negative_num, 2000000,
+             "Negatives sampled per batch size.");
+DEFINE_string(benchmark_dir, "negative_sampler_benchmark_context",
+              "Dir of the generated graph, removed at exit.");
+
+namespace embedx {
+namespace {
+
+class Timer {
+ private:
+  std::chrono::steady_clock::time_point begin_ =
+      std::chrono::steady_clock::now();
+
+ public:
+  double seconds() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                         begin_)
+        .count();
+  }
+};
+
+// A ring where each node links to the next two.
+bool WriteGraph(const std::string& file, int node_num) {
+  std::ofstream os(file);
+  for (int i = 0; i < node_num; ++i) {
+    os << i << " " << (i + 1) % node_num << ":1 " << (i + 2) % node_num
+       << ":1\n";
+  }
+  return (bool)os;
+}
+
+// The exclusion check before ExcludedNodeSet, a scan per draw.
+void LinearSample(const SamplerBuilder& sampler_builder, int count,
+                  const vec_int_t& nodes, const vec_int_t& excluded_nodes,
+                  std::vector<vec_int_t>* sampled_nodes_list) {
+  const auto& candidates = sampler_builder.sampler_source().nodes_list()[0];
+  sampled_nodes_list->resize(nodes.size());
+  vec_int_t next_nodes;
+  for (auto& sampled_nodes : *sampled_nodes_list) {
+    sampled_nodes.clear();
+    while (sampled_nodes.size() < (size_t)count) {
+      DXCHECK(sampler_builder.NextN(candidates[0],
+                                    count - (int)sampled_nodes.size(),
+                                    &next_nodes));
+      for (auto next_node : next_nodes) {
+        if (std::find(excluded_nodes.begin(), excluded_nodes.end(),
+                      next_node) == excluded_nodes.end()) {
+          sampled_nodes.emplace_back(next_node);
+        }
+      }
+    }
+  }
+}
+
+// Independent negatives of a batch excluding the batch itself, as the
+// instance readers sample them.
+template <typename SampleFunc>
+double Benchmark(int batch, int node_num, SampleFunc&& sample) {
+  std::default_random_engine engine;
+  std::uniform_int_distribution<int_t> dist(0, node_num - 1);
+  vec_int_t nodes(batch);
+  std::vector<vec_int_t> sampled_nodes_list;
+  int batch_num = std::max(
+      1, FLAGS_benchmark_negative_num / (batch * FLAGS_benchmark_count));
+
+  Timer timer;
+  for (int i = 0; i < batch_num; ++i) {
+    for (auto& node : nodes) {
+      node = dist(engine);
+    }
+    sample(nodes, &sampled_nodes_list);
+  }
+  return timer.seconds() * 1e9 / ((double)batch_num * batch *
+                                  FLAGS_benchmark_count);
+}
+
+int main(int argc, char** argv) {
+  google::SetUsageMessage("Usage: [Options]");
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  DXCHECK_THROW(FLAGS_benchmark_node_num > 0);
+  DXCHECK_THROW(FLAGS_benchmark_count > 0);
+  DXCHECK_THROW(FLAGS_benchmark_max_batch > 0);
+  DXCHECK_THROW(FLAGS_benchmark_negative_num > 0);
+
+  DXCHECK_THROW(deepx_core::AutoFileSystem::MakeDir(FLAGS_benchmark_dir));
+  std::string file = FLAGS_benchmark_dir + "/context";
+  DXCHECK_THROW(WriteGraph(file, FLAGS_benchmark_node_num));
+  auto sampler_source = NewMockSamplerSource(FLAGS_benchmark_dir, "", 1);
+  DXCHECK_THROW(sampler_source);
+  auto sampler_builder = NewSamplerBuilder(
+      sampler_source.get(), SamplerBuilderEnum::NEGATIVE_SAMPLER,
+      (int)SamplingEnum::UNIFORM, 1);
+  DXCHECK_THROW(sampler_builder);
+  auto negative_sampler = NewNegativeSampler(sampler_builder.get(),
+                                             NegativeSamplerEnum::INDEPENDENT);
+  DXCHECK_THROW(negative_sampler);
+
+  int count = FLAGS_benchmark_count;
+  for (int batch = 16; batch <= FLAGS_benchmark_max_batch; batch *= 2) {
+    double set_ns = Benchmark(
+        batch, FLAGS_benchmark_node_num,
+        [&](const vec_int_t& nodes, std::vector<vec_int_t>* sampled) {
+          DXCHECK(negative_sampler->Sample(count, nodes, nodes, sampled));
+        });
+    double linear_ns = Benchmark(
+        batch, FLAGS_benchmark_node_num,
+        [&](const vec_int_t& nodes, std::vector<vec_int_t>* sampled) {
+          LinearSample(*sampler_builder, count, nodes, nodes, sampled);
+        });
+    DXINFO("batch: %5d, ExcludedNodeSet: %7.1f ns/negative, linear: %7.1f "
+           "ns/negative.",
+           batch, set_ns, linear_ns);
+  }
+
+  std::remove(file.c_str());
+  std::remove(FLAGS_benchmark_dir.c_str());
+  google::ShutDownCommandLineFlags();
+  return 0;
+}
+
+}  // namespace
+}  // namespace embedx
+
+int main(int argc, char** argv) { return embedx::main(argc, argv); }
@@ -0,0 +1,100 @@
+// Tencent is pleased to support the open source community by making embedx
+// available.
+//
+// Copyright (C) 2021 THL A29 Limited, a Tencent company.  All rights reserved.
+//
+// Licensed under the BSD 3-Clause License and other third-party components,
+// please refer to LICENSE for details.
+//
+
+#include "src/tools/graph/partition/stream_partition.h"
+
+#include <deepx_core/dx_log.h>
+
+#include <algorithm>  // std::fill
+#include <cmath>      // std::pow
+
+namespace embedx {
+
+StreamPartition::StreamPartition(const StreamPartitionConfig& config,
+                                 uint64_t total_node, uint64_t total_edge)
+    : config_(config) {
+  DXCHECK(config_.shard_num > 0);
+  DXCHECK(config_.slack >= 0);
+
+  double total_load = (double)(total_node + total_edge);
+  capacity_ = (1 + config_.slack) * total_load / config_.shard_num;
+  // The fennel penalty, with loads in place of node counts.
+  if (total_load > 0) {
+    alpha_ = total_edge * std::pow(config_.shard_num, config_.gamma - 1) /
+             std::pow(total_load, config_.gamma);
+  }
+
+  shards_.reserve(total_node);
+  loads_.assign(config_.shard_num, 0);
+  neighbor_counts_.assign(config_.shard_num, 0);
+}
+
+int StreamPartition::Assign(int_t node, const vec_pair_t& context) {
+  auto it = shards_.find(node);
+  if (it != shards_.end()) {
+    return it->second;
+  }
+
+  std::fill(neighbor_counts_.begin(), neighbor_counts_.end(), 0);
+  for (const auto& entry : context) {
+    int shard = GetShard(entry.first);
+    if (shard >= 0) {
+      ++neighbor_counts_[shard];
+    }
+  }
+
+  // The best scored shard with room for the node, ties go to the lighter one.
+  // When every shard is full, the lightest one takes the node.
+  uint64_t load = 1 + context.size();
+  int best = -1;
+  double best_score = 0;
+  int lightest = 0;
+  for (int i = 0; i < config_.shard_num; ++i) {
+    if (loads_[i] < loads_[lightest]) {
+      lightest = i;
+    }
+    if (loads_[i] + load > capacity_) {
+      continue;
+    }
+
+    double score = Score(i);
+    if (best < 0 || score > best_score ||
+        (score == best_score && loads_[i] < loads_[best])) {
+      best = i;
+      best_score = score;
+    }
+  }
+  if (best < 0) {
+    best = lightest;
+  }
+
+  shards_[node] = best;
+  loads_[best] += load;
+  return best;
+}
+
+int StreamPartition::GetShard(int_t node) const {
+  auto it = shards_.find(node);
+  return it != shards_.end() ? it->second : -1;
+}
+
+double StreamPartition::Score(int shard) const {
+  double neighbor_count = neighbor_counts_[shard];
+  switch ((StreamPartitionEnum)config_.method) {
+    case StreamPartitionEnum::FENNEL:
+      return neighbor_count - alpha_ * config_.gamma *
+                                  std::pow((double)loads_[shard],
+                                           config_.gamma - 1);
+    case StreamPartitionEnum::LDG:
+    default:
+      return neighbor_count * (1 - loads_[shard] / capacity_);
+  }
+}
+
+}  // namespace embedx
@@ -0,0 +1,70 @@
+// Tencent is pleased to support the open source community by making embedx
+// available.
+//
+// Copyright (C) 2021 THL A29 Limited, a Tencent company.  All rights reserved.
+//
+// Licensed under the BSD 3-Clause License and other third-party components,
+// please refer to LICENSE for details.
+//
+
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "src/common/data_types.h"
+
+namespace embedx {
+
+enum class StreamPartitionEnum : int {
+  // Linear Deterministic Greedy
+  LDG = 0,
+  FENNEL = 1,
+};
+
+struct StreamPartitionConfig {
+  int shard_num = 1;
+  int method = (int)StreamPartitionEnum::LDG;
+  // Shards hold at most (1 + slack) * total load / shard_num.
+  double slack = 0.1;
+  // exponent of the fennel load penalty
+  double gamma = 1.5;
+};
+
+// Assigns nodes to shards one at a time as their contexts stream in, keeping
+// a node with the neighbors placed before it. The load of a node is 1 plus
+// its degree, so shards get a similar share of contexts rather than of nodes.
+//
+// Streaming Graph Partitioning for Large Distributed Graphs
+// Isabelle Stanton, Gabriel Kliot
+// FENNEL: Streaming Graph Partitioning for Massive Scale Graphs
+// Charalampos Tsourakakis, Christos Gkantsidis etc.
+class StreamPartition {
+ private:
+  StreamPartitionConfig config_;
+  double capacity_ = 0;
+  double alpha_ = 0;
+
+  index_map_t shards_;
+  std::vector<uint64_t> loads_;
+  // neighbors per shard of the current node
+  vec_int_t neighbor_counts_;
+
+ public:
+  // 'total_node' and 'total_edge' are the number of contexts and of their
+  // neighbors in the whole stream.
+  StreamPartition(const StreamPartitionConfig& config, uint64_t total_node,
+                  uint64_t total_edge);
+
+ public:
+  int Assign(int_t node, const vec_pair_t& context);
+  // shard of an assigned node, or -1
+  int GetShard(int_t node) const;
+
+  const index_map_t& shards() const noexcept { return shards_; }
+  const std::vector<uint64_t>& loads() const noexcept { return loads_; }
+
+ private:
+  double Score(int shard) const;
+};
+
+}  // namespace embedx
@@ -0,0 +1,97 @@
+// Tencent is pleased to support the open source community by making embedx
+// available.
+//
+// Copyright (C) 2021 THL A29 Limited, a Tencent company.  All rights reserved.
+//
+// Licensed under the BSD 3-Clause License and other third-party components,
+// please refer to LICENSE for details.
+//
+
+#include "src/tools/graph/partition/stream_partition.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>  // std::unique_ptr
+#include <vector>
+
+#include "src/common/data_types.h"
+
+namespace embedx {
+
+class StreamPartitionTest : public ::testing::Test {
+ protected:
+  std::unique_ptr<StreamPartition> partition_;
+  StreamPartitionConfig config_;
+
+ protected:
+  vec_int_t nodes_;
+  std::vector<vec_pair_t> contexts_;
+  uint64_t total_edge_ = 0;
+
+ protected:
+  void SetUp() override {
+    // two cliques, 0-3 and 4-7, bridged by 3-4
+    for (int_t i = 0; i < 8; ++i) {
+      vec_pair_t context;
+      int_t first = i < 4 ? 0 : 4;
+      for (int_t j = first; j < first + 4; ++j) {
+        if (j != i) {
+          context.emplace_back(j, 1);
+        }
+      }
+      if (i == 3) {
+        context.emplace_back(4, 1);
+      } else if (i == 4) {
+        context.emplace_back(3, 1);
+      }
+      nodes_.emplace_back(i);
+      contexts_.emplace_back(context);
+      total_edge_ += context.size();
+    }
+    config_.shard_num = 2;
+  }
+
+  void AssignAll() {
+    partition_.reset(
+        new StreamPartition(config_, nodes_.size(), total_edge_));
+    for (size_t i = 0; i < nodes_.size(); ++i) {
+      partition_->Assign(nodes_[i], contexts_[i]);
+    }
+  }
+
+  void ExpectCliques() const {
+    for (int_t i = 0; i < 8; ++i) {
+      EXPECT_EQ(partition_->GetShard(i), i < 4 ? 0 : 1);
+    }
+    EXPECT_EQ(partition_->GetShard(8), -1);
+    EXPECT_EQ(partition_->loads(), std::vector<uint64_t>({17, 17}));
+  }
+};
+
+TEST_F(StreamPartitionTest, LDG) {
+  config_.method = (int)StreamPartitionEnum::LDG;
+  AssignAll();
+  ExpectCliques();
+  // assigned nodes keep their shards
+  EXPECT_EQ(partition_->Assign(0, contexts_[4]), 0);
+  EXPECT_EQ(partition_->shards().size(), 8u);
+}
+
+TEST_F(StreamPartitionTest, Fennel) {
+  config_.method = (int)StreamPartitionEnum::FENNEL;
+  AssignAll();
+  ExpectCliques();
+}
+
+TEST_F(StreamPartitionTest, Capacity) {
+  // a single clique has to be split when shards are tight
+  nodes_.resize(4);
+  contexts_.resize(4);
+  contexts_[3].pop_back();
+  total_edge_ = 12;
+  config_.slack = 0;
+  AssignAll();
+  EXPECT_EQ(partition_->loads(), std::vector<uint64_t>({8, 8}));
+}
+
+}  // namespace embedx
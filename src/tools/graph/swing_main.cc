@@ -50,9 +50,13 @@ class SwingMain : public MainUtil {
   bool Init() override {
     if (FLAGS_dist) {
       graph_config_.set_ip_ports(FLAGS_gs_addrs);
+      graph_config_.set_partitioner_type(FLAGS_gs_partitioner_type);
+      graph_config_.set_partition_file(FLAGS_gs_partition_file);
     } else {
       graph_config_.set_node_graph(FLAGS_node_graph);
+      graph_config_.set_store_type(FLAGS_store_type);
       graph_config_.set_thread_num(FLAGS_gs_thread_num);
+      graph_config_.set_store_partition_num(FLAGS_store_partition_num);
     }
 
     graph_client_ = NewGraphClient(graph_config_, (GraphClientEnum)FLAGS_dist);
@@ -128,6 +132,7 @@ void CheckFlags() {
   } else {
     DXCHECK(!FLAGS_node_graph.empty());
     DXCHECK(FLAGS_gs_thread_num > 0);
+    DXCHECK(FLAGS_store_partition_num > 0);
   }
 
   DXCHECK(FLAGS_batch_node > 0);
@@ -53,6 +53,10 @@ DEFINE_string(in, "", "Input dir/file of training data.");
 DEFINE_string(pretrain_path, "", "Input dir/file of pretrain param.");
 DEFINE_string(item_feature, "", "Input dir/file of item feature.");
 DEFINE_string(inst_file, "", "Input dir/file of instance file.");
+DEFINE_string(inst_binary_file, "",
+              "Binary instance file to map instead of inst_file.");
+DEFINE_string(dump_inst_binary_file, "",
+              "Output binary instance file of inst_file.");
 DEFINE_string(freq_file, "", "Input dir/file of item frequency.");
 DEFINE_bool(shuffle, true, "Shuffle input files for each epoch.");
 DEFINE_int32(epoch, 1, "Number of epochs.");
@@ -62,7 +66,7 @@ DEFINE_uint64(ts_now, 0, "Timestamp of now.");
 DEFINE_uint64(ts_expire_threshold, 0, "Timestamp expiration threshold.");
 DEFINE_uint64(freq_filter_threshold, 0, "Frequency filter threshold.");
 DEFINE_int32(verbose, 1, "Verbose level: 0-10.");
-DEFINE_int32(seed, 9527, "Seed of random engine.");
+DEFINE_int32(seed, 9527, "Seed of random engine and graph sampling.");
 DEFINE_int32(target_type, 0, "0, for loss, 1 for prob, 2 for emb.");
 DEFINE_bool(out_model_remove_zeros, false, "Remove zeros from output model.");
 DEFINE_string(out_model, "", "Output dir of model (optional).");
@@ -133,7 +137,7 @@ bool Trainer::Init() {
 
   if (FLAGS_deep_model) {
     if (!FLAGS_item_feature.empty() || !FLAGS_inst_file.empty() ||
-        !FLAGS_freq_file.empty()) {
+        !FLAGS_inst_binary_file.empty() || !FLAGS_freq_file.empty()) {
       DeepConfig deep_config;
 
       if (!FLAGS_item_feature.empty()) {
@@ -141,6 +145,10 @@ bool Trainer::Init() {
       }
       if (!FLAGS_inst_file.empty()) {
         deep_config.set_inst_file(FLAGS_inst_file);
+        deep_config.set_dump_inst_binary_file(FLAGS_dump_inst_binary_file);
+      }
+      if (!FLAGS_inst_binary_file.empty()) {
+        deep_config.set_inst_binary_file(FLAGS_inst_binary_file);
       }
       if (!FLAGS_freq_file.empty()) {
         deep_config.set_freq_file(FLAGS_freq_file);
@@ -214,6 +222,13 @@ void Trainer::Train() {
     epoch_loss_ = 0;
     epoch_loss_weight_ = 0;
 
+    if (graph_client_) {
+      if (!graph_client_->RefreshCache()) {
+        DXERROR("Failed to refresh graph client cache.");
+      }
+      graph_client_->SeedSampling((uint64_t)FLAGS_seed, epoch_);
+    }
+
     std::vector<std::thread> threads;
     for (int j = 0; j < FLAGS_thread_num; ++j) {
       threads.emplace_back(&Trainer::TrainEntry, this, j);